@@ -34,6 +34,7 @@
 #include <list>
 #include <chrono>
 #include <sstream>
+#include <unordered_set>
 #include <my_stacktrace.h>
 #include <boost/algorithm/string.hpp>
 #include <exception>
@@ -88,6 +89,9 @@ static int limit_unsafe_warning_count= 0;
 
 static handlerton *binlog_hton;
 bool opt_binlog_order_commits= true;
+bool opt_binlog_pipelined_sync= false;
+ulong opt_binlog_sync_latency_target_usec= 0;
+bool opt_binlog_trx_writeset= false;
 bool opt_gtid_precommit= false;
 
 const char *log_bin_index= 0;
@@ -369,6 +373,9 @@ public:
   int flush(THD *thd, my_off_t *bytes, bool *wrote_xid, bool async);
   int write_event(THD *thd, Log_event *event,
                   bool write_meta_data_event= false);
+  void add_to_writeset(THD *thd, TABLE *table, const uchar *record,
+                       MY_BITMAP const *cols,
+                       MY_BITMAP const *changed_cols= NULL);
 
   virtual ~binlog_cache_data()
   {
@@ -491,6 +498,8 @@ public:
     flags.immediate= false;
     flags.finalized= false;
     flags.flush_error= false;
+    writeset_state= WRITESET_NONE;
+    writeset.clear();
     /*
       The truncate function calls reinit_io_cache that calls my_b_flush_io_cache
       which may increase disk_writes. This breaks the disk_writes use by the
@@ -629,6 +638,23 @@ private:
    */
   Rows_log_event *m_pending;
 
+  /*
+    Hashes of the unique keys of the rows written to the cache, logged in a
+    Metadata_log_event before the end event when binlog_trx_writeset is set.
+    The state is decided by the first row of the group, so that a group
+    either has a complete writeset or none at all.
+  */
+  enum enum_writeset_state
+  {
+    WRITESET_NONE,
+    WRITESET_OK,
+    WRITESET_INVALID
+  } writeset_state;
+  std::unordered_set<uint64> writeset;
+
+  bool writeset_supports_table(THD *thd, TABLE *table);
+  int write_writeset(THD *thd);
+
   /**
     This function computes binlog cache and disk usage.
   */
@@ -1195,6 +1221,29 @@ int binlog_cache_data::write_event(THD *thd,
       flags.with_xid= true;
     if (ev->is_using_immediate_logging())
       flags.immediate= true;
+
+    /*
+      The writeset only describes the changes logged in rows events, it's
+      of no use if the group changes anything in a statement.
+    */
+    switch (ev->get_type_code())
+    {
+    case TABLE_MAP_EVENT:
+    case WRITE_ROWS_EVENT:
+    case UPDATE_ROWS_EVENT:
+    case DELETE_ROWS_EVENT:
+    case WRITE_ROWS_EVENT_V1:
+    case UPDATE_ROWS_EVENT_V1:
+    case DELETE_ROWS_EVENT_V1:
+    case ROWS_QUERY_LOG_EVENT:
+    case METADATA_EVENT:
+    case XID_EVENT:
+      break;
+    default:
+      if (!ev->starts_group() && !ev->ends_group())
+        writeset_state= WRITESET_INVALID;
+      break;
+    }
   }
   DBUG_RETURN(0);
 }
@@ -1476,6 +1525,11 @@ binlog_cache_data::finalize(THD *thd, Log_event *end_event)
     DBUG_ASSERT(!flags.finalized);
     if (int error= flush_pending_event(thd))
       DBUG_RETURN(error);
+    if (end_event != NULL)
+    {
+      if (int error= write_writeset(thd))
+        DBUG_RETURN(error);
+    }
     if (int error= write_event(thd, end_event))
       DBUG_RETURN(error);
     flags.finalized= true;
@@ -1484,6 +1538,187 @@ binlog_cache_data::finalize(THD *thd, Log_event *end_event)
   DBUG_RETURN(0);
 }
 
+/**
+  Writes the writeset of the group, see binlog_trx_writeset.
+
+  @param thd  The thread whose transaction is finalized
+
+  @return
+    nonzero if an error pops up when writing the event.
+*/
+int binlog_cache_data::write_writeset(THD *thd)
+{
+  DBUG_ENTER("binlog_cache_data::write_writeset");
+  if (writeset_state != WRITESET_OK || writeset.empty())
+    DBUG_RETURN(0);
+
+  DBUG_ASSERT(writeset.size() <= Metadata_log_event::MAX_WRITESET_SIZE);
+  Metadata_log_event metadata_ev(thd, is_trx_cache());
+  metadata_ev.set_writeset(
+      std::vector<uint64_t>(writeset.begin(), writeset.end()));
+  DBUG_RETURN(write_event(thd, &metadata_ev));
+}
+
+/**
+  Whether the writeset can tell all the rows of the table that a row
+  written to it conflicts with. This needs a primary key and unique keys
+  whose values compare equal only if their images hash the same, so keys
+  on prefixes, blobs or floating point columns are not supported. Rows of
+  tables with foreign keys conflict with rows of other tables.
+
+  The checks of the keys and of the foreign keys of the table are cached
+  in the table share, which is reopened after DDL on the table. Foreign
+  keys referencing the table are added by DDL on other tables and are
+  checked every time.
+
+  @param thd    The thread writing the row
+  @param table  The table the row is written to
+
+  @return true if the table is supported, false otherwise
+*/
+bool binlog_cache_data::writeset_supports_table(THD *thd, TABLE *table)
+{
+  if (table->file->referenced_by_foreign_key())
+    return false;
+
+  if (table->s->cached_writeset_check != -1)
+    return table->s->cached_writeset_check;
+
+  bool supported= table->s->primary_key != MAX_KEY;
+
+  KEY *key= table->key_info;
+  for (uint i= 0; supported && i < table->s->keys; i++, key++)
+  {
+    if (!(key->flags & HA_NOSAME))
+      continue;
+    for (uint j= 0; j < key->user_defined_key_parts; j++)
+    {
+      const KEY_PART_INFO *key_part= &key->key_part[j];
+      if ((key_part->key_part_flag & HA_PART_KEY_SEG) ||
+          (key_part->field->flags & BLOB_FLAG) ||
+          key_part->field->result_type() == REAL_RESULT)
+      {
+        supported= false;
+        break;
+      }
+    }
+  }
+
+  if (supported)
+  {
+    List<FOREIGN_KEY_INFO> f_key_list;
+    table->file->get_foreign_key_list(thd, &f_key_list);
+    supported= f_key_list.is_empty();
+  }
+
+  table->s->cached_writeset_check= supported;
+  return supported;
+}
+
+/**
+  Adds the hashes of the unique keys of a row image to the writeset of
+  the group. The hash of a key covers the database, the table, the key
+  name and the collation aware hash of every key column, keys with a NULL
+  column can't conflict and are skipped. The writeset is given up if a
+  row is written to an unsupported table, if the value of a key column is
+  not in the record or if it gets too large.
+
+  The bitmaps are the ones the statement used, not the ones narrowed down
+  to the logged image by binlog_row_image: the record has the values of
+  all the columns that were read or written.
+
+  @param thd           The thread writing the row
+  @param table         The table the row is written to
+  @param record        The row, either table->record[0] or table->record[1]
+  @param cols          The columns whose values are in the record
+  @param changed_cols  For the after image of an update, the columns that
+                       were written; their values are in the record too.
+                       Only the keys with a column in it are hashed, the
+                       others are the same as in the before image.
+*/
+void binlog_cache_data::add_to_writeset(THD *thd, TABLE *table,
+                                        const uchar *record,
+                                        MY_BITMAP const *cols,
+                                        MY_BITMAP const *changed_cols)
+{
+  DBUG_ENTER("binlog_cache_data::add_to_writeset");
+
+  if (writeset_state == WRITESET_NONE)
+    writeset_state= opt_binlog_trx_writeset ? WRITESET_OK : WRITESET_INVALID;
+  if (writeset_state != WRITESET_OK)
+    DBUG_VOID_RETURN;
+
+  if (!writeset_supports_table(thd, table))
+  {
+    writeset_state= WRITESET_INVALID;
+    writeset.clear();
+    DBUG_VOID_RETURN;
+  }
+
+  const my_ptrdiff_t ptr_diff= record - table->record[0];
+  std::string buffer;
+  KEY *key= table->key_info;
+  for (uint i= 0; i < table->s->keys; i++, key++)
+  {
+    if (!(key->flags & HA_NOSAME))
+      continue;
+
+    if (changed_cols != NULL)
+    {
+      bool changed= false;
+      for (uint j= 0; !changed && j < key->user_defined_key_parts; j++)
+        changed= bitmap_is_set(changed_cols,
+                               key->key_part[j].field->field_index);
+      if (!changed)
+        continue;
+    }
+
+    buffer.assign(table->s->db.str, table->s->db.length + 1);
+    buffer.append(table->s->table_name.str, table->s->table_name.length + 1);
+    buffer.append(key->name, strlen(key->name) + 1);
+
+    bool has_null= false;
+    for (uint j= 0; j < key->user_defined_key_parts; j++)
+    {
+      Field *field= key->key_part[j].field;
+      if (!bitmap_is_set(cols, field->field_index) &&
+          (changed_cols == NULL ||
+           !bitmap_is_set(changed_cols, field->field_index)))
+      {
+        writeset_state= WRITESET_INVALID;
+        writeset.clear();
+        DBUG_VOID_RETURN;
+      }
+      if (field->is_null_in_record(record))
+      {
+        has_null= true;
+        break;
+      }
+      ulong nr1= 1, nr2= 4;
+      field->move_field_offset(ptr_diff);
+      field->hash(&nr1, &nr2);
+      field->move_field_offset(-ptr_diff);
+
+      char hash_buffer[8];
+      int8store(hash_buffer, (ulonglong) nr1);
+      buffer.append(hash_buffer, sizeof(hash_buffer));
+    }
+    if (has_null)
+      continue;
+
+    const uchar *ptr= (const uchar *) buffer.data();
+    writeset.insert(((uint64) murmur3_32(ptr, buffer.length(), 0) << 32) |
+                    murmur3_32(ptr, buffer.length(), 1));
+  }
+
+  if (writeset.size() > Metadata_log_event::MAX_WRITESET_SIZE)
+  {
+    writeset_state= WRITESET_INVALID;
+    writeset.clear();
+  }
+  DBUG_VOID_RETURN;
+}
+
 /**
   Flush caches to the binary log.
 
@@ -3736,6 +3971,8 @@ MYSQL_BIN_LOG::MYSQL_BIN_LOG(uint *sync_period)
    sync_period_ptr(sync_period), sync_counter(0),
    m_prep_xids(0),
    binlog_end_pos(0),
+   flushed_end_pos(0),
+   avg_fsync_usec(0),
    non_xid_trxs(0),
    is_relay_log(0), signal_cnt(0),
    checksum_alg_reset(BINLOG_CHECKSUM_ALG_UNDEF),
@@ -3751,6 +3988,7 @@ MYSQL_BIN_LOG::MYSQL_BIN_LOG(uint *sync_period)
   */
   index_file_name[0] = 0;
   engine_binlog_file[0] = 0;
+  flushed_file_name[0] = 0;
   engine_binlog_max_gtid.clear();
   last_master_timestamp.store(0);
   memset(&index_file, 0, sizeof(index_file));
@@ -8320,6 +8558,31 @@ void MYSQL_BIN_LOG::unlock_commits(const snapshot_info_st *ss_info)
   mysql_mutex_unlock(&LOCK_log);
 }
 
+/**
+  Write to the binary log file and, if the current flush group is kept
+  for the binlog tail cache, to tail_capture. The group is no longer kept
+  once it is larger than the cache.
+
+  @retval false success
+  @retval true  the write to the file failed
+*/
+
+bool MYSQL_BIN_LOG::write_to_log_file(const uchar *buf, size_t len)
+{
+  if (my_b_write(&log_file, buf, len))
+    return true;
+#ifdef HAVE_REPLICATION
+  if (tail_capture)
+  {
+    if (tail_capture->size() + len > (1 << 20) * opt_binlog_tail_cache_size)
+      tail_capture.reset();
+    else
+      tail_capture->insert(tail_capture->end(), buf, buf + len);
+  }
+#endif
+  return false;
+}
+
 /**
   Calculate checksum of possibly a part of an event containing at least
   the whole common header.
@@ -8444,7 +8707,7 @@ int MYSQL_BIN_LOG::do_write_cache(IO_CACHE *cache)
       }
 
       /* write the first half of the split header */
-      if (my_b_write(&log_file, header, carry))
+      if (write_to_log_file(header, carry))
         DBUG_RETURN(ER_ERROR_ON_WRITE);
 
       /*
@@ -8487,12 +8750,12 @@ int MYSQL_BIN_LOG::do_write_cache(IO_CACHE *cache)
 
         crc= my_checksum(crc, cache->read_pos, length);
         remains -= length;
-        if (my_b_write(&log_file, cache->read_pos, length))
+        if (write_to_log_file(cache->read_pos, length))
           DBUG_RETURN(ER_ERROR_ON_WRITE);
         if (remains == 0)
         {
           int4store(buf, crc);
-          if (my_b_write(&log_file, buf, BINLOG_CHECKSUM_LEN))
+          if (write_to_log_file(buf, BINLOG_CHECKSUM_LEN))
             DBUG_RETURN(ER_ERROR_ON_WRITE);
           crc= crc_0;
         }
@@ -8518,8 +8781,8 @@ int MYSQL_BIN_LOG::do_write_cache(IO_CACHE *cache)
             int4store(buf, crc);
             remains -= hdr_offs;
             DBUG_ASSERT(remains == 0);
-            if (my_b_write(&log_file, cache->read_pos, hdr_offs) ||
-                my_b_write(&log_file, buf, BINLOG_CHECKSUM_LEN))
+            if (write_to_log_file(cache->read_pos, hdr_offs) ||
+                write_to_log_file(buf, BINLOG_CHECKSUM_LEN))
               DBUG_RETURN(ER_ERROR_ON_WRITE);
             crc= crc_0;
           }
@@ -8550,13 +8813,13 @@ int MYSQL_BIN_LOG::do_write_cache(IO_CACHE *cache)
             int4store(ev + EVENT_LEN_OFFSET, event_len + BINLOG_CHECKSUM_LEN);
             remains= fix_log_event_crc(cache->read_pos, hdr_offs, event_len,
                                        length, &crc);
-            if (my_b_write(&log_file, ev,
+            if (write_to_log_file(ev,
                            remains == 0 ? event_len : length - hdr_offs))
               DBUG_RETURN(ER_ERROR_ON_WRITE);
             if (remains == 0)
             {
               int4store(buf, crc);
-              if (my_b_write(&log_file, buf, BINLOG_CHECKSUM_LEN))
+              if (write_to_log_file(buf, BINLOG_CHECKSUM_LEN))
                 DBUG_RETURN(ER_ERROR_ON_WRITE);
               crc= crc_0; // crc is complete
             }
@@ -8582,7 +8845,7 @@ int MYSQL_BIN_LOG::do_write_cache(IO_CACHE *cache)
 
     /* Write the entire buf to the binary log file */
     if (!do_checksum)
-      if (my_b_write(&log_file, cache->read_pos, length))
+      if (write_to_log_file(cache->read_pos, length))
         DBUG_RETURN(ER_ERROR_ON_WRITE);
     cache->read_pos=cache->read_end;		// Mark buffer used up
   } while ((length= my_b_fill(cache)));
@@ -9159,6 +9422,12 @@ void MYSQL_BIN_LOG::update_binlog_end_pos(bool need_lock)
   strmake(binlog_file_name, log_file_name, sizeof(binlog_file_name)-1);
   binlog_end_pos=
     is_relay_log ? my_b_append_tell(&log_file) : my_b_tell(&log_file);
+  /*
+    Everything flushed so far is visible now, the sync stage must not
+    publish a position of a file that was closed or reset since.
+  */
+  flushed_file_name[0]= 0;
+  flushed_end_pos= 0;
   signal_update();
   if (need_lock)
     unlock_binlog_end_pos();
@@ -10120,6 +10389,8 @@ MYSQL_BIN_LOG::change_stage(THD *thd,
 
 
 
+
+
 /**
   Flush the I/O cache to file.
 
@@ -10171,10 +10442,13 @@ MYSQL_BIN_LOG::sync_binlog_file(bool force, bool async)
             engines.
      */
     start_time = my_timer_now();
+    DBUG_EXECUTE_IF("simulate_slow_binlog_fsync", my_sleep(50000););
     int ret = DBUG_EVALUATE_IF("simulate_error_during_sync_binlog_file", 1,
                          mysql_file_sync(log_file.file,
                                          MYF(MY_WME | MY_IGNORE_BADFD)));
     binlog_fsync_time = my_timer_since(start_time);
+    avg_fsync_usec= (avg_fsync_usec.load() * 7 +
+                     my_timer_to_microseconds_ulonglong(binlog_fsync_time)) / 8;
     if (histogram_step_size_binlog_fsync)
       latency_histogram_increment(&histogram_binlog_fsync,
                                   binlog_fsync_time, 1);
@@ -10190,6 +10464,106 @@ MYSQL_BIN_LOG::sync_binlog_file(bool force, bool async)
 }
 
 
+/**
+  Record the end of the binary log written by the flush stage, for the
+  sync stage to make visible to the dump threads.
+*/
+void MYSQL_BIN_LOG::set_flushed_end_pos(my_off_t end_pos)
+{
+  mysql_mutex_assert_owner(&LOCK_log);
+  lock_binlog_end_pos();
+  strmake(flushed_file_name, log_file_name, sizeof(flushed_file_name)-1);
+  flushed_end_pos= end_pos;
+  unlock_binlog_end_pos();
+}
+
+
+/**
+  The time the sync stage leader waits for more groups to join the sync
+  stage queue before syncing the binary log.
+
+  With binlog_sync_latency_target_usec set, the leader waits for up to
+  the measured fsync time, so that about one more flush group can join
+  and share the fsync, but never for longer than the target leaves after
+  the fsync itself. No time is spent waiting when this group does not
+  sync the file because of the sync_binlog period.
+
+  @return the time to wait in microseconds
+*/
+ulonglong MYSQL_BIN_LOG::get_sync_stage_delay()
+{
+  const ulonglong target= opt_binlog_sync_latency_target_usec;
+  const ulonglong fsync_usec= avg_fsync_usec.load();
+  const uint sync_period= get_sync_period();
+
+  if (target == 0 || sync_period == 0 ||
+      sync_counter.load() + 1 < sync_period || fsync_usec >= target)
+    return 0;
+  return std::min(fsync_usec, target - fsync_usec);
+}
+
+
+/**
+  Process the sync stage queue: sync the binary log and make everything
+  flushed so far visible to the dump threads.
+
+  The end of the binary log is read before the file is synced, so every
+  byte up to it is on disk once the fsync returns, even when it belongs
+  to a later group that has not joined the sync stage yet.
+
+  @param[out] out_queue_var  The queue of the groups that were synced.
+  @param async               Whether the commit is asynchronous.
+
+  @retval 0 success
+  @retval ER_ERROR_ON_WRITE  the binary log could not be synced
+*/
+int MYSQL_BIN_LOG::process_sync_stage_queue(THD **out_queue_var, bool async)
+{
+  DBUG_ENTER("MYSQL_BIN_LOG::process_sync_stage_queue");
+  mysql_mutex_assert_owner(&LOCK_sync);
+  char file_name[FN_REFLEN];
+  my_off_t end_pos;
+  bool sync_needed;
+
+  ulonglong delay= get_sync_stage_delay();
+  if (delay)
+    my_sleep(delay);
+
+  *out_queue_var= stage_manager.fetch_queue_for(Stage_manager::SYNC_STAGE);
+
+  lock_binlog_end_pos();
+  strmake(file_name, flushed_file_name, sizeof(file_name)-1);
+  end_pos= flushed_end_pos;
+  sync_needed= strcmp(file_name, binlog_file_name) == 0 &&
+               end_pos > binlog_end_pos;
+  unlock_binlog_end_pos();
+
+  /*
+    Nothing to do when the groups did not write to the binary log, or
+    when it was rotated in the meantime: the rotation synced the file
+    and published the end of the new one.
+  */
+  if (!sync_needed)
+    DBUG_RETURN(0);
+
+  DEBUG_SYNC(current_thd, "before_sync_binlog_file");
+  std::pair<bool, bool> result= sync_binlog_file(false, async);
+  if (result.first)
+    DBUG_RETURN(ER_ERROR_ON_WRITE);
+
+  lock_binlog_end_pos();
+  if (strcmp(file_name, binlog_file_name) == 0 && end_pos > binlog_end_pos)
+  {
+    binlog_end_pos= end_pos;
+    signal_update();
+  }
+  unlock_binlog_end_pos();
+
+  DBUG_EXECUTE_IF("crash_commit_after_log", DBUG_SUICIDE(););
+  DBUG_RETURN(0);
+}
+
+
 /**
    Helper function executed when leaving @c ordered_commit.
 
@@ -10732,6 +11106,7 @@ int MYSQL_BIN_LOG::ordered_commit(THD *thd, bool all, bool skip_commit,
   THD *final_queue= NULL;
   mysql_mutex_t *leave_mutex_before_commit_stage= NULL;
   my_off_t flush_end_pos= 0;
+  my_off_t flush_start_pos= 0;
   if (unlikely(!is_open()))
   {
     final_queue= stage_manager.fetch_queue_for(Stage_manager::FLUSH_STAGE);
@@ -10745,6 +11120,12 @@ int MYSQL_BIN_LOG::ordered_commit(THD *thd, bool all, bool skip_commit,
     goto commit_stage;
   }
   DEBUG_SYNC(thd, "waiting_in_the_middle_of_flush_stage");
+  flush_start_pos= my_b_tell(&log_file);
+#ifdef HAVE_REPLICATION
+  /* Keep the bytes of the group for the dump threads */
+  if (opt_binlog_tail_cache_size > 0)
+    tail_capture= std::make_shared<std::vector<uchar>>();
+#endif
   flush_stage_error= process_flush_stage_queue(&total_bytes, &do_rotate,
                                          &final_queue, async);
 
@@ -10754,7 +11135,23 @@ int MYSQL_BIN_LOG::ordered_commit(THD *thd, bool all, bool skip_commit,
    * still have written
    */
   if (total_bytes > 0)
+  {
     flush_error= flush_cache_to_file(&flush_end_pos);
+#ifdef HAVE_REPLICATION
+    /*
+      Events written to log_file outside of do_write_cache(), e.g. incident
+      events, are not captured. Such groups are not kept.
+    */
+    if (tail_capture && !flush_error && !flush_stage_error &&
+        !tail_capture->empty() &&
+        flush_start_pos + tail_capture->size() == flush_end_pos)
+      binlog_tail_cache_append(log_file_name, flush_start_pos,
+                               std::move(tail_capture));
+#endif
+  }
+#ifdef HAVE_REPLICATION
+  tail_capture.reset();
+#endif
 
   DBUG_EXECUTE_IF("crash_after_flush_binlog", DBUG_SUICIDE(););
   /*
@@ -10777,31 +11174,42 @@ int MYSQL_BIN_LOG::ordered_commit(THD *thd, bool all, bool skip_commit,
       flush_error= ER_ERROR_ON_WRITE;
     }
 
-    /*
-      Stage #2: Syncing binary log file to disk
-    */
-    if (total_bytes > 0)
+    if (opt_binlog_pipelined_sync)
     {
-      DEBUG_SYNC(thd, "before_sync_binlog_file");
-      std::pair<bool, bool> result = sync_binlog_file(false, async);
-      flush_error = result.first;
+      /*
+        The binary log is synced, and the end position updated, by the
+        sync stage below.
+      */
+      set_flushed_end_pos(flush_end_pos);
     }
+    else
+    {
+      /*
+        Stage #2: Syncing binary log file to disk
+      */
+      if (total_bytes > 0)
+      {
+        DEBUG_SYNC(thd, "before_sync_binlog_file");
+        std::pair<bool, bool> result = sync_binlog_file(false, async);
+        flush_error = result.first;
+      }
 
-    /*
-      Update the last valid position after the after_flush hook has
-      executed. Doing so guarantees that the hook is executed before
-      the before/after_send_hooks on the dump thread, preventing race
-      conditions between the group_commit here and the dump threads.
-    */
-    /*
-      Update the binlog end position only after binlog fsync. Doing so
-      guarantees that slave's don't up with some transactions
-      that haven't made it to the disk on master because of a os
-      crash or power failure just before binlog fsync.
-    */
-    update_binlog_end_pos();
+      /*
+        Update the last valid position after the after_flush hook has
+        executed. Doing so guarantees that the hook is executed before
+        the before/after_send_hooks on the dump thread, preventing race
+        conditions between the group_commit here and the dump threads.
+      */
+      /*
+        Update the binlog end position only after binlog fsync. Doing so
+        guarantees that slave's don't up with some transactions
+        that haven't made it to the disk on master because of a os
+        crash or power failure just before binlog fsync.
+      */
+      update_binlog_end_pos();
 
-    DBUG_EXECUTE_IF("crash_commit_after_log", DBUG_SUICIDE(););
+      DBUG_EXECUTE_IF("crash_commit_after_log", DBUG_SUICIDE(););
+    }
   }
 
   /* simulate a write failure during commit - needed for unit test */
@@ -10818,10 +11226,32 @@ int MYSQL_BIN_LOG::ordered_commit(THD *thd, bool all, bool skip_commit,
     */
     handle_binlog_flush_or_sync_error(thd, false /* need_lock_log */);
   }
+  leave_mutex_before_commit_stage= &LOCK_log;
+
+  if (opt_binlog_pipelined_sync)
+  {
+    /*
+      Stage #2: Syncing binary log file to disk
+
+      LOCK_log is released when entering the stage, so that the next
+      group can be flushed to the binary log while this one is synced.
+      A flush stage leader that becomes a follower here leaves a pending
+      rotation to the next group, which finds the file still too big.
+    */
+    if (change_stage(thd, Stage_manager::SYNC_STAGE, final_queue,
+                     &LOCK_log, &LOCK_sync))
+    {
+      DBUG_PRINT("return", ("Thread ID: %u, commit_error: %d",
+                            thd->thread_id(), thd->commit_error));
+      DBUG_RETURN(finish_commit(thd, async));
+    }
+    sync_error= process_sync_stage_queue(&final_queue, async);
+    leave_mutex_before_commit_stage= &LOCK_sync;
+  }
 
 commit_stage:
   if (change_stage(thd, Stage_manager::SEMISYNC_STAGE, final_queue,
-                   &LOCK_log, &LOCK_semisync))
+                   leave_mutex_before_commit_stage, &LOCK_semisync))
   {
     DBUG_PRINT("return", ("Thread ID: %u, commit_error: %d",
                           thd->thread_id(), thd->commit_error));
@@ -13195,6 +13625,9 @@ int THD::binlog_write_row(TABLE* table, bool is_trans,
   if (unlikely(ev == 0))
     return HA_ERR_OUT_OF_MEM;
 
+  thd_get_cache_mngr(this)->get_binlog_cache_data(is_trans)->
+    add_to_writeset(this, table, record, table->write_set);
+
   return ev->add_row_data(row_data, len);
 }
 
@@ -13255,6 +13688,12 @@ int THD::binlog_update_row(TABLE* table, bool is_trans,
   if (unlikely(ev == 0))
     return HA_ERR_OUT_OF_MEM;
 
+  binlog_cache_data *const cache_data=
+    thd_get_cache_mngr(this)->get_binlog_cache_data(is_trans);
+  cache_data->add_to_writeset(this, table, before_record, old_read_set);
+  cache_data->add_to_writeset(this, table, after_record, old_read_set,
+                              old_write_set);
+
   error= ev->add_row_data(before_row, before_size) ||
          ev->add_row_data(after_row, after_size);
 
@@ -13307,6 +13746,9 @@ int THD::binlog_delete_row(TABLE* table, bool is_trans,
   if (unlikely(ev == 0))
     return HA_ERR_OUT_OF_MEM;
 
+  thd_get_cache_mngr(this)->get_binlog_cache_data(is_trans)->
+    add_to_writeset(this, table, record, old_read_set);
+
   error= ev->add_row_data(row_data, len);
 
   /* restore read/write set for the rest of execution */
@@ -22,7 +22,9 @@
 #include "rpl_gtid.h"
 #include <atomic>
 #include <list>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 extern ulong rpl_read_size;
 extern char *histogram_step_size_binlog_fsync;
@@ -536,7 +538,11 @@ public:
      sync_relay_log_period
   */
   uint *sync_period_ptr;
-  uint sync_counter;
+  /*
+    Updated under LOCK_log or LOCK_sync, depending on the caller of
+    sync_binlog_file(), and read by get_sync_stage_delay() under neither.
+  */
+  std::atomic<uint> sync_counter;
 
   my_atomic_rwlock_t m_prep_xids_lock;
   mysql_cond_t m_prep_xids_cond;
@@ -550,6 +556,16 @@ public:
   // binlog_file_name is protected by LOCK_binlog_end_pos mutex where as
   // log_file_name is protected by LOCK_log mutex.
   char binlog_file_name[FN_REFLEN];
+  /*
+    The end of the binary log written by the last flush stage. With
+    binlog_pipelined_sync the sync stage makes it visible to the dump
+    threads in binlog_end_pos once the file is synced. Protected by
+    LOCK_binlog_end_pos.
+  */
+  my_off_t flushed_end_pos;
+  char flushed_file_name[FN_REFLEN];
+  /* Moving average of the time of the binlog fsyncs, in microseconds. */
+  std::atomic<ulonglong> avg_fsync_usec;
 
   /**
     Increment the prepared XID counter.
@@ -924,14 +940,25 @@ private:
    */
   bool setup_flush_done;
 
+  /*
+     The bytes the current flush group wrote to log_file, kept for the
+     binlog tail cache. NULL if the group is not kept. Protected by
+     LOCK_log.
+   */
+  std::shared_ptr<std::vector<uchar>> tail_capture;
+
 
   int open(const char *opt_name) { return open_binlog(opt_name); }
   bool change_stage(THD *thd, Stage_manager::StageID stage,
                     THD* queue, mysql_mutex_t *leave, mysql_mutex_t *enter);
   std::pair<int,my_off_t> flush_thread_caches(THD *thd, bool async);
   int flush_cache_to_file(my_off_t *flush_end_pos);
+  bool write_to_log_file(const uchar *buf, size_t len);
   int finish_commit(THD *thd, bool async);
   std::pair<bool, bool> sync_binlog_file(bool force, bool async);
+  void set_flushed_end_pos(my_off_t end_pos);
+  ulonglong get_sync_stage_delay();
+  int process_sync_stage_queue(THD **out_queue_var, bool async);
   void process_semisync_stage_queue(THD *queue_head);
   void process_commit_stage_queue(THD *thd, THD *queue, bool async);
   void set_commit_consensus_error(THD *queue_head);
@@ -1447,6 +1474,9 @@ int gtid_empty_group_log_and_cleanup(THD *thd);
 extern const char *log_bin_index;
 extern const char *log_bin_basename;
 extern bool opt_binlog_order_commits;
+extern bool opt_binlog_pipelined_sync;
+extern ulong opt_binlog_sync_latency_target_usec;
+extern bool opt_binlog_trx_writeset;
 extern bool opt_gtid_precommit;
 
 /**
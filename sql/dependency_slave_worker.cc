@@ -212,24 +212,15 @@ Dependency_slave_worker::finalize_event(std::shared_ptr<Log_event_wrapper> &ev)
    *    remove the key-value pair from the map.
    * 2) The "value" of the key-value pair is _not_ equal to this event. In this
    *    case, leave it be; the event corresponds to a later transaction.
+   *
+   * The event is finalized first, this fixes its keys (see
+   * @Log_event_wrapper::set_keys()). The coordinator may still find the event
+   * in the lookup until its keys are removed, adding a dependent to a
+   * finalized event is a no-op.
    */
-  mysql_mutex_lock(&c_rli->dep_key_lookup_mutex);
-  if (likely(!c_rli->dep_key_lookup.empty()))
-  {
-    for (const auto& key : ev->keys)
-    {
-      const auto it= c_rli->dep_key_lookup.find(key);
-      DBUG_ASSERT(it != c_rli->dep_key_lookup.end());
-
-      /* Case 1. (Case 2 is implicitly handled by doing nothing.) */
-      if (it->second == ev)
-      {
-        c_rli->dep_key_lookup.erase(it);
-      }
-    }
-  }
   ev->finalize();
-  mysql_mutex_unlock(&c_rli->dep_key_lookup_mutex);
+  c_rli->dep_key_lookup.remove(ev->keys, ev.get());
+  ++c_rli->dep_events_finalized;
 }
 
 Dependency_slave_worker::Dependency_slave_worker(Relay_log_info *rli
@@ -39,11 +39,13 @@
 #include "rpl_slave.h"
 #include "rpl_rli.h"
 #include "rpl_mi.h"
+#include "rpl_master.h"
 #include "rpl_filter.h"
 #include "rpl_record.h"
 #include "transaction.h"
 #include <my_dir.h>
 #include "rpl_rli_pdb.h"
+#include "rpl_row_decoder.h"
 #include "sql_show.h"    // append_identifier
 #include <mysql/psi/mysql_statement.h>
 #include "rpl_handler.h"
@@ -1369,6 +1371,27 @@ int Log_event::read_log_event(IO_CACHE* file, String* packet,
     goto end;
   }
 
+#ifdef HAVE_REPLICATION
+  /*
+    Recently flushed events are read from the binlog tail cache instead of
+    the file. They were written by this server, so their checksums are not
+    verified again.
+  */
+  if (opt_binlog_tail_cache_size > 0 && log_file_name_arg)
+  {
+    const my_off_t pos= my_b_tell(file);
+    const my_off_t end_pos= dump_log.is_active(log_file_name_arg) ?
+      dump_log.get_binlog_end_pos_without_lock() : ~(my_off_t) 0;
+    ulong event_len;
+    if (binlog_tail_cache_read(log_file_name_arg, pos, end_pos, packet,
+                               &event_len))
+    {
+      my_b_seek(file, pos + event_len);
+      goto end;
+    }
+  }
+#endif
+
   if (my_b_read(file, (uchar*) buf, sizeof(buf)))
   {
     /*
@@ -2895,9 +2918,12 @@ Slave_worker *Log_event::get_slave_worker(Relay_log_info *rli)
 
   /* checking partioning properties and perform corresponding actions */
 
-  // Beginning of a group designated explicitly with BEGIN or GTID
+  // Beginning of a group designated explicitly with BEGIN or GTID, metadata
+  // events after BEGIN (e.g. the writeset) go to the worker of the group.
+  // Older versions start a new group on any metadata event, which is why
+  // their replicas must be upgraded before binlog_trx_writeset is enabled.
   if ((is_s_event= starts_group()) || is_gtid_event(this) ||
-      get_type_code() == METADATA_EVENT ||
+      (get_type_code() == METADATA_EVENT && !rli->curr_group_seen_begin) ||
       // or DDL:s or autocommit queries possibly associated with own p-events
       (!rli->curr_group_seen_begin && !rli->curr_group_seen_gtid &&
        /*
@@ -3323,6 +3349,15 @@ bool Log_event::schedule_dep(Relay_log_info *rli)
     rli->set_dep_sync_group(true);
   }
 
+  // case: in WRITESET mode the keys of the trx are only known from the writeset
+  // logged before its end event, a trx without one is executed in isolation
+  if (rli->mts_dependency_replication == DEP_RPL_WRITESET &&
+      ev->is_end_event && !rli->curr_group_seen_writeset &&
+      !rli->dep_sync_group)
+  {
+    rli->set_dep_sync_group(true);
+  }
+
   if (unlikely(rli->dep_sync_group))
   {
     if (!wait_for_dep_workers_to_finish(rli, rli->trx_queued))
@@ -3342,9 +3377,14 @@ bool Log_event::schedule_dep(Relay_log_info *rli)
   mts_group_idx= rli->gaq->assigned_group_index;
 
   // case: current trx is to be executed in isolation or the DB has been set, so
-  // let's queue it for execution
+  // let's queue it for execution. In WRITESET mode we also wait for the
+  // writeset, the dependencies of the trx are added to its begin event when
+  // the writeset is seen and the trx must not start executing before that.
   if (!rli->trx_queued &&
-      (rli->dep_sync_group || !rli->current_begin_event->get_db().empty()))
+      (rli->dep_sync_group ||
+       (!rli->current_begin_event->get_db().empty() &&
+        (rli->mts_dependency_replication != DEP_RPL_WRITESET ||
+         rli->curr_group_seen_writeset))))
   {
     mysql_mutex_lock(&rli->dep_lock);
 
@@ -3413,6 +3453,8 @@ bool Log_event::schedule_dep(Relay_log_info *rli)
   else
     rli->num_events_in_current_group= 0;
 
+  ++rli->dep_events_scheduled;
+
   DBUG_RETURN(true);
 }
 
@@ -3461,8 +3503,8 @@ Log_event::handle_terminal_dep_event(Relay_log_info *rli,
   {
     // Populate key->last trx penultimate/end event in the key lookup
     //
-    // NOTE: We store the end event in STMT mode and penultimate event in TBL
-    // mode. We always store end event for single event trxs.
+    // NOTE: We store the end event in STMT and WRITESET mode and penultimate
+    // event in TBL mode. We always store end event for single event trxs.
     //
     // Why store penultimate event instead of end event in TBL mode?
     // This is to improve perf for TBL mode. When we depend on the end event of
@@ -3486,16 +3528,7 @@ Log_event::handle_terminal_dep_event(Relay_log_info *rli,
     auto to_add=
       rli->mts_dependency_replication == DEP_RPL_TABLE && rli->prev_event ?
       rli->prev_event : ev;
-    mysql_mutex_lock(&rli->dep_key_lookup_mutex);
-    if (!to_add->finalized())
-    {
-      for (const auto& key : rli->keys_accessed_by_group)
-      {
-        rli->dep_key_lookup[key]= to_add;
-        to_add->keys.insert(key);
-      }
-    }
-    mysql_mutex_unlock(&rli->dep_key_lookup_mutex);
+    rli->dep_key_lookup.add(rli->keys_accessed_by_group, to_add);
 
     // update rli state
     rli->table_map_events.clear();
@@ -3504,6 +3537,7 @@ Log_event::handle_terminal_dep_event(Relay_log_info *rli,
 
     rli->mts_group_status= Relay_log_info::MTS_END_GROUP;
     rli->curr_group_seen_begin = rli->curr_group_seen_gtid = false;
+    rli->curr_group_seen_writeset= false;
 
     // update coordinates in GAQ
     Slave_job_group *ptr_group=
@@ -11513,6 +11547,12 @@ int Rows_log_event::handle_idempotent_and_ignored_errors(Relay_log_info const *r
   return *err;
 }
 
+bool Rows_log_event::next_decoded_row()
+{
+  return m_row_decoder->next_row(m_table, m_curr_row, &m_curr_row_end,
+                                 &m_master_reclength, &thd->row_query);
+}
+
 int Rows_log_event::do_apply_row(Relay_log_info const *rli,
                                  table_def *tabledef)
 {
@@ -12505,6 +12545,7 @@ bool Rows_log_event::parse_keys(Relay_log_info* rli,
 
       std::shared_ptr<uchar> tmp(key_buf, key_dealloc_cb);
       curr_key.key_buffer= tmp;
+      curr_key.compute_hash();
       keys.push_back(curr_key);
     }
   }
@@ -12534,6 +12575,7 @@ bool Rows_log_event::get_keys(Relay_log_info *rli,
   {
     Dependency_key table_key;
     table_key.table_id= m_table_name;
+    table_key.compute_hash();
     keys.push_back(table_key);
     DBUG_RETURN(true);
   }
@@ -12655,6 +12697,13 @@ void Rows_log_event::prepare_dep(Relay_log_info *rli,
     DBUG_VOID_RETURN;
   }
 
+  // case: the keys are taken from the writeset logged by the master, see
+  // @Metadata_log_event::prepare_dep
+  if (rli->mts_dependency_replication == DEP_RPL_WRITESET)
+  {
+    DBUG_VOID_RETURN;
+  }
+
   const auto tbe= rli->table_map_events.at(get_table_id());
 
   std::string db_name(tbe->get_db_name());
@@ -12682,19 +12731,11 @@ void Rows_log_event::prepare_dep(Relay_log_info *rli,
   else
   {
     rli->keys_accessed_by_group.insert(m_keylist.begin(), m_keylist.end());
+    rli->dep_keys_extracted+= m_keylist.size();
   }
 
-  mysql_mutex_lock(&rli->dep_key_lookup_mutex);
   /* Handle dependencies. */
-  for (const auto& k : m_keylist)
-  {
-    auto last_key_event= rli->dep_key_lookup.find(k);
-    if (last_key_event != rli->dep_key_lookup.end())
-    {
-      last_key_event->second->add_dependent(ev);
-    }
-  }
-  mysql_mutex_unlock(&rli->dep_key_lookup_mutex);
+  rli->dep_key_lookup.add_dependencies(m_keylist, ev);
 
   DBUG_VOID_RETURN;
 }
@@ -13321,6 +13362,18 @@ int Rows_log_event::do_apply_event(Relay_log_info const *rli)
         break;
     }
 
+    /*
+      Decode the rows of write events on another thread while the rows
+      before them are written.
+    */
+    if (opt_slave_decode_rows_ahead &&
+        get_general_type_code() == WRITE_ROWS_EVENT &&
+        Rows_decoder::can_decode(table, tabledef, conv_table, &m_cols,
+                                 m_width, m_curr_row, m_rows_end) &&
+        (m_row_decoder= const_cast<Relay_log_info*>(rli)->get_rows_decoder()))
+      m_row_decoder->start(thd, table, tabledef, m_width, &m_cols,
+                           m_curr_row, m_rows_end);
+
     do {
 
       error= (this->*do_apply_row_ptr)(rli, tabledef);
@@ -13354,6 +13407,12 @@ int Rows_log_event::do_apply_event(Relay_log_info const *rli)
 
 AFTER_MAIN_EXEC_ROW_LOOP:
 
+    if (m_row_decoder)
+    {
+      m_row_decoder->finish();
+      m_row_decoder= NULL;
+    }
+
     if (saved_m_curr_row != m_curr_row && !table->file->has_transactions())
     {
       /*
@@ -16563,6 +16622,21 @@ void Metadata_log_event::set_raft_rotate_tag
     (ENCODED_TYPE_SIZE + ENCODED_LENGTH_SIZE + ENCODED_RAFT_ROTATE_TAG_SIZE);
 }
 
+void Metadata_log_event::set_writeset(const std::vector<uint64_t> &writeset)
+{
+  DBUG_ASSERT(writeset.size() <= MAX_WRITESET_SIZE);
+  writeset_= writeset;
+  set_exist(Metadata_log_event_types::WRITESET_TYPE);
+  // Update the size of the event when it gets serialized into the stream.
+  size_ += (ENCODED_TYPE_SIZE + ENCODED_LENGTH_SIZE +
+            writeset_.size() * ENCODED_WRITESET_HASH_SIZE);
+}
+
+const std::vector<uint64_t>& Metadata_log_event::get_writeset() const
+{
+  return writeset_;
+}
+
 Metadata_log_event::RAFT_ROTATE_EVENT_TAG
 Metadata_log_event::get_rotate_tag() const
 {
@@ -16623,6 +16697,7 @@ uint Metadata_log_event::read_type(
   std::string generic_str;
   int64_t prev_term= -1, prev_index= -1;
   RAFT_ROTATE_EVENT_TAG raft_rotate_tag= RRET_NOT_ROTATE;
+  std::vector<uint64_t> writeset;
 
   switch (type)
   {
@@ -16658,6 +16733,14 @@ uint Metadata_log_event::read_type(
       raft_rotate_tag= (RAFT_ROTATE_EVENT_TAG)uint2korr(buffer + ENCODED_LENGTH_SIZE);
       set_raft_rotate_tag(raft_rotate_tag);
       break;
+    case MLET::WRITESET_TYPE:
+      DBUG_ASSERT(value_length % ENCODED_WRITESET_HASH_SIZE == 0);
+      writeset.reserve(value_length / ENCODED_WRITESET_HASH_SIZE);
+      for (uint i= 0; i + ENCODED_WRITESET_HASH_SIZE <= value_length;
+           i+= ENCODED_WRITESET_HASH_SIZE)
+        writeset.push_back(uint8korr(buffer + ENCODED_LENGTH_SIZE + i));
+      set_writeset(writeset);
+      break;
     default:
       // This is a event which we do not know about. Just skip this
       size_ += (ENCODED_TYPE_SIZE + ENCODED_LENGTH_SIZE + value_length);
@@ -16696,6 +16779,9 @@ bool Metadata_log_event::write_data_body(IO_CACHE *file)
   if (write_rotate_tag(file))
     DBUG_RETURN(1);
 
+  if (write_writeset(file))
+    DBUG_RETURN(1);
+
   DBUG_RETURN(0);
 }
 
@@ -16860,6 +16946,32 @@ bool Metadata_log_event::write_rotate_tag(IO_CACHE* file)
   DBUG_RETURN(ret);
 }
 
+bool Metadata_log_event::write_writeset(IO_CACHE* file)
+{
+  DBUG_ENTER("Metadata_log_event::write_writeset");
+
+  if (!does_exist(Metadata_log_event_types::WRITESET_TYPE))
+    DBUG_RETURN(0); /* No need to write writeset */
+
+  if (write_type_and_length(
+        file,
+        Metadata_log_event_types::WRITESET_TYPE,
+        writeset_.size() * ENCODED_WRITESET_HASH_SIZE))
+  {
+    DBUG_RETURN(1);
+  }
+
+  for (const auto hash : writeset_)
+  {
+    char buffer[ENCODED_WRITESET_HASH_SIZE];
+    int8store(buffer, hash);
+    if (wrapper_my_b_safe_write(file, (uchar *) buffer, sizeof(buffer)))
+      DBUG_RETURN(1);
+  }
+
+  DBUG_RETURN(0);
+}
+
 bool Metadata_log_event::write_type_and_length(
     IO_CACHE* file, Metadata_log_event_types type, uint32_t length)
 {
@@ -16948,6 +17060,13 @@ int Metadata_log_event::pack_info(Protocol *protocol)
     buffer.append("Rotate Event Tag: " + get_rotate_tag_string());
     field_added= true;
   }
+  if (does_exist(Metadata_log_event_types::WRITESET_TYPE))
+  {
+    if (field_added)
+      buffer.append(" ");
+    buffer.append("Writeset size: " + std::to_string(writeset_.size()));
+    field_added= true;
+  }
   if (buffer.length() > 0)
     protocol->store(buffer.c_str(), buffer.length(), &my_charset_bin);
 
@@ -16984,6 +17103,9 @@ Metadata_log_event::print(FILE *file, PRINT_EVENT_INFO *print_event_info)
     if (does_exist(Metadata_log_event_types::RAFT_ROTATE_TAG_TYPE))
       buffer.append(
           "\tRotate Event Tag: " + get_rotate_tag_string());
+    if (does_exist(Metadata_log_event_types::WRITESET_TYPE))
+      buffer.append(
+          "\tWriteset size: " + std::to_string(writeset_.size()));
 
     print_header(head, print_event_info, FALSE);
     my_b_printf(head, "%s\n", buffer.c_str());
@@ -17016,6 +17138,59 @@ int Metadata_log_event::do_apply_event(Relay_log_info const *rli)
   DBUG_RETURN(error);
 }
 
+void Metadata_log_event::prepare_dep(Relay_log_info *rli,
+                                     std::shared_ptr<Log_event_wrapper> &ev)
+{
+  DBUG_ENTER("Metadata_log_event::prepare_dep");
+
+  Log_event::prepare_dep(rli, ev);
+
+  if (rli->mts_dependency_replication != DEP_RPL_WRITESET ||
+      !does_exist(Metadata_log_event_types::WRITESET_TYPE) ||
+      ev->is_begin_event)
+  {
+    DBUG_VOID_RETURN;
+  }
+
+  rli->curr_group_seen_writeset= true;
+
+  // case: this group will be synced, so we don't need to store keys
+  if (rli->dep_sync_group)
+  {
+    DBUG_VOID_RETURN;
+  }
+
+  if (unlikely(writeset_.size() + rli->keys_accessed_by_group.size() >
+               rli->mts_dependency_max_keys))
+  {
+    rli->set_dep_sync_group(true);
+    rli->keys_accessed_by_group.clear();
+    DBUG_VOID_RETURN;
+  }
+
+  std::deque<Dependency_key> keys;
+  for (const auto hash : writeset_)
+  {
+    char buffer[ENCODED_WRITESET_HASH_SIZE];
+    int8store(buffer, hash);
+    Dependency_key key;
+    key.table_id.assign(buffer, sizeof(buffer));
+    key.compute_hash();
+    keys.push_back(key);
+  }
+  rli->keys_accessed_by_group.insert(keys.begin(), keys.end());
+  rli->dep_keys_extracted+= keys.size();
+
+  // The writeset comes last, so it's the begin event that has to wait for the
+  // trxs that wrote the same keys, the trx is not queued before this point
+  // (see @Log_event::schedule_dep)
+  DBUG_ASSERT(!rli->trx_queued);
+  auto begin_event= ev->begin_event();
+  rli->dep_key_lookup.add_dependencies(keys, begin_event);
+
+  DBUG_VOID_RETURN;
+}
+
 int Metadata_log_event::do_update_pos(Relay_log_info *rli)
 {
   rli->inc_event_relay_log_pos();
@@ -34,6 +34,7 @@
 #include "table_id.h"
 #include <set>
 #include <deque>
+#include <vector>
 #include <my_murmur3.h>
 
 #ifdef MYSQL_CLIENT
@@ -70,15 +71,33 @@ struct Dependency_key
   uint key_length= 0;
   std::string table_id;
   std::shared_ptr<uchar> key_buffer;
+  // Hash of the key, computed once by @compute_hash() when the key is
+  // extracted so that the coordinator doesn't rehash the key buffer for every
+  // lookup
+  std::size_t hash= 0;
 
   Dependency_key()
   {
     key_length= 0;
   }
 
+  void compute_hash()
+  {
+    if (key_length > 0)
+    {
+      hash= murmur3_32((const uchar*)(table_id.c_str()), table_id.length(), 0);
+      hash= murmur3_32(key_buffer.get(), key_length, hash);
+    }
+    else
+    {
+      hash= std::hash<std::string>{}(table_id);
+    }
+  }
+
   bool operator==(const Dependency_key& other) const
   {
-    return (key_length == other.key_length &&
+    return (hash == other.hash &&
+            key_length == other.key_length &&
             table_id == other.table_id &&
             (key_length == 0 ||
              !memcmp(key_buffer.get(), other.key_buffer.get(), key_length)));
@@ -98,23 +117,7 @@ namespace std
   {
     std::size_t operator() (const Dependency_key &k) const
     {
-      using std::size_t;
-      using std::hash;
-      using std::string;
-
-      size_t ret= 0;
-      uchar *buf= k.key_buffer.get();
-      if (k.key_length > 0)
-      {
-        ret= murmur3_32((const uchar*)(k.table_id.c_str()),
-                        k.table_id.length(), 0);
-        ret= murmur3_32(buf, k.key_length, ret);
-      }
-      else
-      {
-        ret= std::hash<string>{}(k.table_id);
-      }
-      return ret;
+      return k.hash;
     }
   };
 }
@@ -828,6 +831,7 @@ class THD;
 
 class Format_description_log_event;
 class Relay_log_info;
+class Rows_decoder;
 class Slave_worker;
 class Slave_committed_queue;
 
@@ -4500,6 +4504,15 @@ private:
   */
   uchar *m_distinct_key_spare_buf;
   bool master_had_triggers;
+  /*
+    Decodes the rows of this event ahead of the applier while it is being
+    applied, see slave_decode_rows_ahead.
+  */
+  Rows_decoder *m_row_decoder= nullptr;
+
+  // Take the current row from m_row_decoder, returns false if it was
+  // not decoded ahead
+  bool next_decoded_row();
 
   // Unpack the current row into m_table->record[0]
   int unpack_current_row(const Relay_log_info *const rli,
@@ -4542,7 +4555,8 @@ private:
     {
       res= HA_ERR_CORRUPT_EVENT;
     }
-    else
+    else if (m_row_decoder == NULL || cols != &m_cols ||
+             !next_decoded_row())
     {
       res = ::unpack_row(rli, m_table, m_width, m_curr_row, cols,
                          &m_curr_row_end, &m_master_reclength, m_rows_end,
@@ -5532,6 +5546,27 @@ public:
    */
   void set_raft_rotate_tag(RAFT_ROTATE_EVENT_TAG t);
 
+  /**
+   * Set the writeset of the transaction, i.e. the hashes of the unique keys
+   * of the rows it wrote, and update internal state needed later to write
+   * this to stream
+   *
+   * @param writeset - The hashes, at most MAX_WRITESET_SIZE of them
+   */
+  void set_writeset(const std::vector<uint64_t> &writeset);
+
+  /**
+   * Get the writeset of the transaction
+   *
+   * @return The hashes of the writeset, empty if not present
+   */
+  const std::vector<uint64_t>& get_writeset() const;
+
+#if defined(MYSQL_SERVER) && defined(HAVE_REPLICATION)
+  void prepare_dep(Relay_log_info *rli,
+                   std::shared_ptr<Log_event_wrapper> &ev);
+#endif
+
   /**
    * The spec for different 'types' supported by this event
    */
@@ -5554,9 +5589,20 @@ public:
     RAFT_PREV_OPID_TYPE= 4,
     /* Raft Rotate Event Tag Type */
     RAFT_ROTATE_TAG_TYPE = 5,
+    /* Hashes of the unique keys written by the transaction, written before
+     * the end event of the transaction when binlog_trx_writeset is set.
+     * Unlike the other types it is logged inside a group, multi-threaded
+     * replicas that predate it assign the event to a new group */
+    WRITESET_TYPE= 6,
     METADATA_EVENT_TYPE_MAX,
   };
 
+  /* Use 8 bytes to encode a hash of the writeset */
+  static const uint32_t ENCODED_WRITESET_HASH_SIZE= sizeof(uint64_t);
+  /* Max number of hashes that fit in the 2 byte length of a field */
+  static const uint32_t MAX_WRITESET_SIZE=
+    UINT_MAX16 / ENCODED_WRITESET_HASH_SIZE;
+
   /**
    * @returns TRUE if 'type' exists in this event, false otherwise
    */
@@ -5635,6 +5681,15 @@ private:
    */
   bool write_rotate_tag(IO_CACHE* file);
 
+  /**
+   * Write the writeset to file
+   *
+   * @param file - file to write into
+   *
+   * @returns - 0 on success, 1 on false
+   */
+  bool write_writeset(IO_CACHE* file);
+
   /**
    * Write type and length to file
    *
@@ -5687,6 +5742,10 @@ private:
   // will write as uint16_t
   static const uint32_t ENCODED_RAFT_ROTATE_TAG_SIZE= sizeof(uint16_t);
 
+  /* Hashes of the unique keys written by the transaction. The type
+   * corresponding to this is WRITESET_TYPE */
+  std::vector<uint64_t> writeset_;
+
   /* Total size of this event when encoded into the stream */
   uint32_t size_= 0;
 
@@ -2,6 +2,8 @@
 #define LOG_EVENT_WRAPPER_H
 
 #include "log_event.h"
+#include <deque>
+#include <unordered_map>
 
 int slave_worker_exec_job(Slave_worker *worker, Relay_log_info *rli);
 
@@ -79,9 +81,16 @@ public:
   void add_dependent(std::shared_ptr<Log_event_wrapper> &ev)
   {
     mysql_mutex_lock(&mutex);
-    DBUG_ASSERT(!is_finalized && ev.get() != this && ev->raw_ev && raw_ev);
-    dependents.push_back(ev);
-    ev->incr_dependency();
+    DBUG_ASSERT(ev.get() != this && ev->raw_ev && raw_ev);
+    // case: we've already been executed and our dependents have been notified,
+    // this can happen when the coordinator finds us in the key lookup before
+    // the worker that finalized us has removed our keys from it, there's
+    // nothing to wait for in that case
+    if (likely(!is_finalized))
+    {
+      dependents.push_back(ev);
+      ev->incr_dependency();
+    }
     mysql_mutex_unlock(&mutex);
   }
 
@@ -121,6 +130,23 @@ public:
     mysql_mutex_unlock(&mutex);
   }
 
+  /**
+    Takes over @group_keys as the keys of this event unless it has already
+    been finalized, after @finalize() the keys don't change anymore.
+
+    @return true if the keys were taken over, false if the event has been
+            finalized
+  */
+  bool set_keys(std::unordered_set<Dependency_key> &group_keys)
+  {
+    mysql_mutex_lock(&mutex);
+    const auto ret= !is_finalized;
+    if (likely(ret))
+      keys.swap(group_keys);
+    mysql_mutex_unlock(&mutex);
+    return ret;
+  }
+
   bool finalized()
   {
     mysql_mutex_lock(&mutex);
@@ -151,4 +177,129 @@ public:
   }
 };
 
+/**
+  @class Dependency_key_lookup
+
+  Maps a key to the penultimate/end event of the last trx that accessed it.
+  The map is split into shards by the hash of the key, each with its own
+  mutex, so that the coordinator looking up and registering keys and the
+  workers removing the keys of finalized events only serialize when they
+  access the same shard.
+  */
+class Dependency_key_lookup
+{
+  static const uint NUM_SHARDS= 64;
+
+  struct Shard
+  {
+    mysql_mutex_t mutex;
+    std::unordered_map<Dependency_key, std::shared_ptr<Log_event_wrapper>> map;
+  } MY_ATTRIBUTE((aligned(CPU_LEVEL1_DCACHE_LINESIZE)));
+
+  Shard shards[NUM_SHARDS];
+
+  Shard& get_shard(const Dependency_key &key)
+  {
+    return shards[std::hash<Dependency_key>{}(key) % NUM_SHARDS];
+  }
+
+public:
+  Dependency_key_lookup()
+  {
+    for (auto& shard : shards)
+      mysql_mutex_init(0, &shard.mutex, MY_MUTEX_INIT_FAST);
+  }
+
+  ~Dependency_key_lookup()
+  {
+    for (auto& shard : shards)
+      mysql_mutex_destroy(&shard.mutex);
+  }
+
+  /**
+    Makes @ev depend on the events registered for @keys.
+  */
+  void add_dependencies(const std::deque<Dependency_key> &keys,
+                        std::shared_ptr<Log_event_wrapper> &ev)
+  {
+    for (const auto& key : keys)
+    {
+      auto& shard= get_shard(key);
+      mysql_mutex_lock(&shard.mutex);
+      const auto it= shard.map.find(key);
+      if (it != shard.map.end())
+        it->second->add_dependent(ev);
+      mysql_mutex_unlock(&shard.mutex);
+    }
+  }
+
+  /**
+    Registers @ev as the event to depend on for @keys and hands the keys over
+    to @ev, which removes them again when it's finalized (see @remove()).
+  */
+  void add(std::unordered_set<Dependency_key> &keys,
+           const std::shared_ptr<Log_event_wrapper> &ev)
+  {
+    if (ev->finalized())
+      return;
+
+    for (const auto& key : keys)
+    {
+      auto& shard= get_shard(key);
+      mysql_mutex_lock(&shard.mutex);
+      shard.map[key]= ev;
+      mysql_mutex_unlock(&shard.mutex);
+    }
+
+    // case: the event was finalized while we were adding its keys, it won't
+    // remove them on its own so we have to do it here
+    if (unlikely(!ev->set_keys(keys)))
+      remove(keys, ev.get());
+  }
+
+  /**
+    Removes the entries for @keys that still refer to @ev, entries referring to
+    a later trx are left alone.
+  */
+  void remove(const std::unordered_set<Dependency_key> &keys,
+              const Log_event_wrapper *ev)
+  {
+    for (const auto& key : keys)
+    {
+      auto& shard= get_shard(key);
+      mysql_mutex_lock(&shard.mutex);
+      // the entry may be gone already: a later trx may have taken over
+      // the key and removed it when it was finalized before us
+      const auto it= shard.map.find(key);
+      if (it != shard.map.end() && it->second.get() == ev)
+        shard.map.erase(it);
+      mysql_mutex_unlock(&shard.mutex);
+    }
+  }
+
+  void clear()
+  {
+    for (auto& shard : shards)
+    {
+      mysql_mutex_lock(&shard.mutex);
+      shard.map.clear();
+      mysql_mutex_unlock(&shard.mutex);
+    }
+  }
+
+  bool empty()
+  {
+    bool ret= true;
+    for (auto& shard : shards)
+    {
+      mysql_mutex_lock(&shard.mutex);
+      ret= shard.map.empty();
+      mysql_mutex_unlock(&shard.mutex);
+      if (!ret)
+        break;
+    }
+    return ret;
+  }
+};
+
 #endif // LOG_EVENT_WRAPPER_H
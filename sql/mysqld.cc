@@ -577,6 +577,7 @@ my_bool opt_local_infile, opt_slave_compressed_protocol;
 my_bool opt_slave_compressed_event_protocol;
 ulonglong opt_max_compressed_event_cache_size;
 ulonglong opt_compressed_event_cache_evict_threshold;
+ulonglong opt_binlog_tail_cache_size= 0;
 ulong opt_slave_compression_lib;
 ulonglong opt_slave_dump_thread_wait_sleep_usec;
 my_bool rpl_wait_for_semi_sync_ack;
@@ -650,6 +651,8 @@ ulonglong relay_sql_wait_time= 0;
 /* Cache hit ratio when using slave_compressed_event_protocol in dump thread.
    It is updated every minute */
 double comp_event_cache_hit_ratio= 0;
+std::atomic<ulonglong> binlog_tail_cache_hits{0};
+std::atomic<ulonglong> binlog_tail_cache_misses{0};
 
 /* Number of times async dump threads waited for semi-sync ACK */
 ulonglong repl_semi_sync_master_ack_waits= 0;
@@ -816,6 +819,8 @@ uint  slave_net_timeout;
 ulong slave_exec_mode_options;
 ulong slave_use_idempotent_for_recovery_options = 0;
 ulong slave_run_triggers_for_rbr = 0;
+my_bool opt_slave_decode_rows_ahead= FALSE;
+ulonglong slave_rows_decoded_ahead= 0;
 ulonglong slave_type_conversions_options;
 char *opt_rbr_column_type_mismatch_whitelist= nullptr;
 ulonglong admission_control_filter;
@@ -10466,6 +10471,22 @@ static int show_slave_retried_trans(THD *thd, SHOW_VAR *var, char *buff)
   return 0;
 }
 
+static int show_binlog_tail_cache_hits(THD *thd, SHOW_VAR *var, char *buf)
+{
+  var->type= SHOW_LONGLONG;
+  var->value= buf;
+  *((longlong *)buf)= binlog_tail_cache_hits.load();
+  return 0;
+}
+
+static int show_binlog_tail_cache_misses(THD *thd, SHOW_VAR *var, char *buf)
+{
+  var->type= SHOW_LONGLONG;
+  var->value= buf;
+  *((longlong *)buf)= binlog_tail_cache_misses.load();
+  return 0;
+}
+
 static int show_slave_commit_order_deadlocks(THD *thd, SHOW_VAR *var, char *buf)
 {
   if (active_mi && active_mi->rli)
@@ -11320,6 +11341,8 @@ SHOW_VAR status_vars[]= {
   {"Rpl_seconds_delete_rows",  (char*) &repl_event_times[DELETE_ROWS_EVENT],   SHOW_TIMER},
   {"Rpl_seconds_incident",     (char*) &repl_event_times[INCIDENT_EVENT],      SHOW_TIMER},
   {"Compressed_event_cache_hit_ratio", (char*) &comp_event_cache_hit_ratio, SHOW_DOUBLE},
+  {"Binlog_tail_cache_hits", (char*) &show_binlog_tail_cache_hits, SHOW_FUNC},
+  {"Binlog_tail_cache_misses", (char*) &show_binlog_tail_cache_misses, SHOW_FUNC},
   {"Rpl_semi_sync_master_ack_waits",  (char*) &repl_semi_sync_master_ack_waits, SHOW_LONGLONG},
   {"Rpl_last_semi_sync_acked_pos", (char*) &show_last_acked_binlog_pos,
     SHOW_FUNC},
@@ -11352,6 +11375,7 @@ SHOW_VAR status_vars[]= {
   {"Slave_dependency_next_waits", (char*) &show_slave_dependency_next_waits, SHOW_FUNC},
   {"Slave_dependency_num_syncs", (char*) &show_slave_dependency_num_syncs, SHOW_FUNC},
   {"Slave_before_image_inconsistencies", (char*) &show_slave_before_image_inconsistencies, SHOW_FUNC},
+  {"Slave_rows_decoded_ahead", (char*) &slave_rows_decoded_ahead, SHOW_LONGLONG},
 	{"Slave_high_priority_ddl_executed", (char *)&slave_high_priority_ddl_executed, SHOW_LONGLONG},
 	{"Slave_high_priority_ddl_killed_connections", (char *)&slave_high_priority_ddl_killed_connections, SHOW_LONGLONG},
 #endif
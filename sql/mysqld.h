@@ -333,6 +333,7 @@ extern my_bool opt_slave_compressed_protocol, use_temp_pool;
 extern my_bool opt_slave_compressed_event_protocol;
 extern ulonglong opt_max_compressed_event_cache_size;
 extern ulonglong opt_compressed_event_cache_evict_threshold;
+extern ulonglong opt_binlog_tail_cache_size;
 extern ulong opt_slave_compression_lib;
 extern ulonglong opt_slave_dump_thread_wait_sleep_usec;
 extern my_bool rpl_wait_for_semi_sync_ack;
@@ -342,6 +343,8 @@ extern std::atomic<ulonglong> slave_commit_order_deadlocks;
 extern ulong slave_exec_mode_options;
 extern ulong slave_use_idempotent_for_recovery_options;
 extern ulong slave_run_triggers_for_rbr;
+extern my_bool opt_slave_decode_rows_ahead;
+extern ulonglong slave_rows_decoded_ahead;
 extern ulonglong slave_type_conversions_options;
 extern char* opt_rbr_column_type_mismatch_whitelist;
 extern ulonglong admission_control_filter;
@@ -442,6 +445,8 @@ extern ulong relay_io_events, relay_sql_events;
 extern ulonglong relay_io_bytes, relay_sql_bytes;
 extern ulonglong relay_sql_wait_time;
 extern double comp_event_cache_hit_ratio;
+extern std::atomic<ulonglong> binlog_tail_cache_hits;
+extern std::atomic<ulonglong> binlog_tail_cache_misses;
 extern ulonglong repl_semi_sync_master_ack_waits;
 extern my_bool recv_skip_ibuf_operations;
 extern bool enable_blind_replace;
@@ -31,6 +31,8 @@
 #include <sys/socket.h>
 #include "binlog.h"
 #include "rpl_slave.h"
+#include <algorithm>
+#include <deque>
 #include <queue>
 
 #include "sql_show.h" // schema_table_store_record
@@ -131,6 +133,30 @@ static comp_event_queue comp_event_queue_list[COMP_EVENT_CACHE_NUM_SHARDS];
 static std::atomic<size_t>
         comp_event_cache_size_list[COMP_EVENT_CACHE_NUM_SHARDS];
 
+/*
+  The binlog tail cache keeps the bytes of the most recent flush groups of
+  the binary log in memory, so that dump threads close to the end of the
+  binary log read events from memory instead of each reading the binlog
+  file and verifying the checksums. Each chunk holds the whole events
+  written by one flush group, and the chunks are contiguous in the file
+  binlog_tail_file_name. The oldest chunks are evicted once the cache is
+  larger than binlog_tail_cache_size.
+*/
+struct binlog_tail_chunk
+{
+  my_off_t start;
+  size_t len;
+  std::shared_ptr<const std::vector<uchar>> buff;
+};
+
+static mysql_rwlock_t LOCK_binlog_tail_cache;
+#ifdef HAVE_PSI_INTERFACE
+static PSI_rwlock_key key_LOCK_binlog_tail_cache;
+#endif
+static std::string binlog_tail_file_name;
+static std::deque<binlog_tail_chunk> binlog_tail_chunks;
+static size_t binlog_tail_size= 0;
+
 std::atomic<bool> block_dump_threads{false};
 
 #ifndef DBUG_OFF
@@ -232,6 +258,7 @@ void init_compressed_event_cache()
 #endif
     comp_event_cache_size_list[i]= 0;
   }
+  mysql_rwlock_init(key_LOCK_binlog_tail_cache, &LOCK_binlog_tail_cache);
   comp_event_cache_inited= true;
   cache_hit_count= cache_miss_count= 0;
   cache_stats_timer= my_time(0);
@@ -255,11 +282,21 @@ void clear_compressed_event_cache()
 #endif
     DBUG_ASSERT(comp_event_cache_size_list[i] == 0);
   }
+  clear_binlog_tail_cache();
   cache_hit_count= cache_miss_count= 0;
   cache_stats_timer= my_time(0);
   comp_event_cache_hit_ratio= 0;
 }
 
+void clear_binlog_tail_cache()
+{
+  mysql_rwlock_wrlock(&LOCK_binlog_tail_cache);
+  binlog_tail_chunks.clear();
+  binlog_tail_size= 0;
+  binlog_tail_file_name.clear();
+  mysql_rwlock_unlock(&LOCK_binlog_tail_cache);
+}
+
 void free_compressed_event_cache()
 {
   /* No need to protect @comp_event_cache_inited because it's changed only at
@@ -276,6 +313,7 @@ void free_compressed_event_cache()
       mysql_rwlock_destroy(&LOCK_comp_event_cache[i]);
 #endif
     }
+    mysql_rwlock_destroy(&LOCK_binlog_tail_cache);
     comp_event_cache_inited= false;
   }
 }
@@ -996,6 +1034,114 @@ err:
 }
 #endif
 
+/**
+  Adds the bytes written to the binary log by a flush group to the binlog
+  tail cache. The cache is reset if the bytes do not follow the cached
+  ones, e.g. after the binary log was rotated or an event was written
+  outside of a flush group.
+
+  @param log_file_name  Full name of the binary log file
+  @param pos            Position of the first byte in the file
+  @param buff           The bytes, whole events only
+*/
+void binlog_tail_cache_append(const char *log_file_name, my_off_t pos,
+                              std::shared_ptr<const std::vector<uchar>> buff)
+{
+  const size_t max_size= (1 << 20) * opt_binlog_tail_cache_size;
+  const size_t len= buff->size();
+
+  mysql_rwlock_wrlock(&LOCK_binlog_tail_cache);
+  if (binlog_tail_chunks.empty() ||
+      binlog_tail_chunks.back().start + binlog_tail_chunks.back().len != pos ||
+      binlog_tail_file_name.compare(log_file_name) != 0)
+  {
+    binlog_tail_chunks.clear();
+    binlog_tail_size= 0;
+    binlog_tail_file_name.assign(log_file_name);
+  }
+
+  if (len <= max_size)
+  {
+    binlog_tail_chunks.push_back({pos, len, buff});
+    binlog_tail_size+= len;
+  }
+  else
+  {
+    binlog_tail_chunks.clear();
+    binlog_tail_size= 0;
+  }
+
+  while (binlog_tail_size > max_size)
+  {
+    binlog_tail_size-= binlog_tail_chunks.front().len;
+    binlog_tail_chunks.pop_front();
+  }
+  mysql_rwlock_unlock(&LOCK_binlog_tail_cache);
+}
+
+/**
+  Appends the event at the given position of a binary log file to the
+  packet if the event is in the binlog tail cache.
+
+  @param log_file_name  Full name of the binary log file
+  @param pos            Position of the event in the file
+  @param end_pos        The event must end at or before this position
+  @param packet         The packet to append the event to
+  @param[out] event_len Length of the event
+
+  @retval true  the event was appended
+  @retval false the event must be read from the file
+*/
+bool binlog_tail_cache_read(const char *log_file_name, my_off_t pos,
+                            my_off_t end_pos, String *packet,
+                            ulong *event_len)
+{
+  binlog_tail_chunk chunk;
+  bool found= false;
+
+  mysql_rwlock_rdlock(&LOCK_binlog_tail_cache);
+  if (!binlog_tail_chunks.empty() &&
+      pos >= binlog_tail_chunks.front().start &&
+      pos < binlog_tail_chunks.back().start + binlog_tail_chunks.back().len &&
+      binlog_tail_file_name.compare(log_file_name) == 0)
+  {
+    auto it= std::upper_bound(binlog_tail_chunks.begin(),
+                              binlog_tail_chunks.end(), pos,
+                              [] (my_off_t p, const binlog_tail_chunk &c)
+                              { return p < c.start; });
+    DBUG_ASSERT(it != binlog_tail_chunks.begin());
+    chunk= *(--it);
+    found= true;
+  }
+  mysql_rwlock_unlock(&LOCK_binlog_tail_cache);
+
+  if (!found)
+  {
+    ++binlog_tail_cache_misses;
+    return false;
+  }
+
+  /* The chunk is kept alive by our reference, read it without the lock */
+  const size_t offset= pos - chunk.start;
+  const uchar *event= chunk.buff->data() + offset;
+  if (chunk.len - offset < LOG_EVENT_MINIMAL_HEADER_LEN)
+  {
+    ++binlog_tail_cache_misses;
+    return false;
+  }
+  const ulong len= uint4korr(event + EVENT_LEN_OFFSET);
+  if (len < LOG_EVENT_MINIMAL_HEADER_LEN || len > chunk.len - offset ||
+      pos + len > end_pos ||
+      packet->append((const char*) event, len))
+  {
+    ++binlog_tail_cache_misses;
+    return false;
+  }
+  ++binlog_tail_cache_hits;
+  *event_len= len;
+  return true;
+}
+
 static
 int my_net_write_event(NET *net,
                        const LOG_POS_COORD *coord,
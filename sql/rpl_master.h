@@ -21,7 +21,9 @@
 #ifdef HAVE_REPLICATION
 
 #include <map>
+#include <memory>
 #include <set>
+#include <vector>
 
 extern bool server_id_supplied;
 extern int max_binlog_dump_events;
@@ -71,6 +73,12 @@ void end_slave_list();
 void init_compressed_event_cache();
 void clear_compressed_event_cache();
 void free_compressed_event_cache();
+void clear_binlog_tail_cache();
+void binlog_tail_cache_append(const char *log_file_name, my_off_t pos,
+                              std::shared_ptr<const std::vector<uchar>> buff);
+bool binlog_tail_cache_read(const char *log_file_name, my_off_t pos,
+                            my_off_t end_pos, String *packet,
+                            ulong *event_len);
 bool is_semi_sync_slave(THD *thd);
 int store_replica_stats(THD *thd, uchar *packet, uint packet_length);
 int get_current_replication_lag();
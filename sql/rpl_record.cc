@@ -397,11 +397,6 @@ unpack_row(Relay_log_info const *rli,
   DBUG_ENTER("unpack_row");
   DBUG_ASSERT(row_data);
   DBUG_ASSERT(table);
-  size_t const master_null_byte_count= (bitmap_bits_set(cols) + 7) / 8;
-  int error= 0;
-
-  uchar const *null_ptr= row_data;
-  uchar const *pack_ptr= row_data + master_null_byte_count;
 
   if (bitmap_is_clear_all(cols))
   {
@@ -409,23 +404,11 @@ unpack_row(Relay_log_info const *rli,
        There was no data sent from the master, so there is 
        nothing to unpack.    
      */
-    *current_row_end= pack_ptr;
+    *current_row_end= row_data;
     *master_reclength= 0;
-    DBUG_RETURN(error);
+    DBUG_RETURN(0);
   }
 
-
-  Field **const begin_ptr = table->field;
-  Field **field_ptr;
-  Field **const end_ptr= begin_ptr + colcnt;
-
-  DBUG_ASSERT(null_ptr < row_data + master_null_byte_count);
-
-  // Mask to mask out the correct bit among the null bits
-  unsigned int null_mask= 1U;
-  // The "current" null bits
-  unsigned int null_bits= *null_ptr++;
-  uint i= 0;
   table_def *tabledef= NULL;
   TABLE *conv_table= NULL;
   bool table_found= rli && rli->get_table_data(table, &tabledef, &conv_table);
@@ -442,6 +425,63 @@ unpack_row(Relay_log_info const *rli,
   if (rli && !table_found)
     DBUG_RETURN(HA_ERR_GENERIC);
 
+  DBUG_RETURN(unpack_row_with_table_def(tabledef, conv_table, table, colcnt,
+                                        row_data, cols, current_row_end,
+                                        master_reclength, row_end, row_query));
+}
+
+/**
+   Unpack a row into @c table->record[0] using the given table definition
+   and conversion table instead of looking them up in the relay log info.
+
+   This allows unpacking into a TABLE instance that is not part of
+   @c Relay_log_info::tables_to_lock, such as the private instance of the
+   row decoder (see rpl_row_decoder.cc). The parameters are the same as
+   for @c unpack_row().
+
+   @param tabledef   Table definition of the table on the master
+   @param conv_table Conversion table, or NULL if no conversion is needed
+
+   @retval 0 No error
+   @retval other A handler or server error code
+ */
+int
+unpack_row_with_table_def(table_def *tabledef, TABLE *conv_table,
+                          TABLE *table, uint const colcnt,
+                          uchar const *const row_data, MY_BITMAP const *cols,
+                          uchar const **const current_row_end,
+                          ulong *const master_reclength,
+                          uchar const *const row_end, std::string* row_query)
+{
+  DBUG_ENTER("unpack_row_with_table_def");
+  DBUG_ASSERT(row_data);
+  DBUG_ASSERT(table);
+  DBUG_ASSERT(tabledef);
+  size_t const master_null_byte_count= (bitmap_bits_set(cols) + 7) / 8;
+  int error= 0;
+
+  uchar const *null_ptr= row_data;
+  uchar const *pack_ptr= row_data + master_null_byte_count;
+
+  if (bitmap_is_clear_all(cols))
+  {
+    *current_row_end= pack_ptr;
+    *master_reclength= 0;
+    DBUG_RETURN(error);
+  }
+
+  Field **const begin_ptr = table->field;
+  Field **field_ptr;
+  Field **const end_ptr= begin_ptr + colcnt;
+
+  DBUG_ASSERT(null_ptr < row_data + master_null_byte_count);
+
+  // Mask to mask out the correct bit among the null bits
+  unsigned int null_mask= 1U;
+  // The "current" null bits
+  unsigned int null_bits= *null_ptr++;
+  uint i= 0;
+
   if (tabledef->use_column_names(table))
   {
     DBUG_RETURN(unpack_row_with_column_info(table, colcnt, row_data, cols,
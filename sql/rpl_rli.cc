@@ -28,6 +28,7 @@
 #include "sql_parse.h"                          // end_trans, ROLLBACK
 #include "rpl_slave.h"
 #include "rpl_rli_pdb.h"
+#include "rpl_row_decoder.h"
 #include "rpl_info_factory.h"
 #include <mysql/plugin.h>
 #include <mysql/service_thd_wait.h>
@@ -188,7 +189,6 @@ Relay_log_info::Relay_log_info(bool is_slave_recovery
   recovery_sid_map= new Sid_map(recovery_sid_lock);
 
   mysql_mutex_init(0, &dep_lock, MY_MUTEX_INIT_FAST);
-  mysql_mutex_init(0, &dep_key_lookup_mutex, MY_MUTEX_INIT_FAST);
   mysql_cond_init(0, &dep_full_cond, NULL);
   mysql_cond_init(0, &dep_empty_cond, NULL);
   mysql_cond_init(0, &dep_trx_all_done_cond, NULL);
@@ -261,13 +261,30 @@ Relay_log_info::~Relay_log_info()
   recovery_sid_map= NULL;
 
   mysql_mutex_destroy(&dep_lock);
-  mysql_mutex_destroy(&dep_key_lookup_mutex);
   mysql_cond_destroy(&dep_full_cond);
   mysql_cond_destroy(&dep_empty_cond);
 
+  delete rows_decoder;
+  rows_decoder= NULL;
+
   DBUG_VOID_RETURN;
 }
 
+Rows_decoder *Relay_log_info::get_rows_decoder()
+{
+  if (rows_decoder == NULL)
+  {
+    Rows_decoder *decoder= new Rows_decoder();
+    if (decoder->init())
+    {
+      delete decoder;
+      return NULL;
+    }
+    rows_decoder= decoder;
+  }
+  return rows_decoder;
+}
+
 /**
    Method is called when MTS coordinator senses the relay-log name
    has been changed.
@@ -1829,6 +1846,9 @@ void Relay_log_info::slave_close_thread_tables(THD *thd)
 {
   thd->get_stmt_da()->set_overwrite_status(true);
   DBUG_ENTER("Relay_log_info::slave_close_thread_tables(THD *thd)");
+  /* The decoder's table must not outlive the share of the table. */
+  if (rows_decoder)
+    rows_decoder->close_table();
   thd->is_error() ? trans_rollback_stmt(thd) : trans_commit_stmt(thd);
   thd->get_stmt_da()->set_overwrite_status(false);
 
@@ -36,6 +36,7 @@
 struct RPL_TABLE_LIST;
 class Master_info;
 class Commit_order_manager;
+class Rows_decoder;
 extern uint sql_slave_skip_counter;
 
 
@@ -1159,9 +1160,7 @@ public:
 
   /* Mapping from key to penultimate (for multi event trx)/end event of the
      last trx that updated that table */
-  std::unordered_map<Dependency_key, std::shared_ptr<Log_event_wrapper>>
-                                            dep_key_lookup;
-  mysql_mutex_t dep_key_lookup_mutex;
+  Dependency_key_lookup dep_key_lookup;
 
   /* Set of keys accessed by the group */
   std::unordered_set<Dependency_key> keys_accessed_by_group;
@@ -1185,6 +1184,8 @@ public:
   std::shared_ptr<Log_event_wrapper> current_begin_event;
   bool trx_queued= false;
   bool dep_sync_group= false;
+  /* Has the writeset of the current group been seen (WRITESET mode) */
+  bool curr_group_seen_writeset= false;
 
   // Used to signal when a dependency worker dies
   std::atomic<bool> dependency_worker_error{false};
@@ -1197,6 +1198,21 @@ public:
   std::atomic<ulonglong> begin_event_waits{0};
   std::atomic<ulonglong> next_event_waits{0};
   std::atomic<ulonglong> num_syncs{0};
+  // Throughput of the scheduling stages: keys extracted from rows events,
+  // events added to the dependency graph by the coordinator and events
+  // executed and finalized by the workers
+  std::atomic<ulonglong> dep_keys_extracted{0};
+  std::atomic<ulonglong> dep_events_scheduled{0};
+  std::atomic<ulonglong> dep_events_finalized{0};
+
+  /*
+    Decodes the rows of write events ahead of the thread applying events
+    for this Relay_log_info, see slave_decode_rows_ahead. Created on first
+    use by get_rows_decoder().
+  */
+  Rows_decoder *rows_decoder= nullptr;
+
+  Rows_decoder *get_rows_decoder();
 
 #ifndef DBUG_OFF
   std::mutex dep_fake_gap_lock;
@@ -1272,11 +1288,10 @@ public:
 
     dep_full= false;
 
-    mysql_mutex_lock(&dep_key_lookup_mutex);
     dep_key_lookup.clear();
-    mysql_mutex_unlock(&dep_key_lookup_mutex);
 
     trx_queued= false;
+    curr_group_seen_writeset= false;
     num_events_in_current_group= 0;
 
     tbl_mode_tables.clear();
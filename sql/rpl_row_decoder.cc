@@ -0,0 +1,355 @@
+#ifdef HAVE_REPLICATION
+
+#include "rpl_row_decoder.h"
+#include "sql_priv.h"
+#include "sql_class.h"
+#include "rpl_record.h"
+#include "rpl_utility.h"
+#include "table.h"
+#include "field.h"
+#include "mysqld.h"
+#include "log.h"
+
+static pthread_handler_t handle_rows_decoder(void *arg)
+{
+  Rows_decoder *decoder= static_cast<Rows_decoder*>(arg);
+
+  my_thread_init();
+  THD *thd= new THD;
+  THD_CHECK_SENTRY(thd);
+  thd->thread_stack= (char*) &thd;
+  thd->store_globals();
+
+  decoder->run(thd);
+
+  thd->release_resources();
+  delete thd;
+  my_thread_end();
+  pthread_exit(0);
+  return NULL;
+}
+
+Rows_decoder::Rows_decoder()
+  : m_thread_running(false), m_shutdown(false), m_job_pending(false),
+    m_job_running(false), m_cancel(false), m_decoded(0), m_consumed(0),
+    m_next(0), m_used(0), m_share(NULL), m_tabledef(NULL), m_colcnt(0),
+    m_cols(NULL), m_rows_begin(NULL), m_rows_end(NULL), m_time_zone(NULL),
+    m_table(NULL), m_table_share(NULL)
+{
+  mysql_mutex_init(0, &m_lock, MY_MUTEX_INIT_FAST);
+  mysql_cond_init(0, &m_cond, NULL);
+}
+
+Rows_decoder::~Rows_decoder()
+{
+  mysql_mutex_lock(&m_lock);
+  DBUG_ASSERT(!m_job_running);
+  m_shutdown= true;
+  mysql_cond_broadcast(&m_cond);
+  while (m_thread_running)
+    mysql_cond_wait(&m_cond, &m_lock);
+  mysql_mutex_unlock(&m_lock);
+
+  close_table();
+  my_free(m_table);
+
+  mysql_cond_destroy(&m_cond);
+  mysql_mutex_destroy(&m_lock);
+}
+
+bool Rows_decoder::init()
+{
+  DBUG_ENTER("Rows_decoder::init");
+  pthread_t th;
+  int error;
+
+  m_thread_running= true;
+  if ((error= mysql_thread_create(0, /* Not instrumented */
+                                  &th, &connection_attrib,
+                                  handle_rows_decoder, this)))
+  {
+    sql_print_warning("Can't create the row decoder thread (errno= %d)",
+                      error);
+    m_thread_running= false;
+    DBUG_RETURN(true);
+  }
+  DBUG_RETURN(false);
+}
+
+bool Rows_decoder::can_decode(TABLE *table, table_def *tabledef,
+                              TABLE *conv_table, MY_BITMAP const *cols,
+                              uint colcnt, const uchar *rows_begin,
+                              const uchar *rows_end)
+{
+  if (conv_table != NULL || table->s->tmp_table != NO_TMP_TABLE ||
+      tabledef->use_column_names(table))
+    return false;
+  /*
+    Rows are packed, so this is a lower bound of the number of rows for
+    all but the tables with large blobs.
+  */
+  if ((size_t) (rows_end - rows_begin) < MIN_ROWS * table->s->reclength)
+    return false;
+#ifdef WITH_PARTITION_STORAGE_ENGINE
+  if (table->part_info != NULL)
+    return false;
+#endif
+  /*
+    The decoded record starts from the default values, so every column
+    must be in the event for the record to be complete.
+  */
+  if (colcnt < table->s->fields || cols->n_bits < table->s->fields)
+    return false;
+  for (uint i= 0; i < table->s->fields; i++)
+  {
+    if (!bitmap_is_set(cols, i))
+      return false;
+  }
+  return true;
+}
+
+void Rows_decoder::start(THD *thd, TABLE *table, table_def *tabledef,
+                         uint colcnt, MY_BITMAP const *cols,
+                         const uchar *rows_begin, const uchar *rows_end)
+{
+  DBUG_ENTER("Rows_decoder::start");
+  mysql_mutex_lock(&m_lock);
+  DBUG_ASSERT(!m_job_running);
+  m_share= table->s;
+  m_tabledef= tabledef;
+  m_colcnt= colcnt;
+  m_cols= cols;
+  m_rows_begin= rows_begin;
+  m_rows_end= rows_end;
+  m_time_zone= thd->variables.time_zone;
+  m_decoded= m_consumed= m_next= m_used= 0;
+  m_cancel= false;
+  m_job_pending= true;
+  m_job_running= true;
+  mysql_cond_broadcast(&m_cond);
+  mysql_mutex_unlock(&m_lock);
+  DBUG_VOID_RETURN;
+}
+
+bool Rows_decoder::next_row(TABLE *table, const uchar *row,
+                            const uchar **row_end, ulong *master_reclength,
+                            std::string *row_query)
+{
+  bool found= false;
+
+  mysql_mutex_lock(&m_lock);
+  /*
+    The applier is done with the rows it asked for before, their slots
+    can be reused.
+  */
+  m_consumed= m_next;
+  mysql_cond_broadcast(&m_cond);
+
+  while (m_next >= m_decoded && m_job_running)
+    mysql_cond_wait(&m_cond, &m_lock);
+
+  /* Skip the rows that the applier unpacked itself. */
+  while (m_next < m_decoded && m_slots[m_next % NUM_SLOTS].row < row)
+    m_next++;
+
+  if (m_next < m_decoded && m_slots[m_next % NUM_SLOTS].row == row)
+  {
+    Slot *slot= &m_slots[m_next % NUM_SLOTS];
+    memcpy(table->record[0], &slot->record[0], table->s->reclength);
+    for (uint i= 0; i < table->s->blob_fields; i++)
+      bitmap_set_bit(table->write_set, table->s->blob_field[i]);
+    *row_end= slot->row_end;
+    *master_reclength= slot->master_reclength;
+    if (row_query)
+      row_query->append(slot->row_query);
+    /* The slot is released by the next call. */
+    m_next++;
+    m_used++;
+    found= true;
+  }
+  else
+  {
+    m_consumed= m_next;
+    mysql_cond_broadcast(&m_cond);
+  }
+  mysql_mutex_unlock(&m_lock);
+  return found;
+}
+
+void Rows_decoder::finish()
+{
+  DBUG_ENTER("Rows_decoder::finish");
+  mysql_mutex_lock(&m_lock);
+  m_cancel= true;
+  if (m_job_pending)
+  {
+    m_job_pending= false;
+    m_job_running= false;
+  }
+  mysql_cond_broadcast(&m_cond);
+  while (m_job_running)
+    mysql_cond_wait(&m_cond, &m_lock);
+  statistic_add(slave_rows_decoded_ahead, m_used, &LOCK_status);
+  m_share= NULL;
+  m_tabledef= NULL;
+  m_cols= NULL;
+  m_rows_begin= m_rows_end= NULL;
+  mysql_mutex_unlock(&m_lock);
+  DBUG_VOID_RETURN;
+}
+
+void Rows_decoder::close_table()
+{
+  DBUG_ENTER("Rows_decoder::close_table");
+  DBUG_ASSERT(!m_job_running);
+  if (m_table_share != NULL)
+  {
+    closefrm(m_table, false);
+    m_table_share= NULL;
+  }
+  DBUG_VOID_RETURN;
+}
+
+void Rows_decoder::run(THD *thd)
+{
+  mysql_mutex_lock(&m_lock);
+  while (!m_shutdown)
+  {
+    if (!m_job_pending)
+    {
+      mysql_cond_wait(&m_cond, &m_lock);
+      continue;
+    }
+    m_job_pending= false;
+    mysql_mutex_unlock(&m_lock);
+
+    decode(thd);
+
+    mysql_mutex_lock(&m_lock);
+    m_job_running= false;
+    mysql_cond_broadcast(&m_cond);
+  }
+  m_thread_running= false;
+  mysql_cond_broadcast(&m_cond);
+  mysql_mutex_unlock(&m_lock);
+}
+
+/**
+  Copies table->record[0] into the slot. The blob fields of the record
+  point into buffers of the decoder's table that are overwritten by the
+  next row, so their data is copied into the slot as well.
+*/
+void Rows_decoder::save_row(TABLE *table, Slot *slot)
+{
+  TABLE_SHARE *share= table->s;
+  size_t blobs_length= 0;
+
+  slot->record.assign(table->record[0], table->record[0] + share->reclength);
+
+  for (uint i= 0; i < share->blob_fields; i++)
+  {
+    Field_blob *blob= (Field_blob*) table->field[share->blob_field[i]];
+    if (!blob->is_null())
+      blobs_length+= blob->get_length();
+  }
+  slot->blobs.resize(blobs_length);
+
+  uchar *to= slot->blobs.empty() ? NULL : &slot->blobs[0];
+  const my_ptrdiff_t diff= &slot->record[0] - table->record[0];
+  for (uint i= 0; i < share->blob_fields; i++)
+  {
+    Field_blob *blob= (Field_blob*) table->field[share->blob_field[i]];
+    if (blob->is_null())
+      continue;
+    uint32 length= blob->get_length();
+    uchar *data;
+    blob->get_ptr(&data);
+    if (length)
+      memcpy(to, data, length);
+    blob->set_ptr_offset(diff, length, to);
+    to+= length;
+  }
+}
+
+void Rows_decoder::decode(THD *thd)
+{
+  DBUG_ENTER("Rows_decoder::decode");
+  const uchar *row= m_rows_begin;
+  ulong n= 0;
+
+  thd->variables.time_zone= m_time_zone;
+  /*
+    The applier has kept the share of the cached table open since the
+    table was opened, see close_table().
+  */
+  if (m_table_share != m_share)
+  {
+    if (m_table_share != NULL)
+    {
+      closefrm(m_table, false);
+      m_table_share= NULL;
+    }
+    if (m_table == NULL &&
+        !(m_table= (TABLE*) my_malloc(sizeof(TABLE), MYF(MY_WME))))
+      DBUG_VOID_RETURN;
+    if (open_table_from_share(thd, m_share, "", 0, (uint) READ_ALL, 0,
+                              m_table, FALSE))
+    {
+      thd->clear_error();
+      DBUG_VOID_RETURN;
+    }
+    m_table_share= m_share;
+  }
+  TABLE &table= *m_table;
+  bitmap_set_all(table.read_set);
+  bitmap_set_all(table.write_set);
+
+  while (row < m_rows_end)
+  {
+    Slot *slot= &m_slots[n % NUM_SLOTS];
+
+    mysql_mutex_lock(&m_lock);
+    while (!m_cancel && n >= m_consumed + NUM_SLOTS)
+      mysql_cond_wait(&m_cond, &m_lock);
+    const bool cancel= m_cancel;
+    mysql_mutex_unlock(&m_lock);
+    if (cancel)
+      break;
+
+    const uchar *row_end= NULL;
+    ulong master_reclength= 0;
+    slot->row_query.clear();
+    restore_record(&table, s->default_values);
+    /*
+      Errors and warnings are left to the applier, which unpacks the
+      row itself when it is not found in a slot.
+    */
+    if (unpack_row_with_table_def(m_tabledef, NULL, &table, m_colcnt, row,
+                                  m_cols, &row_end, &master_reclength,
+                                  m_rows_end, &slot->row_query) ||
+        thd->is_error() ||
+        thd->get_stmt_da()->current_statement_warn_count() > 0 ||
+        row_end == NULL || row_end <= row)
+    {
+      thd->clear_error();
+      thd->get_stmt_da()->clear_warning_info(thd->query_id);
+      break;
+    }
+
+    slot->row= row;
+    slot->row_end= row_end;
+    slot->master_reclength= master_reclength;
+    save_row(&table, slot);
+
+    mysql_mutex_lock(&m_lock);
+    m_decoded= ++n;
+    mysql_cond_broadcast(&m_cond);
+    mysql_mutex_unlock(&m_lock);
+
+    row= row_end;
+  }
+
+  DBUG_VOID_RETURN;
+}
+
+#endif // HAVE_REPLICATION
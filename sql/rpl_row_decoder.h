@@ -0,0 +1,154 @@
+#ifndef RPL_ROW_DECODER_H
+#define RPL_ROW_DECODER_H
+
+#ifdef HAVE_REPLICATION
+
+#include "my_global.h"
+#include "my_pthread.h"
+#include "mysql/psi/mysql_thread.h"
+#include <string>
+#include <vector>
+
+class THD;
+class Time_zone;
+class table_def;
+struct TABLE;
+struct TABLE_SHARE;
+typedef struct st_bitmap MY_BITMAP;
+
+/**
+  Decodes the row images of a rows event into record buffers on a
+  separate thread, ahead of the applier consuming them.
+
+  The applier hands the rows of a write event to the decoder with
+  start() and asks for each row with next_row(), which copies the
+  decoded record into table->record[0] instead of unpacking it. The
+  decoder keeps at most NUM_SLOTS rows ahead of the applier. If a row
+  is not available from the decoder, because decoding failed or raised
+  a warning, next_row() returns false and the applier unpacks the row
+  itself, so that errors are reported exactly as without the decoder.
+
+  The decoder unpacks into its own TABLE, opened from the share of the
+  applier's table. It is kept for the following events on the same
+  table until the applier closes its tables and calls close_table().
+
+  Each Relay_log_info owns at most one decoder, which is only used by
+  the thread applying events for it.
+*/
+class Rows_decoder
+{
+public:
+  Rows_decoder();
+  ~Rows_decoder();
+
+  /**
+    Creates the decoder thread.
+
+    @retval false success
+    @retval true  the thread could not be created
+  */
+  bool init();
+
+  /**
+    Whether the rows of an event for the table should be decoded ahead.
+    Partitioned tables, tables that need a conversion table, events that
+    do not contain every column of the table by position and events that
+    are unlikely to hold more than a few rows are left to the applier.
+  */
+  static bool can_decode(TABLE *table, table_def *tabledef,
+                         TABLE *conv_table, MY_BITMAP const *cols,
+                         uint colcnt, const uchar *rows_begin,
+                         const uchar *rows_end);
+
+  /**
+    Starts decoding the rows in [rows_begin, rows_end). The table, the
+    table definition and the event must stay valid until finish().
+  */
+  void start(THD *thd, TABLE *table, table_def *tabledef, uint colcnt,
+             MY_BITMAP const *cols, const uchar *rows_begin,
+             const uchar *rows_end);
+
+  /**
+    Copies the decoded image of the row starting at row into
+    table->record[0].
+
+    @retval true  the row was decoded, row_end, master_reclength and
+                  row_query are set as by unpack_row()
+    @retval false the row must be unpacked by the caller
+  */
+  bool next_row(TABLE *table, const uchar *row, const uchar **row_end,
+                ulong *master_reclength, std::string *row_query);
+
+  /** Stops decoding the current event and waits for the decoder. */
+  void finish();
+
+  /**
+    Closes the decoder's TABLE. Must be called before the applier closes
+    the table it was opened for, which keeps the share in use.
+  */
+  void close_table();
+
+  void run(THD *thd);
+
+private:
+  static const uint NUM_SLOTS= 64;
+  /**
+    Events shorter than this many records are not decoded ahead, handing
+    them to the decoder costs more than unpacking them.
+  */
+  static const uint MIN_ROWS= 32;
+
+  struct Slot
+  {
+    const uchar *row;
+    const uchar *row_end;
+    ulong master_reclength;
+    std::vector<uchar> record;
+    std::vector<uchar> blobs;
+    std::string row_query;
+  };
+
+  void decode(THD *thd);
+  void save_row(TABLE *table, Slot *slot);
+
+  mysql_mutex_t m_lock;
+  mysql_cond_t m_cond;
+
+  /* Protected by m_lock. */
+  bool m_thread_running;
+  bool m_shutdown;
+  bool m_job_pending;
+  bool m_job_running;
+  bool m_cancel;
+  /** Number of rows of the current event that were decoded. */
+  ulong m_decoded;
+  /** Number of rows whose slots the applier no longer uses. */
+  ulong m_consumed;
+  /** Number of rows handed out to the applier. */
+  ulong m_next;
+  /** Number of rows of the current event the applier did not unpack. */
+  ulong m_used;
+
+  /* The current event, set by start(). */
+  TABLE_SHARE *m_share;
+  table_def *m_tabledef;
+  uint m_colcnt;
+  MY_BITMAP const *m_cols;
+  const uchar *m_rows_begin;
+  const uchar *m_rows_end;
+  Time_zone *m_time_zone;
+
+  /*
+    The decoder's table and the share it was opened from, NULL if none.
+    Used by the decoder thread while it decodes an event, closed by
+    close_table() between events.
+  */
+  TABLE *m_table;
+  TABLE_SHARE *m_table_share;
+
+  Slot m_slots[NUM_SLOTS];
+};
+
+#endif // HAVE_REPLICATION
+
+#endif // RPL_ROW_DECODER_H
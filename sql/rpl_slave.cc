@@ -3695,6 +3695,12 @@ bool show_slave_status(THD* thd, Master_info* mi)
                                              sizeof(mi->ssl_master_issuer) : 0));
   field_list.push_back(
       new Item_empty_string("Slave_Lag_Stats_Thread_Running", 3));
+  field_list.push_back(new Item_return_int("Dependency_Keys_Extracted", 20,
+                                           MYSQL_TYPE_LONGLONG));
+  field_list.push_back(new Item_return_int("Dependency_Events_Scheduled", 20,
+                                           MYSQL_TYPE_LONGLONG));
+  field_list.push_back(new Item_return_int("Dependency_Events_Finalized", 20,
+                                           MYSQL_TYPE_LONGLONG));
 
   if (protocol->send_result_set_metadata(&field_list,
                             Protocol::SEND_NUM_ROWS | Protocol::SEND_EOF))
@@ -3922,6 +3928,19 @@ bool show_slave_status(THD* thd, Master_info* mi)
     // slave lag stats daemon running status
     protocol->store(slave_stats_daemon_thread_counter > 0 ? "Yes" : "No",
                     &my_charset_bin);
+    // Dependency slave applier scheduling stages
+    if (mi->rli->mts_dependency_replication)
+    {
+      protocol->store((ulonglong) mi->rli->dep_keys_extracted.load());
+      protocol->store((ulonglong) mi->rli->dep_events_scheduled.load());
+      protocol->store((ulonglong) mi->rli->dep_events_finalized.load());
+    }
+    else
+    {
+      protocol->store_null();
+      protocol->store_null();
+      protocol->store_null();
+    }
     protocol->update_checksum();
 
     mysql_mutex_unlock(&mi->rli->err_lock);
@@ -142,6 +142,7 @@ enum enum_mts_dependency_replication {
   DEP_RPL_NONE,
   DEP_RPL_TABLE,
   DEP_RPL_STATEMENT,
+  DEP_RPL_WRITESET,
 };
 
 enum enum_mts_dependency_order_commits {
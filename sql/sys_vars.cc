@@ -1114,6 +1114,18 @@ static Sys_var_mybool Sys_binlog_trx_meta_data(
        GLOBAL_VAR(opt_binlog_trx_meta_data),
        CMD_LINE(OPT_ARG), DEFAULT(FALSE));
 
+static Sys_var_mybool Sys_binlog_trx_writeset(
+       "binlog_trx_writeset",
+       "Log the hashes of the primary and unique keys of the rows written by "
+       "every transaction in a Metadata event before the end of the "
+       "transaction. Replicas with mts_dependency_replication=WRITESET apply "
+       "transactions whose keys do not conflict in parallel. Multi-threaded "
+       "replicas of older versions assign the event to a new group, so all "
+       "the replicas using slave_parallel_workers must be upgraded before "
+       "this is enabled.",
+       GLOBAL_VAR(opt_binlog_trx_writeset),
+       CMD_LINE(OPT_ARG), DEFAULT(FALSE));
+
 static Sys_var_mybool Sys_log_column_names(
        "log_column_names",
        "Writes column name information in table map log events.",
@@ -1126,6 +1138,24 @@ static Sys_var_mybool Sys_binlog_order_commits(
        GLOBAL_VAR(opt_binlog_order_commits),
        CMD_LINE(OPT_ARG), DEFAULT(TRUE));
 
+static Sys_var_mybool Sys_binlog_pipelined_sync(
+       "binlog_pipelined_sync",
+       "Sync the binary log in a separate stage of the group commit, so "
+       "that the next group can be written to the binary log while the "
+       "current group is being synced.",
+       READ_ONLY GLOBAL_VAR(opt_binlog_pipelined_sync),
+       CMD_LINE(OPT_ARG), DEFAULT(FALSE));
+
+static Sys_var_ulong Sys_binlog_sync_latency_target_usec(
+       "binlog_sync_latency_target_usec",
+       "With binlog_pipelined_sync, the commit latency in microseconds to "
+       "aim for when syncing the binary log. The group commit waits for "
+       "more transactions before the sync for up to the measured fsync "
+       "time, within this target. 0 means no wait.",
+       GLOBAL_VAR(opt_binlog_sync_latency_target_usec),
+       CMD_LINE(REQUIRED_ARG), VALID_RANGE(0, 1000000), DEFAULT(0),
+       BLOCK_SIZE(1));
+
 #ifdef HAVE_REPLICATION
 static Sys_var_mybool Sys_reset_seconds_behind_master(
        "reset_seconds_behind_master",
@@ -3456,6 +3486,26 @@ static Sys_var_ulonglong Sys_compressed_event_cache_evict_threshold(
        CMD_LINE(OPT_ARG), VALID_RANGE(0, 100), DEFAULT(60),
        BLOCK_SIZE(1), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0), ON_UPDATE(0));
 
+static bool fix_binlog_tail_cache_size(sys_var *self, THD *thd,
+                                       enum_var_type type)
+{
+#ifdef HAVE_REPLICATION
+  if (opt_binlog_tail_cache_size == 0)
+    clear_binlog_tail_cache();
+#endif
+  return false;
+}
+
+static Sys_var_ulonglong Sys_binlog_tail_cache_size(
+       "binlog_tail_cache_size",
+       "Size in MB of the in-memory cache of the most recently flushed "
+       "binlog events. Dump threads read events in the cache from memory "
+       "instead of the binlog file. 0 disables the cache.",
+       GLOBAL_VAR(opt_binlog_tail_cache_size), CMD_LINE(OPT_ARG),
+       VALID_RANGE(0, 1000000), DEFAULT(0),
+       BLOCK_SIZE(1), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
+       ON_UPDATE(fix_binlog_tail_cache_size));
+
 static Sys_var_ulonglong Sys_slave_dump_thread_wait_sleep_usec(
        "slave_dump_thread_wait_sleep_usec",
        "Time (in microsecs) to sleep on the master's dump thread before "
@@ -3532,6 +3582,13 @@ static Sys_var_enum Slave_run_triggers_for_rbr(
        slave_run_triggers_for_rbr_names,
        DEFAULT(SLAVE_RUN_TRIGGERS_FOR_RBR_NO));
 
+static Sys_var_mybool Sys_slave_decode_rows_ahead(
+       "slave_decode_rows_ahead",
+       "Decode the rows of row-based write events on a separate thread of "
+       "each slave applier, ahead of the rows being written.",
+       GLOBAL_VAR(opt_slave_decode_rows_ahead), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
 static Sys_var_mybool sql_log_bin_triggers(
        "sql_log_bin_triggers",
        "The row changes generated by execution of triggers are not logged in"
@@ -5569,7 +5626,8 @@ static Sys_var_double Sys_mts_imbalance_threshold(
        GLOBAL_VAR(opt_mts_imbalance_threshold),
        CMD_LINE(OPT_ARG), VALID_RANGE(0, 100), DEFAULT(90));
 
-static const char *dep_rpl_type_names[]= { "NONE", "TBL", "STMT", NullS };
+static const char *dep_rpl_type_names[]=
+  { "NONE", "TBL", "STMT", "WRITESET", NullS };
 static const char *commit_order_type_names[]= { "NONE", "DB", "GLOBAL", NullS };
 
 static Sys_var_enum Sys_mts_dependency_replication(
@@ -373,6 +373,7 @@ TABLE_SHARE *alloc_table_share(TABLE_LIST *table_list, const char *key,
     */
     share->table_map_id= ~0ULL;
     share->cached_row_logging_check= -1;
+    share->cached_writeset_check= -1;
 
     share->m_flush_tickets.empty();
 
@@ -434,6 +435,7 @@ void init_tmp_table_share(THD *thd, TABLE_SHARE *share, const char *key,
   share->frm_version= 		 FRM_VER_TRUE_VARCHAR;
 
   share->cached_row_logging_check= -1;
+  share->cached_writeset_check= -1;
 
   /*
     table_map_id is also used for MERGE tables to suppress repeated
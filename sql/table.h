@@ -816,6 +816,14 @@ struct TABLE_SHARE
   */
   int cached_row_logging_check;
 
+  /*
+    Cache for the table checks of binlog_trx_writeset, see
+    binlog_cache_data::writeset_supports_table(). Possible values are:
+    -1 when cache value is not calculated yet, 0 when the writeset
+    *can't* describe the rows of the table, 1 when it *may*.
+  */
+  int cached_writeset_check;
+
   /*
     Storage media to use for this table (unless another storage
     media has been specified on an individual column - in versions
@@ -1569,6 +1569,11 @@ buf_pool_init_instance(
 		buf_pool->n_flushed[i] = 0;
 	}
 
+	latency_histogram_init(&buf_pool->flush_list_histogram,
+			       innobase_histogram_step_size_flush_batch);
+	latency_histogram_init(&buf_pool->lru_flush_histogram,
+			       innobase_histogram_step_size_flush_batch);
+
 	buf_pool->watch = (buf_page_t*) mem_zalloc(
 		sizeof(*buf_pool->watch) * BUF_POOL_WATCH_SIZE);
 
@@ -1642,6 +1647,47 @@ buf_pool_free_instance(
 	hash_table_free(buf_pool->zip_hash);
 }
 
+/********************************************************************//**
+Registers the memory of all the buffer pool chunks for fixed buffer
+i/o, see os_aio_register_buffers(). */
+static
+void
+buf_pool_register_io_buffers(void)
+/*==============================*/
+{
+	ulint	n_chunks = 0;
+
+	if (!srv_use_io_uring) {
+		return;
+	}
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		n_chunks += buf_pool_from_array(i)->n_chunks;
+	}
+
+	void**	bufs = static_cast<void**>(
+		ut_malloc(n_chunks * sizeof(*bufs)));
+	ulint*	lens = static_cast<ulint*>(
+		ut_malloc(n_chunks * sizeof(*lens)));
+	ulint	n = 0;
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		buf_pool_t*	buf_pool = buf_pool_from_array(i);
+		buf_chunk_t*	chunk = buf_pool->chunks;
+
+		for (ulint j = 0; j < buf_pool->n_chunks; j++, chunk++) {
+			bufs[n] = chunk->mem;
+			lens[n] = chunk->mem_size;
+			n++;
+		}
+	}
+
+	os_aio_register_buffers(bufs, lens, n);
+
+	ut_free(bufs);
+	ut_free(lens);
+}
+
 /********************************************************************//**
 Creates the buffer pool.
 @return	DB_SUCCESS if success, DB_ERROR if not enough memory or error */
@@ -1717,6 +1763,8 @@ buf_pool_init(
 
 	buf_lru_event = os_event_create();
 
+	buf_pool_register_io_buffers();
+
 	return(DB_SUCCESS);
 }
 
@@ -2464,12 +2512,14 @@ buf_pool_resize()
 
 	buf_resize_status("Disabling adaptive hash index.");
 
-	rw_lock_s_lock(&btr_search_latch);
+	/* Any one of the partition latches protects btr_search_enabled
+	for reading */
+	rw_lock_s_lock(&btr_search_latch_arr[0]);
 	if (btr_search_enabled) {
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(&btr_search_latch_arr[0]);
 		btr_search_disabled = true;
 	} else {
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(&btr_search_latch_arr[0]);
 	}
 
 	btr_search_disable();
@@ -2786,6 +2836,11 @@ wait_lock_empty:
 	ib_logf(IB_LOG_LEVEL_INFO,
 		"Confirmed no IO requests.");
 
+	/* The chunks are about to be allocated and freed. A new chunk
+	could reuse the address of a freed one, so the registration of
+	the old chunks must be gone first. */
+	os_aio_unregister_buffers();
+
 	ut_d(buf_pool_forbidden = true);
 
 	buf_resize_status("Latching whole of buffer pool.");
@@ -3042,6 +3097,8 @@ wait_lock_empty:
 	/* normalize ibuf->max_size */
 	ibuf_max_size_update(srv_change_buffer_max_size);
 
+	buf_pool_register_io_buffers();
+
 skip_resize:
 	/* wake all other threads up */
 	buf_pool_resizing_bg = false;
@@ -3164,7 +3221,7 @@ buf_pool_clear_hash_index(void)
 	ulint	p;
 
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(rw_lock_own(&btr_search_latch, RW_LOCK_EX));
+	ut_ad(btr_search_own_all_x());
 #endif /* UNIV_SYNC_DEBUG */
 	ut_ad(!buf_pool_forbidden);
 	ut_ad(!btr_search_enabled);
@@ -3182,7 +3239,8 @@ buf_pool_clear_hash_index(void)
 				dict_index_t*	index	= block->index;
 
 				/* We can set block->index = NULL
-				when we have an x-latch on btr_search_latch;
+				when we have x-latches on all of
+				btr_search_latch_arr;
 				see the comment in buf0buf.h */
 
 				if (!index) {
@@ -5080,7 +5138,7 @@ buf_page_get_known_nowait(
 /*******************************************************************//**
 Given a tablespace id and page number tries to get that page. If the
 page is not in the buffer pool it is not loaded and NULL is returned.
-Suitable for using when holding the lock_sys_t::mutex.
+Suitable for using when holding the lock_sys_t::latch.
 @return	pointer to a page or NULL */
 UNIV_INTERN
 const buf_block_t*
@@ -5183,6 +5241,7 @@ buf_page_init_low(
 	bpage->last_access_time = 0;
 	bpage->newest_modification = 0;
 	bpage->oldest_modification = 0;
+	bpage->page_image_logged = FALSE;
 	bpage->db_stats_index = 0;
 	HASH_INVALIDATE(bpage, hash);
 #if defined UNIV_DEBUG_FILE_ACCESSES || defined UNIV_DEBUG
@@ -5955,8 +6014,13 @@ buf_page_io_complete(
 		/* From version 3.23.38 up we store the page checksum
 		to the 4 first bytes of the page end lsn field */
 
+		/* A torn write of a page that bypassed the doublewrite
+		buffer is repaired by a page image in the redo log. */
+
 		if (buf_page_is_corrupted(true, frame,
-					  buf_page_get_zip_size(bpage))) {
+					  buf_page_get_zip_size(bpage))
+		    && !(recv_recovery_is_on()
+			 && recv_page_torn(bpage->space, bpage->offset))) {
 
 			/* Not a real corruption if it was triggered by
 			error injection */
@@ -7225,6 +7289,21 @@ buf_print_io_instance(
 		pool_info->unzip_sum, pool_info->unzip_cur);
 }
 
+/*********************************************************************//**
+Prints the flush batch latency histograms of a buffer pool instance. */
+static
+void
+buf_print_flush_histograms(
+/*=======================*/
+	buf_pool_t*	buf_pool,	/*!< in: buffer pool instance */
+	FILE*		file)		/*!< in/out: buffer where to print */
+{
+	fputs("Flush list batch latency\n", file);
+	os_aio_print_histogram(file, &buf_pool->flush_list_histogram);
+	fputs("LRU flush batch latency\n", file);
+	os_aio_print_histogram(file, &buf_pool->lru_flush_histogram);
+}
+
 /*********************************************************************//**
 Prints info of the buffer i/o. */
 UNIV_INTERN
@@ -7283,7 +7362,11 @@ buf_print_io(
 		for (i = 0; i < srv_buf_pool_instances; i++) {
 			fprintf(file, "---BUFFER POOL %lu\n", i);
 			buf_print_io_instance(&pool_info[i], file);
+			buf_print_flush_histograms(buf_pool_from_array(i),
+						   file);
 		}
+	} else {
+		buf_print_flush_histograms(buf_pool_from_array(0), file);
 	}
 
 	mem_free(pool_info);
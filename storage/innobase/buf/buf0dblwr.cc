@@ -79,6 +79,47 @@ buf_dblwr_page_inside(
 	return(FALSE);
 }
 
+/********************************************************************//**
+Determines if a torn write of a page is to be repaired from a full image
+of the page logged when it is made dirty, rather than from the doublewrite
+buffer. This depends on innodb_log_page_images and on the page: the
+first page of a tablespace and the trx system page are read before the
+redo log is applied, and compressed pages are not covered.
+@return true if an image of the page should be logged */
+UNIV_INTERN
+bool
+buf_dblwr_use_page_image(
+/*=====================*/
+	const buf_block_t*	block)	/*!< in: block being made dirty */
+{
+	ulint	space = buf_block_get_space(block);
+	ulint	page_no = buf_block_get_page_no(block);
+
+	switch (srv_log_page_images) {
+	case SRV_LOG_PAGE_IMAGES_NONE:
+		return(false);
+	case SRV_LOG_PAGE_IMAGES_FILE_PER_TABLE:
+		if (space <= srv_undo_tablespaces_open) {
+			/* The system and undo tablespaces */
+			return(false);
+		}
+		break;
+	}
+
+	if (page_no == 0 || buf_block_get_page_zip(block) != NULL) {
+		return(false);
+	}
+
+	if (space == TRX_SYS_SPACE
+	    && (buf_dblwr == NULL
+		|| page_no == TRX_SYS_PAGE_NO
+		|| buf_dblwr_page_inside(page_no))) {
+		return(false);
+	}
+
+	return(true);
+}
+
 /****************************************************************//**
 Calls buf_page_get() on the TRX_SYS_PAGE and returns a pointer to the
 doublewrite buffer within it.
@@ -996,6 +1037,10 @@ try_again:
 
 		mutex_exit(&buf_dblwr->mutex);
 
+		/* The batch may have consisted of pages whose image
+		was logged, which bypass the doublewrite buffer. */
+		os_aio_simulated_wake_handler_threads();
+
 		return;
 	}
 
@@ -63,9 +63,69 @@ UNIV_INTERN ibool buf_lru_manager_is_active = FALSE;
 
 #ifdef UNIV_PFS_THREAD
 UNIV_INTERN mysql_pfs_key_t buf_page_cleaner_thread_key;
+UNIV_INTERN mysql_pfs_key_t buf_page_cleaner_worker_thread_key;
 UNIV_INTERN mysql_pfs_key_t buf_lru_manager_thread_key;
 #endif /* UNIV_PFS_THREAD */
 
+/** State of the flush batch requested for one buffer pool instance */
+enum page_cleaner_state_t {
+	PAGE_CLEANER_STATE_NONE = 0,	/*!< no batch requested */
+	PAGE_CLEANER_STATE_REQUESTED,	/*!< waiting for a thread to
+					pick it up */
+	PAGE_CLEANER_STATE_FLUSHING,	/*!< a thread is running it */
+	PAGE_CLEANER_STATE_FINISHED	/*!< done, results are valid */
+};
+
+/** A flush batch requested for one buffer pool instance */
+struct page_cleaner_slot_t {
+	page_cleaner_state_t	state;	/*!< state of the batch */
+	ulint			min_n;	/*!< wished minimum number of
+					blocks to flush */
+	lsn_t			lsn_limit;
+					/*!< upper limit of LSN to be
+					flushed, flush list batches only */
+	ulint			n_processed;
+					/*!< number of pages flushed or
+					evicted by the batch */
+	bool			success;/*!< false if another batch of
+					the same type was already running
+					in the instance */
+};
+
+/** Pool of page cleaner threads which run the flush list and LRU
+batches of the buffer pool instances in parallel. The page_cleaner
+and lru_manager threads request one batch per instance and take part
+in running them; the page cleaner workers pick up the rest. At most
+one batch of each type is requested at a time. */
+struct page_cleaner_t {
+	os_fast_mutex_t		mutex;	/*!< protects the fields below
+					and the slot states */
+	os_event_t		is_requested;
+					/*!< signalled when a new batch
+					is requested */
+	os_event_t		is_finished[BUF_FLUSH_N_TYPES];
+					/*!< set when all the instances
+					of the batch of the given type
+					are finished */
+	page_cleaner_slot_t*	slots[BUF_FLUSH_N_TYPES];
+					/*!< per instance batches, for
+					BUF_FLUSH_LRU and BUF_FLUSH_LIST
+					only */
+	ulint			n_requested[BUF_FLUSH_N_TYPES];
+					/*!< number of slots waiting for
+					a thread */
+	ulint			n_finished[BUF_FLUSH_N_TYPES];
+					/*!< number of finished slots */
+	ulint			n_workers;
+					/*!< number of running workers */
+	bool			is_running;
+					/*!< false when the workers
+					should exit */
+};
+
+/** The page cleaner pool, NULL unless innodb_page_cleaners > 1 */
+static page_cleaner_t*	page_cleaner = NULL;
+
 /** Event to synchronise with the flushing. */
  os_event_t	buf_lru_event;
 
@@ -571,6 +631,7 @@ buf_flush_remove(
 	buf_pool->stat.flush_list_bytes -= zip_size ? zip_size : UNIV_PAGE_SIZE;
 
 	bpage->oldest_modification = 0;
+	bpage->page_image_logged = FALSE;
 
 #if defined UNIV_DEBUG || defined UNIV_BUF_DEBUG
 	ut_a(buf_flush_validate_skip(buf_pool));
@@ -934,7 +995,10 @@ buf_flush_write_block_low(
 		break;
 	}
 
-	if (!srv_use_doublewrite_buf || !buf_dblwr) {
+	/* A page whose full image was logged when it was made dirty
+	can be repaired from the redo log if this write is torn. */
+	if (!srv_use_doublewrite_buf || !buf_dblwr
+	    || bpage->page_image_logged) {
 		fil_io(OS_FILE_WRITE | OS_AIO_SIMULATED_WAKE_LATER,
 		       sync, buf_page_get_space(bpage), zip_size,
 		       buf_page_get_page_no(bpage), 0,
@@ -1875,6 +1939,62 @@ buf_flush_do_batch(
 	return(true);
 }
 
+/*******************************************************************//**
+Flushes dirty blocks from the end of the flush list of one buffer pool
+instance and records the batch in the flush statistics.
+NOTE: The calling thread is not allowed to own any latches on pages!
+@return true if the batch was run, false if another flush list batch
+was already running in the instance */
+static
+bool
+buf_flush_list_instance(
+/*====================*/
+	buf_pool_t*	buf_pool,	/*!< in/out: buffer pool instance */
+	ulint		min_n,		/*!< in: wished minimum mumber of blocks
+					flushed (it is not guaranteed that the
+					actual number is that big, though) */
+	lsn_t		lsn_limit,	/*!< in: all blocks whose
+					oldest_modification is smaller than
+					this should be flushed (if their
+					number does not exceed min_n) */
+	ulint*		n_processed)	/*!< out: the number of pages
+					which were processed */
+{
+	std::pair<ulint, ulint>	res;
+	ulonglong		start_time;
+
+	*n_processed = 0;
+
+	if (!buf_flush_start(buf_pool, BUF_FLUSH_LIST)) {
+		return(false);
+	}
+
+	start_time = my_timer_now();
+
+	res = buf_flush_batch(buf_pool, BUF_FLUSH_LIST, min_n, lsn_limit);
+
+	buf_flush_end(buf_pool, BUF_FLUSH_LIST);
+
+	if (innobase_histogram_step_size_flush_batch) {
+		latency_histogram_increment(&buf_pool->flush_list_histogram,
+					    my_timer_since(start_time), 1);
+	}
+
+	buf_flush_common(BUF_FLUSH_LIST, res.first);
+
+	if (res.first) {
+		MONITOR_INC_VALUE_CUMULATIVE(
+			MONITOR_FLUSH_BATCH_TOTAL_PAGE,
+			MONITOR_FLUSH_BATCH_COUNT,
+			MONITOR_FLUSH_BATCH_PAGES,
+			res.first);
+	}
+
+	*n_processed = res.first;
+
+	return(true);
+}
+
 /*******************************************************************//**
 This utility flushes dirty blocks from the end of the flush list of
 all buffer pool instances.
@@ -1917,12 +2037,10 @@ buf_flush_list(
 
 	/* Flush to lsn_limit in all buffer pool instances */
 	for (i = 0; i < srv_buf_pool_instances; i++) {
-		buf_pool_t*		buf_pool;
-		std::pair<ulint, ulint>	res;
+		ulint	n_flushed;
 
-		buf_pool = buf_pool_from_array(i);
-
-		if (!buf_flush_start(buf_pool, BUF_FLUSH_LIST)) {
+		if (!buf_flush_list_instance(buf_pool_from_array(i),
+					     min_n, lsn_limit, &n_flushed)) {
 			/* We have two choices here. If lsn_limit was
 			specified then skipping an instance of buffer
 			pool means we cannot guarantee that all pages
@@ -1938,23 +2056,8 @@ buf_flush_list(
 			continue;
 		}
 
-		res = buf_flush_batch(
-			buf_pool, BUF_FLUSH_LIST, min_n, lsn_limit);
-
-		buf_flush_end(buf_pool, BUF_FLUSH_LIST);
-
-		buf_flush_common(BUF_FLUSH_LIST, res.first);
-
 		if (n_processed) {
-			*n_processed += res.first;
-		}
-
-		if (res.first) {
-			MONITOR_INC_VALUE_CUMULATIVE(
-				MONITOR_FLUSH_BATCH_TOTAL_PAGE,
-				MONITOR_FLUSH_BATCH_COUNT,
-				MONITOR_FLUSH_BATCH_PAGES,
-				res.first);
+			*n_processed += n_flushed;
 		}
 	}
 
@@ -2111,6 +2214,208 @@ buf_flush_LRU_lists(void)
 	return(n_flushed);
 }
 
+/*********************************************************************//**
+Clears up tail of the LRU list of one buffer pool instance and records
+the batch in the flush statistics. See buf_flush_LRU_tail().
+@return total pages processed. */
+static
+ulint
+buf_flush_LRU_tail_instance(
+/*========================*/
+	buf_pool_t*	buf_pool)	/*!< in/out: buffer pool instance */
+{
+	std::pair<ulint, ulint>	res;
+	ulint			scan_depth;
+	ulonglong		start_time;
+
+	/* srv_LRU_scan_depth can be arbitrarily large value.
+	We cap it with current LRU size. */
+	buf_pool_mutex_enter(buf_pool);
+	scan_depth = UT_LIST_GET_LEN(buf_pool->LRU);
+	buf_pool_mutex_exit(buf_pool);
+
+	scan_depth = ut_min(srv_LRU_scan_depth, scan_depth);
+
+	/* Currently page_cleaner is the only thread
+	that can trigger an LRU flush. It is possible
+	that a batch triggered during last iteration is
+	still running, */
+	if (!buf_flush_start(buf_pool, BUF_FLUSH_LRU)) {
+		return(0);
+	}
+
+	start_time = my_timer_now();
+
+	res = buf_flush_batch(buf_pool, BUF_FLUSH_LRU, scan_depth, 0);
+
+	buf_flush_end(buf_pool, BUF_FLUSH_LRU);
+
+	if (innobase_histogram_step_size_flush_batch) {
+		latency_histogram_increment(&buf_pool->lru_flush_histogram,
+					    my_timer_since(start_time), 1);
+	}
+
+	buf_flush_common(BUF_FLUSH_LRU, res.first);
+
+	if (res.first) {
+		MONITOR_INC_VALUE_CUMULATIVE(
+			MONITOR_LRU_BATCH_FLUSH_TOTAL_PAGE,
+			MONITOR_LRU_BATCH_FLUSH_COUNT,
+			MONITOR_LRU_BATCH_FLUSH_PAGES,
+			res.first);
+	}
+
+	if (res.second) {
+		MONITOR_INC_VALUE_CUMULATIVE(
+			MONITOR_LRU_BATCH_EVICT_TOTAL_PAGE,
+			MONITOR_LRU_BATCH_EVICT_COUNT,
+			MONITOR_LRU_BATCH_EVICT_PAGES,
+			res.second);
+	}
+
+	return(res.first + res.second);
+}
+
+/*********************************************************************//**
+Picks up one requested batch of the given type from the page cleaner
+pool, if any is left, and runs it.
+@return true if a batch was run */
+static
+bool
+pc_flush_slot(
+/*==========*/
+	buf_flush_t	type)	/*!< in: BUF_FLUSH_LRU or BUF_FLUSH_LIST */
+{
+	page_cleaner_slot_t*	slot = NULL;
+	ulint			i = 0;
+
+	ut_ad(type == BUF_FLUSH_LRU || type == BUF_FLUSH_LIST);
+
+	os_fast_mutex_lock(&page_cleaner->mutex);
+
+	if (page_cleaner->n_requested[type] > 0) {
+		for (i = 0; i < srv_buf_pool_instances; i++) {
+			if (page_cleaner->slots[type][i].state
+			    == PAGE_CLEANER_STATE_REQUESTED) {
+
+				slot = &page_cleaner->slots[type][i];
+				break;
+			}
+		}
+
+		ut_a(slot != NULL);
+
+		slot->state = PAGE_CLEANER_STATE_FLUSHING;
+		page_cleaner->n_requested[type]--;
+	}
+
+	os_fast_mutex_unlock(&page_cleaner->mutex);
+
+	if (slot == NULL) {
+		return(false);
+	}
+
+	/* The slot is owned by this thread until it is marked
+	finished, no need to hold the mutex while flushing. */
+	if (type == BUF_FLUSH_LIST) {
+		slot->success = buf_flush_list_instance(
+			buf_pool_from_array(i), slot->min_n,
+			slot->lsn_limit, &slot->n_processed);
+	} else {
+		slot->n_processed = buf_flush_LRU_tail_instance(
+			buf_pool_from_array(i));
+		slot->success = true;
+	}
+
+	os_fast_mutex_lock(&page_cleaner->mutex);
+
+	slot->state = PAGE_CLEANER_STATE_FINISHED;
+
+	if (++page_cleaner->n_finished[type] == srv_buf_pool_instances) {
+		os_event_set(page_cleaner->is_finished[type]);
+	}
+
+	os_fast_mutex_unlock(&page_cleaner->mutex);
+
+	return(true);
+}
+
+/*********************************************************************//**
+Requests a batch of the given type on every buffer pool instance from
+the page cleaner pool and waits for all of them to finish. The calling
+thread runs batches as well, so this completes even if every worker is
+busy or has already exited.
+@return number of pages processed by the batches */
+static
+ulint
+pc_request_and_wait(
+/*================*/
+	buf_flush_t	type,		/*!< in: BUF_FLUSH_LRU or
+					BUF_FLUSH_LIST */
+	ulint		min_n,		/*!< in: wished minimum number of
+					blocks flushed per instance */
+	lsn_t		lsn_limit,	/*!< in: LSN up to which flushing
+					must happen, BUF_FLUSH_LIST only */
+	bool*		success)	/*!< out: false if a batch of the
+					same type was already running in
+					at least one instance */
+{
+	ulint	n_processed = 0;
+
+	os_fast_mutex_lock(&page_cleaner->mutex);
+
+	ut_ad(page_cleaner->n_requested[type] == 0);
+	ut_ad(page_cleaner->n_finished[type] == 0);
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		page_cleaner_slot_t*	slot = &page_cleaner->slots[type][i];
+
+		ut_ad(slot->state == PAGE_CLEANER_STATE_NONE);
+
+		slot->state = PAGE_CLEANER_STATE_REQUESTED;
+		slot->min_n = min_n;
+		slot->lsn_limit = lsn_limit;
+		slot->n_processed = 0;
+		slot->success = false;
+	}
+
+	page_cleaner->n_requested[type] = srv_buf_pool_instances;
+
+	os_event_reset(page_cleaner->is_finished[type]);
+	os_event_set(page_cleaner->is_requested);
+
+	os_fast_mutex_unlock(&page_cleaner->mutex);
+
+	while (pc_flush_slot(type)) {
+		/* Run batches until none is left to pick up. */
+	}
+
+	os_event_wait(page_cleaner->is_finished[type]);
+
+	*success = true;
+
+	os_fast_mutex_lock(&page_cleaner->mutex);
+
+	ut_ad(page_cleaner->n_finished[type] == srv_buf_pool_instances);
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		page_cleaner_slot_t*	slot = &page_cleaner->slots[type][i];
+
+		ut_ad(slot->state == PAGE_CLEANER_STATE_FINISHED);
+
+		n_processed += slot->n_processed;
+		*success = *success && slot->success;
+
+		slot->state = PAGE_CLEANER_STATE_NONE;
+	}
+
+	page_cleaner->n_finished[type] = 0;
+
+	os_fast_mutex_unlock(&page_cleaner->mutex);
+
+	return(n_processed);
+}
+
 /*********************************************************************//**
 Clears up tail of the LRU lists:
 * Put replaceable pages at the tail of LRU to the free list
@@ -2125,51 +2430,16 @@ buf_flush_LRU_tail(void)
 {
 	ulint	total_processed = 0;
 
-	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
-
-		buf_pool_t*	buf_pool = buf_pool_from_array(i);
-		std::pair<ulint, ulint>	res;
-		ulint	scan_depth;
-
-		/* srv_LRU_scan_depth can be arbitrarily large value.
-		We cap it with current LRU size. */
-		buf_pool_mutex_enter(buf_pool);
-		scan_depth = UT_LIST_GET_LEN(buf_pool->LRU);
-		buf_pool_mutex_exit(buf_pool);
-
-		scan_depth = ut_min(srv_LRU_scan_depth, scan_depth);
+	if (page_cleaner != NULL) {
+		bool	success;
 
-		/* Currently page_cleaner is the only thread
-		that can trigger an LRU flush. It is possible
-		that a batch triggered during last iteration is
-		still running, */
-		if (!buf_flush_start(buf_pool, BUF_FLUSH_LRU)) {
-			continue;
-		}
-
-		res = buf_flush_batch(buf_pool, BUF_FLUSH_LRU, scan_depth, 0);
-
-		buf_flush_end(buf_pool, BUF_FLUSH_LRU);
-
-		buf_flush_common(BUF_FLUSH_LRU, res.first);
-
-		if (res.first) {
-			MONITOR_INC_VALUE_CUMULATIVE(
-				MONITOR_LRU_BATCH_FLUSH_TOTAL_PAGE,
-				MONITOR_LRU_BATCH_FLUSH_COUNT,
-				MONITOR_LRU_BATCH_FLUSH_PAGES,
-				res.first);
-		}
+		return(pc_request_and_wait(BUF_FLUSH_LRU, 0, 0, &success));
+	}
 
-		if (res.second) {
-			MONITOR_INC_VALUE_CUMULATIVE(
-				MONITOR_LRU_BATCH_EVICT_TOTAL_PAGE,
-				MONITOR_LRU_BATCH_EVICT_COUNT,
-				MONITOR_LRU_BATCH_EVICT_PAGES,
-				res.second);
-		}
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
 
-		total_processed += (res.first + res.second);
+		total_processed += buf_flush_LRU_tail_instance(
+			buf_pool_from_array(i));
 	}
 
 	return(total_processed);
@@ -2215,6 +2485,20 @@ page_cleaner_do_flush_batch(
 {
 	ulint n_flushed;
 
+	if (page_cleaner != NULL) {
+		bool	success;
+
+		/* Spread the batch evenly amongst the buffer pool
+		instances as buf_flush_list() does. */
+		if (n_to_flush != ULINT_MAX) {
+			n_to_flush = (n_to_flush + srv_buf_pool_instances - 1)
+				     / srv_buf_pool_instances;
+		}
+
+		return(pc_request_and_wait(BUF_FLUSH_LIST, n_to_flush,
+					   lsn_limit, &success));
+	}
+
 	buf_flush_list(n_to_flush, lsn_limit, &n_flushed);
 
 	return(n_flushed);
@@ -2537,6 +2821,143 @@ lru_manager_adapt_sleep_time(
 	}
 }
 
+/******************************************************************//**
+Initializes the page cleaner pool when innodb_page_cleaners is greater
+than 1. Must be called before the page cleaner threads are created;
+the caller then creates srv_n_page_cleaners - 1 worker threads. */
+UNIV_INTERN
+void
+buf_flush_page_cleaner_init(void)
+/*=============================*/
+{
+	ut_ad(page_cleaner == NULL);
+	ut_ad(!srv_read_only_mode);
+
+	if (srv_n_page_cleaners <= 1) {
+		return;
+	}
+
+	page_cleaner = static_cast<page_cleaner_t*>(
+		mem_zalloc(sizeof *page_cleaner));
+
+	os_fast_mutex_init(PFS_NOT_INSTRUMENTED, &page_cleaner->mutex);
+
+	page_cleaner->is_requested = os_event_create();
+
+	for (ulint i = BUF_FLUSH_LRU; i <= BUF_FLUSH_LIST; i++) {
+		page_cleaner->is_finished[i] = os_event_create();
+		page_cleaner->slots[i] = static_cast<page_cleaner_slot_t*>(
+			mem_zalloc(srv_buf_pool_instances
+				   * sizeof *page_cleaner->slots[i]));
+	}
+
+	/* Count the workers up front, so that the pool is not freed
+	under a worker which has not started running yet. */
+	page_cleaner->n_workers = srv_n_page_cleaners - 1;
+	page_cleaner->is_running = true;
+}
+
+/******************************************************************//**
+Stops the page cleaner workers and frees the page cleaner pool. */
+static
+void
+buf_flush_page_cleaner_close(void)
+/*==============================*/
+{
+	if (page_cleaner == NULL) {
+		return;
+	}
+
+	/* The lru_manager may still be requesting LRU batches from
+	the pool. */
+	wait_for_buf_lru_manager_to_complete();
+
+	page_cleaner->is_running = false;
+	os_event_set(page_cleaner->is_requested);
+
+	for (;;) {
+		ulint	n_workers;
+
+		os_fast_mutex_lock(&page_cleaner->mutex);
+		n_workers = page_cleaner->n_workers;
+		os_fast_mutex_unlock(&page_cleaner->mutex);
+
+		if (n_workers == 0) {
+			break;
+		}
+
+		os_thread_sleep(10000);
+	}
+
+	for (ulint i = BUF_FLUSH_LRU; i <= BUF_FLUSH_LIST; i++) {
+		ut_ad(page_cleaner->n_requested[i] == 0);
+		os_event_free(page_cleaner->is_finished[i]);
+		mem_free(page_cleaner->slots[i]);
+	}
+
+	os_event_free(page_cleaner->is_requested);
+	os_fast_mutex_free(&page_cleaner->mutex);
+
+	mem_free(page_cleaner);
+	page_cleaner = NULL;
+}
+
+/******************************************************************//**
+page_cleaner worker thread. Runs the flush list and LRU batches that
+the page_cleaner and lru_manager threads request on the buffer pool
+instances, see page_cleaner_t.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(buf_flush_page_cleaner_worker)(
+/*==========================================*/
+	void*	arg MY_ATTRIBUTE((unused)))
+			/*!< in: a dummy parameter required by
+			os_thread_create */
+{
+	ut_ad(page_cleaner != NULL);
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(buf_page_cleaner_worker_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+#ifdef UNIV_DEBUG_THREAD_CREATION
+	fprintf(stderr, "InnoDB: page_cleaner worker running, id %lu\n",
+		os_thread_pf(os_thread_get_curr_id()));
+#endif /* UNIV_DEBUG_THREAD_CREATION */
+
+	for (;;) {
+		ib_int64_t	sig_count;
+
+		/* Reset before checking for work so that a request
+		or a stop made after the check wakes us up. */
+		sig_count = os_event_reset(page_cleaner->is_requested);
+
+		if (!page_cleaner->is_running) {
+			break;
+		}
+
+		/* LRU batches first, they refill the free lists
+		user threads may be waiting on. */
+		if (!pc_flush_slot(BUF_FLUSH_LRU)
+		    && !pc_flush_slot(BUF_FLUSH_LIST)) {
+
+			os_event_wait_low(page_cleaner->is_requested,
+					  sig_count);
+		}
+	}
+
+	os_fast_mutex_lock(&page_cleaner->mutex);
+	page_cleaner->n_workers--;
+	os_fast_mutex_unlock(&page_cleaner->mutex);
+
+	/* We count the number of threads in os_thread_exit(). A created
+	thread should always use that to exit and not use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
 /******************************************************************//**
 page_cleaner thread tasked with flushing dirty pages from the buffer
 pools. As of now we'll have only one instance of this thread.
@@ -2668,6 +3089,8 @@ DECLARE_THREAD(buf_flush_page_cleaner_thread)(
 	/* We have lived our life. Time to die. */
 
 thread_exit:
+	buf_flush_page_cleaner_close();
+
 	buf_pool_resizable_page_cleaner = true;
 	buf_page_cleaner_is_active = FALSE;
 
@@ -274,6 +274,23 @@ static TYPELIB innodb_checksum_algorithm_typelib = {
 	NULL
 };
 
+/** Possible values for system variable "innodb_log_page_images". */
+static const char* innodb_log_page_images_names[] = {
+	"none",
+	"file_per_table",
+	"all",
+	NullS
+};
+
+/** Used to define an enumerate type of the system variable
+innodb_log_page_images. */
+static TYPELIB innodb_log_page_images_typelib = {
+	array_elements(innodb_log_page_images_names) - 1,
+	"innodb_log_page_images_typelib",
+	innodb_log_page_images_names,
+	NULL
+};
+
 /** Possible values for system variable "innodb_default_row_format". */
 static const char *innodb_default_row_format_names[] = {"redundant", "compact",
                                                         "dynamic", NullS};
@@ -392,7 +409,7 @@ static PSI_mutex_info all_innodb_mutexes[] = {
 	{&buf_dblwr_mutex_key, "buf_dblwr_mutex", 0},
 	{&trx_undo_mutex_key, "trx_undo_mutex", 0},
 	{&srv_sys_mutex_key, "srv_sys_mutex", 0},
-	{&lock_sys_mutex_key, "lock_mutex", 0},
+	{&lock_sys_rec_hash_mutex_key, "lock_rec_hash_mutex", 0},
 	{&lock_sys_wait_mutex_key, "lock_wait_mutex", 0},
 	{&trx_mutex_key, "trx_mutex", 0},
 	{&srv_sys_tasks_mutex_key, "srv_threads_mutex", 0},
@@ -438,6 +455,7 @@ static PSI_rwlock_info all_innodb_rwlocks[] = {
 	{&index_tree_rw_lock_key, "index_tree_rw_lock", 0},
 	{&index_online_log_key, "index_online_log", 0},
 	{&dict_table_stats_key, "dict_table_stats", 0},
+	{&lock_sys_latch_key, "lock_sys_latch", 0},
 	{&hash_table_rw_lock_key, "hash_table_locks", 0}
 };
 # endif /* UNIV_PFS_RWLOCK */
@@ -455,8 +473,12 @@ static PSI_thread_info	all_innodb_threads[] = {
 	{&srv_master_thread_key, "srv_master_thread", 0},
 	{&srv_purge_thread_key, "srv_purge_thread", 0},
 	{&buf_page_cleaner_thread_key, "page_cleaner_thread", 0},
+	{&buf_page_cleaner_worker_thread_key, "page_cleaner_worker_thread", 0},
 	{&buf_lru_manager_thread_key, "lru_manager_thread", 0},
 	{&recv_writer_thread_key, "recv_writer_thread", 0},
+	{&recv_apply_thread_key, "recv_apply_thread", 0},
+	{&log_writer_thread_key, "log_writer_thread", 0},
+	{&log_flusher_thread_key, "log_flusher_thread", 0},
 	{&srv_slowrm_thread_key, "srv_slowrm_thread", 0}
 };
 # endif /* UNIV_PFS_THREAD */
@@ -937,6 +959,8 @@ static SHOW_VAR innodb_status_variables[]= {
   (char*) &export_vars.innodb_os_log_pending_writes,	  SHOW_LONG},
   {"os_log_written",
   (char*) &export_vars.innodb_os_log_written,		  SHOW_LONGLONG},
+  {"page_images_logged",
+  (char*) &export_vars.innodb_page_images_logged,	  SHOW_LONG},
   {"page_size",
   (char*) &export_vars.innodb_page_size,		  SHOW_LONG},
   {"pages_created",
@@ -1071,6 +1095,8 @@ static SHOW_VAR innodb_status_variables[]= {
   (char*) &export_vars.innodb_sec_rec_cluster_reads,	  SHOW_LONG},
   {"secondary_index_triggered_cluster_reads_avoided",
   (char*) &export_vars.innodb_sec_rec_cluster_reads_avoided, SHOW_LONG},
+  {"secondary_index_triggered_cluster_reads_page_reused",
+  (char*) &export_vars.innodb_sec_rec_cluster_reads_page_reused, SHOW_LONG},
   {"log_checkpoints",
   (char*) &export_vars.innodb_log_checkpoints,		  SHOW_LONG},
   {"log_syncs",
@@ -5822,8 +5848,8 @@ ha_innobase::open(
 	thd = ha_thd();
 
 	/* Under some cases MySQL seems to call this function while
-	holding btr_search_latch. This breaks the latching order as
-	we acquire dict_sys->mutex below and leads to a deadlock. */
+	holding an adaptive hash index latch. This breaks the latching
+	order as we acquire dict_sys->mutex below and leads to a deadlock. */
 	if (thd != NULL) {
 		innobase_release_temporary_latches(ht, thd);
 
@@ -17811,6 +17837,22 @@ static MYSQL_SYSVAR_ULONG(doublewrite, srv_use_doublewrite_buf,
   "2=Enable reduced doublewrite mode. ",
   NULL, innodb_doublewrite_update, 1, 0, 2, 0);
 
+static MYSQL_SYSVAR_ENUM(log_page_images, srv_log_page_images,
+  PLUGIN_VAR_RQCMDARG,
+  "Protect pages against torn writes by logging a full image of a page "
+  "when it is made dirty, instead of writing the page through the "
+  "doublewrite buffer. Possible values are "
+  "NONE "
+    "use the doublewrite buffer for all pages (default); "
+  "FILE_PER_TABLE "
+    "log images for pages of single-table tablespaces; "
+  "ALL "
+    "log images for pages of all tablespaces. "
+  "The first page of a tablespace, the trx system page and compressed "
+  "pages always use the doublewrite buffer.",
+  NULL, NULL, SRV_LOG_PAGE_IMAGES_NONE,
+  &innodb_log_page_images_typelib);
+
 static MYSQL_SYSVAR_BOOL(stats_include_delete_marked,
   srv_stats_include_delete_marked,
   PLUGIN_VAR_OPCMDARG,
@@ -17963,6 +18005,12 @@ static MYSQL_SYSVAR_ULONG(flush_log_at_trx_commit, srv_flush_log_at_trx_commit,
   " or 2 (write at commit, flush once per second).",
   NULL, innodb_flush_log_at_trx_commit_update, 1, 0, 2, 0);
 
+static MYSQL_SYSVAR_BOOL(log_writer_threads, srv_log_writer_threads,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Write and flush the redo log in dedicated log writer and flusher "
+  "threads, which wake up the committing threads that wait for them.",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_STR(flush_method, innobase_file_flush_method,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "With which method to flush data.", NULL, NULL, NULL);
@@ -18109,6 +18157,12 @@ static MYSQL_SYSVAR_BOOL(adaptive_hash_index, btr_search_enabled,
   "Disable with --skip-innodb-adaptive-hash-index.",
   NULL, innodb_adaptive_hash_index_update, TRUE);
 
+static MYSQL_SYSVAR_ULONG(adaptive_hash_index_partitions, btr_search_index_num,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of independently latched partitions of the InnoDB adaptive hash "
+  "index. Indexes are assigned to the partitions by index id.",
+  NULL, NULL, 1, 1, 64, 0);
+
 static MYSQL_SYSVAR_ULONG(replication_delay, srv_replication_delay,
   PLUGIN_VAR_RQCMDARG,
   "Replication thread delay (ms) on the slave server if "
@@ -18238,6 +18292,13 @@ static MYSQL_SYSVAR_STR(histogram_step_size_fsync,
   "Size of the histogram bins required for tracking fsync latencies",
   innodb_histogram_step_size_validate, NULL, "16ms");
 
+static MYSQL_SYSVAR_STR(histogram_step_size_flush_batch,
+  innobase_histogram_step_size_flush_batch,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_MEMALLOC | PLUGIN_VAR_ALLOCATED,
+  "Size of the histogram bins required for tracking the latency of "
+  "flush list and LRU flush batches of each buffer pool instance",
+  innodb_histogram_step_size_validate, NULL, "16ms");
+
 static MYSQL_SYSVAR_ULONG(sync_pool_size, innobase_sync_pool_size,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "The size of the shared sync pool buffer InnoDB uses to store system lock"
@@ -18466,6 +18527,13 @@ static MYSQL_SYSVAR_ULONG(ft_sort_pll_degree, fts_sort_pll_degree,
   "InnoDB Fulltext search parallel sort degree, will round up to nearest power of 2 number",
   NULL, NULL, 2, 1, 16, 0);
 
+static MYSQL_SYSVAR_ULONG(index_build_scan_threads, row_merge_scan_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads scanning the clustered index, split into key ranges, "
+  "when creating secondary indexes. 1 scans with the ALTER TABLE thread "
+  "only.",
+  NULL, NULL, 1, 1, 64, 0);
+
 static MYSQL_SYSVAR_ULONG(sort_buffer_size, srv_sort_buf_size,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "Memory buffer size for index creation",
@@ -18600,6 +18668,13 @@ static MYSQL_SYSVAR_BOOL(prefix_index_cluster_optimization,
   "Enable prefix optimization to sometimes avoid cluster index lookups.",
   NULL, NULL, FALSE);
 
+static MYSQL_SYSVAR_BOOL(batched_cluster_reads,
+  srv_batched_cluster_reads,
+  PLUGIN_VAR_OPCMDARG,
+  "Look up the cluster index records of secondary index range scans in "
+  "batches sorted by primary key, filling the row prefetch cache.",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_ULONG(thread_sleep_delay, srv_thread_sleep_delay,
   PLUGIN_VAR_RQCMDARG,
   "Time of innodb thread sleeping before joining InnoDB queue (usec). "
@@ -18672,6 +18747,19 @@ static MYSQL_SYSVAR_BOOL(use_native_aio, srv_use_native_aio,
   "Use native AIO if supported on this platform.",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_BOOL(use_io_uring, srv_use_io_uring,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Use io_uring instead of libaio for Linux native AIO, if supported "
+  "by the kernel and compiled in.",
+  NULL, NULL, FALSE);
+
+static MYSQL_SYSVAR_ULONG(io_uring_poll_usecs, srv_io_uring_poll_usecs,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of microseconds the read and write i/o threads busy poll for "
+  "io_uring completions before sleeping in the kernel. 0 disables "
+  "polling.",
+  NULL, NULL, 0, 0, 10000, 0);
+
 #ifdef HAVE_LIBNUMA
 static MYSQL_SYSVAR_BOOL(numa_interleave, srv_numa_interleave,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
@@ -18916,6 +19004,13 @@ static MYSQL_SYSVAR_UINT(
   "Maximum number of steps allowed in deadlock detection, 0 means this is turned off",
   NULL, NULL, 0, 0, UINT_MAX32, 0);
 
+static MYSQL_SYSVAR_BOOL(read_view_cache, srv_read_view_cache,
+  PLUGIN_VAR_NOCMDARG,
+  "Share read views between autocommit read-only SELECTs until the next "
+  "read-write transaction commits, avoiding trx_sys->mutex when opening "
+  "a view.",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_ULONG(lru_manager_max_sleep_time, srv_cleaner_max_lru_time,
   PLUGIN_VAR_RQCMDARG,
   "The maximum time limit for a single LRU tail flush iteration by the lru "
@@ -18927,6 +19022,19 @@ static MYSQL_SYSVAR_BOOL(page_cleaner_adaptive_sleep, srv_pc_adaptive_sleep,
   "Enable adaptive sleep time calculation for page cleaner thread",
   NULL, NULL, FALSE);
 
+static MYSQL_SYSVAR_ULONG(page_cleaners, srv_n_page_cleaners,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of page cleaner threads used to flush the buffer pool "
+  "instances in parallel. 1 keeps the single threaded page cleaner.",
+  NULL, NULL, 1, 1, 64, 0);
+
+static MYSQL_SYSVAR_ULONG(recovery_apply_threads, srv_n_recv_apply_threads,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of threads applying redo log records to pages in crash "
+  "recovery, each to its own partition of the pages. 1 applies them "
+  "from the recovery thread only.",
+  NULL, NULL, 1, 1, 64, 0);
+
 static MYSQL_SYSVAR_ULONG(aio_old_usecs, srv_io_old_usecs,
   PLUGIN_VAR_RQCMDARG,
   "AIO requests are scheduled in file offset order until they are this old. ",
@@ -18997,6 +19105,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(histogram_step_size_double_write),
   MYSQL_SYSVAR(histogram_step_size_file_flush_time),
   MYSQL_SYSVAR(histogram_step_size_fsync),
+  MYSQL_SYSVAR(histogram_step_size_flush_batch),
 #ifdef UNIV_DEBUG
   MYSQL_SYSVAR(buffer_pool_evict),
 #endif /* UNIV_DEBUG */
@@ -19022,7 +19131,9 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(data_home_dir),
   MYSQL_SYSVAR(deadlock_detect),
   MYSQL_SYSVAR(max_deadlock_detection_steps),
+  MYSQL_SYSVAR(read_view_cache),
   MYSQL_SYSVAR(doublewrite),
+  MYSQL_SYSVAR(log_page_images),
   MYSQL_SYSVAR(stats_include_delete_marked),
   MYSQL_SYSVAR(api_enable_binlog),
   MYSQL_SYSVAR(api_enable_mdl),
@@ -19037,6 +19148,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(file_format_max),
   MYSQL_SYSVAR(flush_log_at_timeout),
   MYSQL_SYSVAR(flush_log_at_trx_commit),
+  MYSQL_SYSVAR(log_writer_threads),
   MYSQL_SYSVAR(flush_method),
   MYSQL_SYSVAR(force_recovery),
 #ifndef DBUG_OFF
@@ -19092,6 +19204,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(stats_recalc_threshold),
   MYSQL_SYSVAR(stats_locked_reads),
   MYSQL_SYSVAR(adaptive_hash_index),
+  MYSQL_SYSVAR(adaptive_hash_index_partitions),
   MYSQL_SYSVAR(stats_method),
   MYSQL_SYSVAR(replication_delay),
   MYSQL_SYSVAR(status_file),
@@ -19102,6 +19215,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(strict_mode),
   MYSQL_SYSVAR(support_xa),
   MYSQL_SYSVAR(sort_buffer_size),
+  MYSQL_SYSVAR(index_build_scan_threads),
   MYSQL_SYSVAR(online_alter_log_max_size),
   MYSQL_SYSVAR(sync_spin_loops),
   MYSQL_SYSVAR(spin_wait_delay),
@@ -19114,12 +19228,15 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(adaptive_max_sleep_delay),
 #endif /* HAVE_ATOMIC_BUILTINS */
   MYSQL_SYSVAR(prefix_index_cluster_optimization),
+  MYSQL_SYSVAR(batched_cluster_reads),
   MYSQL_SYSVAR(thread_sleep_delay),
   MYSQL_SYSVAR(autoinc_lock_mode),
   MYSQL_SYSVAR(version),
   MYSQL_SYSVAR(use_fdatasync),
   MYSQL_SYSVAR(use_sys_malloc),
   MYSQL_SYSVAR(use_native_aio),
+  MYSQL_SYSVAR(use_io_uring),
+  MYSQL_SYSVAR(io_uring_poll_usecs),
 #ifdef HAVE_LIBNUMA
   MYSQL_SYSVAR(numa_interleave),
 #endif // HAVE_LIBNUMA
@@ -19191,6 +19308,8 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(zlib_strategy),
   MYSQL_SYSVAR(lru_manager_max_sleep_time),
   MYSQL_SYSVAR(page_cleaner_adaptive_sleep),
+  MYSQL_SYSVAR(page_cleaners),
+  MYSQL_SYSVAR(recovery_apply_threads),
 #ifdef UNIV_DEBUG
   MYSQL_SYSVAR(allow_ibuf_merges),
 #endif /* UNIV_DEBUG */
@@ -19243,7 +19362,8 @@ i_s_innodb_sys_foreign_cols,
 i_s_innodb_sys_tablespaces,
 i_s_innodb_sys_datafiles,
 i_s_innodb_file_status,
-i_s_innodb_sys_docstore
+i_s_innodb_sys_docstore,
+i_s_innodb_ahi_partitions
 
 mysql_declare_plugin_end;
 
@@ -36,6 +36,7 @@ Created July 18, 2007 Vasil Dimov
 #include <mysql/innodb_priv.h>
 
 #include "btr0pcur.h"
+#include "btr0sea.h"
 #include "btr0types.h"
 #include "dict0dict.h"
 #include "dict0load.h"
@@ -8865,3 +8866,208 @@ UNIV_INTERN struct st_mysql_plugin	i_s_innodb_sys_docstore =
 	/* unsigned long */
 	STRUCT_FLD(flags, 0UL),
 };
+
+/**  ADAPTIVE_HASH_PARTITIONS  ***********************************************/
+/* Fields of the dynamic table
+INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_PARTITIONS */
+static ST_FIELD_INFO	i_s_innodb_ahi_partitions_fields_info[] =
+{
+#define AHI_PARTITIONS_PARTITION_ID	0
+	{STRUCT_FLD(field_name,		"PARTITION_ID"),
+	 STRUCT_FLD(field_length,	MY_INT32_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_PARTITIONS_HASH_CELLS	1
+	{STRUCT_FLD(field_name,		"HASH_CELLS"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_PARTITIONS_HEAP_BYTES	2
+	{STRUCT_FLD(field_name,		"HEAP_BYTES"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_PARTITIONS_SEARCHES		3
+	{STRUCT_FLD(field_name,		"SEARCHES"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_PARTITIONS_HITS		4
+	{STRUCT_FLD(field_name,		"HITS"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_PARTITIONS_HIT_RATE		5
+	{STRUCT_FLD(field_name,		"HIT_RATE"),
+	 STRUCT_FLD(field_length,	0),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_FLOAT),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	0),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_PARTITIONS_LATCH_OS_WAITS	6
+	{STRUCT_FLD(field_name,		"LATCH_OS_WAITS"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+	END_OF_ST_FIELD_INFO
+};
+
+/*******************************************************************//**
+Function to populate INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_PARTITIONS.
+The search and hit counters are not protected by any latch and may be
+slightly inaccurate.
+@return 0 on success */
+static
+int
+i_s_innodb_ahi_partitions_fill_table(
+/*=================================*/
+	THD*		thd,	/*!< in: thread */
+	TABLE_LIST*	tables,	/*!< in/out: tables to fill */
+	Item*		)	/*!< in: condition (not used) */
+{
+	Field**	fields;
+
+	DBUG_ENTER("i_s_innodb_ahi_partitions_fill_table");
+	RETURN_IF_INNODB_NOT_STARTED(tables->schema_table_name);
+
+	/* deny access to user without PROCESS_ACL privilege */
+	if (check_global_access(thd, PROCESS_ACL)) {
+		DBUG_RETURN(0);
+	}
+
+	fields = tables->table->field;
+
+	for (ulint i = 0; i < btr_search_index_num; i++) {
+		const btr_search_part_t* part = &btr_search_sys->parts[i];
+		rw_lock_t*	latch = &btr_search_latch_arr[i];
+		ulint		n_cells;
+		ulint		heap_bytes;
+		ulint		n_searches = part->n_searches;
+		ulint		n_succ = part->n_succ;
+
+		rw_lock_s_lock(latch);
+		n_cells = hash_get_n_cells(part->hash_index);
+		heap_bytes = mem_heap_get_size(part->hash_index->heap);
+		rw_lock_s_unlock(latch);
+
+		OK(fields[AHI_PARTITIONS_PARTITION_ID]->store(
+			   static_cast<double>(i)));
+		OK(fields[AHI_PARTITIONS_HASH_CELLS]->store(
+			   static_cast<double>(n_cells)));
+		OK(fields[AHI_PARTITIONS_HEAP_BYTES]->store(
+			   static_cast<double>(heap_bytes)));
+		OK(fields[AHI_PARTITIONS_SEARCHES]->store(
+			   static_cast<double>(n_searches)));
+		OK(fields[AHI_PARTITIONS_HITS]->store(
+			   static_cast<double>(n_succ)));
+		OK(fields[AHI_PARTITIONS_HIT_RATE]->store(
+			   n_searches
+			   ? static_cast<double>(n_succ) / n_searches
+			   : 0.0));
+		OK(fields[AHI_PARTITIONS_LATCH_OS_WAITS]->store(
+			   static_cast<double>(latch->count_os_wait)));
+
+		OK(schema_table_store_record(thd, tables->table));
+	}
+
+	DBUG_RETURN(0);
+}
+
+/*******************************************************************//**
+Bind the dynamic table INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_PARTITIONS
+@return 0 on success */
+static
+int
+i_s_innodb_ahi_partitions_init(
+/*===========================*/
+	void*	p)	/*!< in/out: table schema object */
+{
+	ST_SCHEMA_TABLE*	schema;
+
+	DBUG_ENTER("i_s_innodb_ahi_partitions_init");
+
+	schema = (ST_SCHEMA_TABLE*) p;
+	schema->fields_info = i_s_innodb_ahi_partitions_fields_info;
+	schema->fill_table = i_s_innodb_ahi_partitions_fill_table;
+
+	DBUG_RETURN(0);
+}
+
+UNIV_INTERN struct st_mysql_plugin	i_s_innodb_ahi_partitions =
+{
+	/* the plugin type (a MYSQL_XXX_PLUGIN value) */
+	/* int */
+	STRUCT_FLD(type, MYSQL_INFORMATION_SCHEMA_PLUGIN),
+
+	/* pointer to type-specific plugin descriptor */
+	/* void* */
+	STRUCT_FLD(info, &i_s_info),
+
+	/* plugin name */
+	/* const char* */
+	STRUCT_FLD(name, "INNODB_ADAPTIVE_HASH_PARTITIONS"),
+
+	/* plugin author (for SHOW PLUGINS) */
+	/* const char* */
+	STRUCT_FLD(author, plugin_author),
+
+	/* general descriptive text (for SHOW PLUGINS) */
+	/* const char* */
+	STRUCT_FLD(descr, "InnoDB adaptive hash index partition statistics"),
+
+	/* the plugin license (PLUGIN_LICENSE_XXX) */
+	/* int */
+	STRUCT_FLD(license, PLUGIN_LICENSE_GPL),
+
+	/* the function to invoke when plugin is loaded */
+	/* int (*)(void*); */
+	STRUCT_FLD(init, i_s_innodb_ahi_partitions_init),
+
+	/* the function to invoke when plugin is unloaded */
+	/* int (*)(void*); */
+	STRUCT_FLD(deinit, i_s_common_deinit),
+
+	/* plugin version (for SHOW PLUGINS) */
+	/* unsigned int */
+	STRUCT_FLD(version, INNODB_VERSION_SHORT),
+
+	/* struct st_mysql_show_var* */
+	STRUCT_FLD(status_vars, NULL),
+
+	/* struct st_mysql_sys_var** */
+	STRUCT_FLD(system_vars, NULL),
+
+	/* reserved for dependency checking */
+	/* void* */
+	STRUCT_FLD(__reserved1, NULL),
+
+	/* Plugin flags */
+	/* unsigned long */
+	STRUCT_FLD(flags, 0UL),
+};
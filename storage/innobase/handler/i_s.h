@@ -58,5 +58,6 @@ extern struct st_mysql_plugin	i_s_innodb_sys_tablespaces;
 extern struct st_mysql_plugin	i_s_innodb_sys_datafiles;
 extern struct st_mysql_plugin	i_s_innodb_file_status;
 extern struct st_mysql_plugin	i_s_innodb_sys_docstore;
+extern struct st_mysql_plugin	i_s_innodb_ahi_partitions;
 
 #endif /* i_s_h */
@@ -70,6 +70,67 @@ void
 btr_search_enable(void);
 /*====================*/
 
+/********************************************************************//**
+Returns the adaptive hash index partition of an index.
+@return	partition number, less than btr_search_index_num */
+UNIV_INLINE
+ulint
+btr_search_get_part_no(
+/*===================*/
+	index_id_t	index_id)	/*!< in: index id */
+	MY_ATTRIBUTE((warn_unused_result));
+/********************************************************************//**
+Returns the latch protecting the adaptive hash index partition of an
+index.
+@return	partition latch */
+UNIV_INLINE
+rw_lock_t*
+btr_search_get_latch(
+/*=================*/
+	const dict_index_t*	index)	/*!< in: index */
+	MY_ATTRIBUTE((nonnull, warn_unused_result));
+/********************************************************************//**
+Returns the adaptive hash index partition of an index.
+@return	hash table of the partition */
+UNIV_INLINE
+hash_table_t*
+btr_search_get_hash_index(
+/*======================*/
+	const dict_index_t*	index)	/*!< in: index */
+	MY_ATTRIBUTE((nonnull, warn_unused_result));
+/********************************************************************//**
+X-latches all the adaptive hash index partitions, in ascending order. */
+UNIV_INLINE
+void
+btr_search_x_lock_all(void);
+/*=======================*/
+/********************************************************************//**
+Releases the x-latches on all the adaptive hash index partitions. */
+UNIV_INLINE
+void
+btr_search_x_unlock_all(void);
+/*=========================*/
+#ifdef UNIV_SYNC_DEBUG
+/********************************************************************//**
+Checks if the thread owns any adaptive hash index partition latch in
+the given mode.
+@return	true if it owns one */
+UNIV_INLINE
+bool
+btr_search_own_any(
+/*===============*/
+	ulint	lock_type)	/*!< in: RW_LOCK_SHARED or RW_LOCK_EX */
+	MY_ATTRIBUTE((warn_unused_result));
+/********************************************************************//**
+Checks if the thread owns all the adaptive hash index partition
+latches in x-mode.
+@return	true if it owns them */
+UNIV_INLINE
+bool
+btr_search_own_all_x(void);
+/*======================*/
+#endif /* UNIV_SYNC_DEBUG */
+
 /********************************************************************//**
 Returns search info for an index.
 @return	search info; search mutex reserved */
@@ -88,14 +149,15 @@ btr_search_info_create(
 /*===================*/
 	mem_heap_t*	heap);	/*!< in: heap where created */
 /*****************************************************************//**
-Returns the value of ref_count. The value is protected by
-btr_search_latch.
+Returns the value of ref_count. The value is protected by the
+adaptive hash index partition latch of the index.
 @return	ref_count value. */
 UNIV_INTERN
 ulint
 btr_search_info_get_ref_count(
 /*==========================*/
-	btr_search_t*   info);	/*!< in: search info. */
+	btr_search_t*   info,	/*!< in: search info. */
+	dict_index_t*	index);	/*!< in: index */
 /*********************************************************************//**
 Updates the search info. */
 UNIV_INLINE
@@ -121,7 +183,8 @@ btr_search_guess_on_hash(
 	ulint		latch_mode,	/*!< in: BTR_SEARCH_LEAF, ... */
 	btr_cur_t*	cursor,		/*!< out: tree cursor */
 	ulint		has_search_latch,/*!< in: latch mode the caller
-					currently has on btr_search_latch:
+					currently has on
+					btr_search_get_latch(index):
 					RW_S_LATCH, RW_X_LATCH, or 0 */
 	mtr_t*		mtr);		/*!< in: mtr */
 /********************************************************************//**
@@ -205,7 +268,8 @@ struct btr_search_t{
 	ulint	ref_count;	/*!< Number of blocks in this index tree
 				that have search index built
 				i.e. block->index points to this index.
-				Protected by btr_search_latch except
+				Protected by btr_search_get_latch(index)
+				except
 				when during initialization in
 				btr_search_info_create(). */
 
@@ -255,11 +319,26 @@ struct btr_search_t{
 #endif /* UNIV_DEBUG */
 };
 
+/** A partition of the adaptive hash index */
+struct btr_search_part_t{
+	hash_table_t*	hash_index;	/*!< the adaptive hash index of the
+					partition, mapping dtuple_fold values
+					to rec_t pointers on index pages */
+	ulint		n_searches;	/*!< number of hash lookups; not
+					protected, may be inaccurate */
+	ulint		n_succ;		/*!< number of lookups that found a
+					record; not protected, may be
+					inaccurate */
+	byte		pad[64];	/*!< padding to keep the counters
+					of the partitions on different
+					cache lines */
+};
+
 /** The hash index system */
 struct btr_search_sys_t{
-	hash_table_t*	hash_index;	/*!< the adaptive hash index,
-					mapping dtuple_fold values
-					to rec_t pointers on index pages */
+	btr_search_part_t*	parts;	/*!< the btr_search_index_num
+					partitions; the latch of
+					parts[i] is btr_search_latch_arr[i] */
 };
 
 /** The adaptive hash index */
@@ -41,11 +41,17 @@ struct btr_search_t;
 
 #ifndef UNIV_HOTBACKUP
 
-/** @brief The latch protecting the adaptive search system
+/** Number of partitions of the adaptive hash index. The indexes are
+assigned to the partitions by index id, see btr_search_get_latch(). */
+extern ulong		btr_search_index_num;
 
-This latch protects the
-(1) hash index;
-(2) columns of a record to which we have a pointer in the hash index;
+/** @brief The latches protecting the adaptive search system
+
+There is one latch for each of the btr_search_index_num partitions of
+the adaptive hash index. The latch of a partition protects the
+(1) hash index of the partition;
+(2) columns of a record to which we have a pointer in the hash index
+of the partition;
 
 but does NOT protect:
 
@@ -54,15 +60,13 @@ but does NOT protect:
 
 Bear in mind (3) and (4) when using the hash index.
 */
-extern rw_lock_t*	btr_search_latch_temp;
+extern rw_lock_t*	btr_search_latch_arr;
 
 #endif /* UNIV_HOTBACKUP */
 
-/** The latch protecting the adaptive search system */
-#define btr_search_latch	(*btr_search_latch_temp)
-
 /** Flag: has the search system been enabled?
-Protected by btr_search_latch. */
+Protected by all the btr_search_latch_arr latches: it is changed while
+holding all of them in x-mode and may be read while holding any one. */
 extern char	btr_search_enabled;
 
 #ifdef UNIV_BLOB_DEBUG
@@ -472,7 +472,7 @@ buf_page_get_known_nowait(
 /*******************************************************************//**
 Given a tablespace id and page number tries to get that page. If the
 page is not in the buffer pool it is not loaded and NULL is returned.
-Suitable for using when holding the lock_sys_t::mutex. */
+Suitable for using when holding the lock_sys_t::latch. */
 UNIV_INTERN
 const buf_block_t*
 buf_page_try_get_func(
@@ -484,7 +484,7 @@ buf_page_try_get_func(
 	mtr_t*		mtr);	/*!< in: mini-transaction */
 
 /** Tries to get a page. If the page is not in the buffer pool it is
-not loaded.  Suitable for using when holding the lock_sys_t::mutex.
+not loaded.  Suitable for using when holding the lock_sys_t::latch.
 @param space_id	in: tablespace id
 @param page_no	in: page number
 @param mtr	in: mini-transaction
@@ -1689,6 +1689,18 @@ struct buf_page_t{
 					and buf_pool->flush_list_mutex. Hence
 					reads can happen while holding
 					any one of the two mutexes */
+	ibool		page_image_logged;
+					/*!< TRUE if the modification
+					that made this block dirty
+					logged a full image of the page
+					(MLOG_PAGE_IMAGE), so that a
+					torn write of it can be
+					repaired from the redo log and
+					it can bypass the doublewrite
+					buffer. Set by the mtr holding
+					the page x-latch, reset when
+					the block is removed from the
+					flush list. */
 	/* @} */
 	/** @name LRU replacement algorithm fields
 	These fields are protected by buf_pool->mutex only (not
@@ -1834,7 +1846,8 @@ struct buf_block_t{
 
 	/** @name Hash search fields
 	These 5 fields may only be modified when we have
-	an x-latch on btr_search_latch AND
+	an x-latch on the adaptive hash index partition latch of
+	the index of the page (btr_search_get_latch()) AND
 	- we are holding an s-latch or x-latch on buf_block_t::lock or
 	- we know that buf_block_t::buf_fix_count == 0.
 
@@ -1842,7 +1855,8 @@ struct buf_block_t{
 	in the buffer pool in buf0buf.cc.
 
 	Another exception is that assigning block->index = NULL
-	is allowed whenever holding an x-latch on btr_search_latch. */
+	is allowed whenever holding x-latches on all of
+	btr_search_latch_arr. */
 
 	/* @{ */
 
@@ -2236,6 +2250,12 @@ struct buf_pool_t{
 					/*!< this is in the set state
 					when there is no flush batch
 					of the given type running */
+	latency_histogram flush_list_histogram;
+					/*!< latency of the flush list
+					batches run on this instance */
+	latency_histogram lru_flush_histogram;
+					/*!< latency of the LRU flush
+					batches run on this instance */
 	ib_rbt_t*	flush_rbt;	/*!< a red-black tree is used
 					exclusively during recovery to
 					speed up insertions in the
@@ -92,6 +92,18 @@ buf_dblwr_page_inside(
 /*==================*/
 	ulint	page_no);	/*!< in: page number */
 /********************************************************************//**
+Determines if a torn write of a page is to be repaired from a full image
+of the page logged when it is made dirty, rather than from the doublewrite
+buffer. This depends on innodb_log_page_images and on the page: the
+first page of a tablespace and the trx system page are read before the
+redo log is applied, and compressed pages are not covered.
+@return true if an image of the page should be logged */
+UNIV_INTERN
+bool
+buf_dblwr_use_page_image(
+/*=====================*/
+	const buf_block_t*	block);	/*!< in: block being made dirty */
+/********************************************************************//**
 Posts a buffer page for writing. If the doublewrite memory buffer is
 full, calls buf_dblwr_flush_buffered_writes and waits for for free
 space to appear. */
@@ -209,6 +209,25 @@ buf_flush_ready_for_replace(
 	buf_page_t*	bpage);	/*!< in: buffer control block, must be
 				buf_page_in_file(bpage) and in the LRU list */
 /******************************************************************//**
+Initializes the page cleaner pool when innodb_page_cleaners is greater
+than 1. Must be called before the page cleaner threads are created;
+the caller then creates srv_n_page_cleaners - 1 worker threads. */
+UNIV_INTERN
+void
+buf_flush_page_cleaner_init(void);
+/*=============================*/
+/******************************************************************//**
+page_cleaner worker thread. Runs the flush list and LRU batches that
+the page_cleaner and lru_manager threads request on the buffer pool
+instances.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(buf_flush_page_cleaner_worker)(
+/*==========================================*/
+	void*	arg);		/*!< in: a dummy parameter required by
+				os_thread_create */
+/******************************************************************//**
 page_cleaner thread tasked with flushing dirty pages from the buffer
 pools. As of now we'll have only one instance of this thread.
 @return a dummy parameter */
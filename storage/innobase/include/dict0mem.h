@@ -1204,7 +1204,7 @@ struct dict_table_t{
 				whether a transaction has locked the AUTOINC
 				lock we keep a pointer to the transaction
 				here in the autoinc_trx variable. This is to
-				avoid acquiring the lock_sys_t::mutex and
+				avoid acquiring the lock_sys_t::latch and
 				scanning the vector in trx_t.
 
 				When an AUTOINC lock has to wait, the
@@ -1234,7 +1234,7 @@ struct dict_table_t{
 				/*!< This counter is used to track the number
 				of granted and pending autoinc locks on this
 				table. This value is set after acquiring the
-				lock_sys_t::mutex but we peek the contents to
+				lock_sys_t::latch but we peek the contents to
 				determine whether other transactions have
 				acquired the AUTOINC lock or not. Of course
 				only one transaction can be granted the
@@ -1242,7 +1242,7 @@ struct dict_table_t{
 	const trx_t*	autoinc_trx;
 				/*!< The transaction that currently holds the
 				the AUTOINC lock on this table.
-				Protected by lock_sys->mutex. */
+				Protected by lock_sys->latch. */
 	fts_t*		fts;	/* FTS specific state variables */
 				/* @} */
 	/*----------------------*/
@@ -1258,7 +1258,9 @@ struct dict_table_t{
 				/*!< Count of the number of record locks on
 				this table. We use this to determine whether
 				we can evict the table from the dictionary
-				cache. It is protected by lock_sys->mutex. */
+				cache. It is updated with atomic operations,
+				because the record lock fast path increments
+				it under an S-latch on lock_sys->latch. */
 	ulint		n_ref_count;
 				/*!< count of how many handles are opened
 				to this table; dropping of the table is
@@ -1267,10 +1269,10 @@ struct dict_table_t{
 				open handles at drop */
 	ulint		lock_counter[LOCK_NUM];
 				/*!< Counter array for each table lock mode;
-				Protected by lock_sys::mutex */
+				Protected by lock_sys->latch */
 	UT_LIST_BASE_NODE_T(lock_t)
 			locks;	/*!< list of locks on the table; protected
-				by lock_sys->mutex */
+				by lock_sys->latch */
 #endif /* !UNIV_HOTBACKUP */
 
 #ifdef UNIV_DEBUG
@@ -58,7 +58,7 @@ struct lock_rec_t {
 					lock struct */
 };
 
-/** Lock struct; protected by lock_sys->mutex */
+/** Lock struct; protected by lock_sys->latch */
 struct lock_t {
 	trx_t*		trx;		/*!< transaction owning the
 					lock */
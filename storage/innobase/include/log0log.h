@@ -72,6 +72,10 @@ static const char ib_logfile_basename[] = "ib_logfile";
 /** Maximum number of log groups in log_group_t::checkpoint_buf */
 #define LOG_MAX_N_GROUPS	32
 
+/** Number of events that threads waiting for the log writer or flusher
+thread are spread over, by the log block of the lsn they wait for */
+#define LOG_N_WAIT_EVENTS	64
+
 /*******************************************************************//**
 Calculates where in log files we find a specified lsn.
 @return	log file number */
@@ -135,6 +139,35 @@ log_write_low(
 	byte*	str,		/*!< in: string */
 	ulint	str_len);	/*!< in: string length */
 /************************************************************//**
+Reserves space for a string in the log buffer, to be copied there by
+log_buffer_copy() after the log mutex has been released. The log block
+headers of the reserved space are written by this function. The caller
+must call log_buffer_copy_complete() when the string has been copied.
+@return	offset of the string in the log buffer */
+UNIV_INTERN
+ulint
+log_reserve_for_copy(
+/*=================*/
+	ulint	str_len);	/*!< in: string length */
+/************************************************************//**
+Copies a string to log buffer space reserved by log_reserve_for_copy(),
+skipping the log block headers and trailers. Does not need the log mutex.
+@return	offset in the log buffer where the copy ended */
+UNIV_INTERN
+ulint
+log_buffer_copy(
+/*============*/
+	ulint		offset,		/*!< in: offset in the log buffer */
+	const byte*	str,		/*!< in: string */
+	ulint		str_len);	/*!< in: string length */
+/************************************************************//**
+Signals that a string has been copied to the space reserved for it by
+log_reserve_for_copy(). */
+UNIV_INTERN
+void
+log_buffer_copy_complete(void);
+/*==========================*/
+/************************************************************//**
 Closes the log.
 @return	lsn */
 UNIV_INTERN
@@ -234,6 +267,40 @@ UNIV_INTERN
 void
 log_buffer_flush_to_disk(void);
 /*==========================*/
+/******************************************************************//**
+The log writer thread writes the log buffer to the log files when some
+thread has asked log_write_up_to() to write it.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(log_writer_thread)(
+/*==============================*/
+	void*	arg);	/*!< in: a dummy parameter required by
+			os_thread_create */
+/******************************************************************//**
+The log flusher thread flushes the written log to disk when some thread
+has asked log_write_up_to() to flush it.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(log_flusher_thread)(
+/*===============================*/
+	void*	arg);	/*!< in: a dummy parameter required by
+			os_thread_create */
+/******************************************************************//**
+Starts the log writer and flusher threads. */
+UNIV_INTERN
+void
+log_writer_threads_start(void);
+/*==========================*/
+/******************************************************************//**
+Stops the log writer and flusher threads, after they have written and
+flushed all log that was requested. log_write_up_to() does the writes
+itself afterwards. */
+UNIV_INTERN
+void
+log_writer_threads_stop(void);
+/*=========================*/
 /****************************************************************//**
 This functions writes the log buffer to the log file and if 'flush'
 is set it forces a flush of the log file as well. This is meant to be
@@ -848,6 +915,12 @@ struct log_t{
 					later; this is advanced when a flush
 					operation is completed to all the log
 					groups */
+	volatile ulint	n_pending_copies;/*!< number of strings that space
+					was reserved for with
+					log_reserve_for_copy() but that are
+					not yet copied to the buffer; the
+					buffer must not be written, moved or
+					reallocated while this is nonzero */
 	volatile bool	is_extending;	/*!< this is set to true during extend
 					the log buffer size */
 	lsn_t		written_to_some_lsn;
@@ -928,6 +1001,34 @@ struct log_t{
 
 	/* @} */
 
+	/** Fields of the log writer and flusher threads @{ */
+	volatile bool	writer_threads_active;
+					/*!< true while the log writer and
+					flusher threads serve
+					log_write_up_to() */
+	ulint		n_writer_threads;/*!< number of running log writer
+					and flusher threads; protected by
+					mutex */
+	lsn_t		write_requested_lsn;
+					/*!< the log writer thread writes
+					the log up to at least this lsn;
+					protected by mutex */
+	lsn_t		flush_requested_lsn;
+					/*!< the log flusher thread flushes
+					the log up to at least this lsn;
+					protected by mutex */
+	os_event_t	writer_event;	/*!< set to wake up the log writer
+					thread */
+	os_event_t	flusher_event;	/*!< set to wake up the log flusher
+					thread */
+	os_event_t*	write_events;	/*!< LOG_N_WAIT_EVENTS events that
+					threads waiting for the log to be
+					written wait for, picked by the log
+					block of the lsn waited for */
+	os_event_t*	flush_events;	/*!< like write_events, for threads
+					waiting for the log to be flushed */
+	/* @} */
+
 	/** Fields involved in checkpoints @{ */
 	lsn_t		log_group_capacity; /*!< capacity of the log group; if
 					the checkpoint age exceeds this, it is
@@ -32,6 +32,7 @@ Created 9/20/1997 Heikki Tuuri
 #include "hash0hash.h"
 #include "log0log.h"
 #include <list>
+#include <set>
 
 #ifdef UNIV_HOTBACKUP
 extern ibool	recv_replay_file_ops;
@@ -122,6 +123,21 @@ a freshly read page)
 */
 # define recv_recover_page(jri, block)	recv_recover_page_func(block)
 #endif /* !UNIV_HOTBACKUP */
+/************************************************************************//**
+Notes that a page read while log records are being applied failed its
+checksum check, as after a torn write of a page that bypassed the
+doublewrite buffer. If the records of the page in this batch start with a
+full image of it (MLOG_PAGE_IMAGE), the image replaces the page. Otherwise,
+if innodb_log_page_images is set, the records of the page are skipped
+until a later batch starts with an image of it, and
+recv_recovery_from_checkpoint_finish() reports the page if none does.
+@return	true if the page is to be repaired from an image */
+UNIV_INTERN
+bool
+recv_page_torn(
+/*===========*/
+	ulint	space,	/*!< in: space id */
+	ulint	page_no);/*!< in: page number */
 /********************************************************//**
 Recovers from a checkpoint. When this function returns, the database is able
 to start processing of new user transactions, but the function
@@ -403,6 +419,9 @@ struct recv_dblwr_t {
 	}
 };
 
+/** Set of (space id, page number) of pages waiting for a page image */
+typedef std::set<std::pair<ulint, ulint> >	recv_torn_pages_t;
+
 /** Recovery system data structure */
 struct recv_sys_t{
 #ifndef UNIV_HOTBACKUP
@@ -467,8 +486,45 @@ struct recv_sys_t{
 	hash_table_t*	addr_hash;/*!< hash table of file addresses of pages */
 	ulint		n_addrs;/*!< number of not processed hashed file
 				addresses in the hash table */
+#ifndef UNIV_HOTBACKUP
+	ulint		n_apply_parts;
+				/*!< number of partitions of addr_hash
+				that are applied in parallel in the
+				current batch */
+	ulint		apply_next_part;
+				/*!< next partition of addr_hash to be
+				claimed by an apply worker thread */
+	ulint		n_apply_workers;
+				/*!< number of apply worker threads that
+				have not finished their partition */
+	os_event_t	apply_workers_done;
+				/*!< set when n_apply_workers drops
+				to zero */
+	ib_uint64_t	scan_time;
+				/*!< microseconds spent reading and
+				parsing the log, excluding the apply
+				batches run during the scan */
+	ib_uint64_t	apply_time;
+				/*!< microseconds spent applying log
+				records to pages */
+	ib_uint64_t	flush_time;
+				/*!< microseconds spent flushing the
+				pages after apply batches */
+	ulint		n_apply_batches;
+				/*!< number of apply batches */
+	ulint		n_applied_pages;
+				/*!< number of pages that had log
+				records in the apply batches */
+#endif /* !UNIV_HOTBACKUP */
 
 	recv_dblwr_t	dblwr;
+
+	recv_torn_pages_t*
+			torn_pages;
+				/*!< (space id, page number) of the pages
+				that were read torn and wait for a page
+				image, see recv_page_torn(); protected by
+				mutex */
 };
 
 /** The recovery system */
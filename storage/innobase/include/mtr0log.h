@@ -74,6 +74,15 @@ mlog_log_string(
 	ulint	len,	/*!< in: string length */
 	mtr_t*	mtr);	/*!< in: mini-transaction handle */
 /********************************************************//**
+Writes a full image of an uncompressed page to the mini-transaction log,
+as an MLOG_PAGE_IMAGE record. */
+UNIV_INTERN
+void
+mlog_log_page_image(
+/*================*/
+	const buf_block_t*	block,	/*!< in: x-latched page */
+	mtr_t*			mtr);	/*!< in: mini-transaction handle */
+/********************************************************//**
 Writes initial part of a log record consisting of one-byte item
 type and four-byte space and page numbers. */
 UNIV_INTERN
@@ -205,6 +214,16 @@ mlog_parse_string(
 	byte*	end_ptr,/*!< in: buffer end */
 	byte*	page,	/*!< in: page where to apply the log record, or NULL */
 	void*	page_zip);/*!< in/out: compressed page, or NULL */
+/********************************************************//**
+Parses a log record written by mlog_log_page_image.
+@return	parsed record end, NULL if not a complete record */
+UNIV_INTERN
+byte*
+mlog_parse_page_image(
+/*==================*/
+	byte*	ptr,	/*!< in: buffer */
+	byte*	end_ptr,/*!< in: buffer end */
+	byte*	page);	/*!< in: page where to apply the log record, or NULL */
 
 #ifndef UNIV_HOTBACKUP
 /********************************************************//**
@@ -187,7 +187,11 @@ For 1 - 8 bytes, the flag value must give the length also! @{ */
 						without logging it's image */
 #define MLOG_ZIP_PAGE_REORGANIZE ((byte)53)	/*!< reorganize a compressed
 						page */
-#define MLOG_BIGGEST_TYPE	((byte)53)	/*!< biggest value (used in
+#define MLOG_PAGE_IMAGE		((byte)54)	/*!< full image of a page that
+						was made dirty, written in
+						place of a doublewrite
+						buffer copy */
+#define MLOG_BIGGEST_TYPE	((byte)54)	/*!< biggest value (used in
 						assertions) */
 /* @} */
 
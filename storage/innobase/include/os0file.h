@@ -77,6 +77,7 @@ extern char* innobase_histogram_step_size_log_write;
 extern char* innobase_histogram_step_size_double_write;
 extern char* innobase_histogram_step_size_file_flush_time;
 extern char* innobase_histogram_step_size_fsync;
+extern char* innobase_histogram_step_size_flush_batch;
 
 #ifdef __WIN__
 
@@ -513,6 +514,18 @@ extern latency_histogram histogram_double_write;
 extern latency_histogram histogram_file_flush_time;
 extern latency_histogram histogram_fsync;
 
+/**********************************************************************//**
+Prints the bins of a latency histogram in the output of
+SHOW ENGINE INNODB STATUS */
+void
+os_aio_print_histogram(
+/*===================*/
+	FILE*			file,			/*!< in: file where
+							     to print */
+	latency_histogram*	current_histogram);	/*!< in: Histogram
+							     whose bin values
+							     are being printed */
+
 /**************************************************************************
 Prints IO statistics. */
 
@@ -1208,6 +1221,28 @@ UNIV_INTERN
 void
 os_aio_free(void);
 /*=============*/
+/***********************************************************************
+Registers memory with the io_uring instances of the data file i/o
+arrays, so that reads and writes into it use fixed buffers and the
+kernel does not map the pages on every request. The memory is pinned
+once if the kernel can share the registration between the rings, and
+once per ring otherwise. This replaces any previous registration. Does
+nothing unless innodb_use_io_uring is in effect. */
+UNIV_INTERN
+void
+os_aio_register_buffers(
+/*====================*/
+	void* const*	bufs,	/*!< in: start of each buffer */
+	const ulint*	lens,	/*!< in: length of each buffer */
+	ulint		n);	/*!< in: number of buffers */
+/***********************************************************************
+Stops using and unregisters the buffers registered by
+os_aio_register_buffers(). Must be called before the memory is
+freed. */
+UNIV_INTERN
+void
+os_aio_unregister_buffers(void);
+/*===========================*/
 
 /*******************************************************************//**
 NOTE! Use the corresponding macro os_aio(), not directly this function!
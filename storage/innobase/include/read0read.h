@@ -57,6 +57,34 @@ read_view_purge_open(
 	mem_heap_t*	heap);		/*!< in: memory heap from which
 					allocated */
 /*********************************************************************//**
+Returns a read view for an autocommit non-locking read-only transaction.
+The view is shared with other such transactions for as long as no
+read-write transaction commits; while one is cached the call does not
+acquire trx_sys->mutex. The view must be closed with read_view_remove().
+@return	read view struct */
+UNIV_INTERN
+read_view_t*
+read_view_open_shared(
+/*==================*/
+	trx_t*		trx);		/*!< in: autocommit non-locking
+					read-only transaction */
+/*********************************************************************//**
+Drops the reference of a transaction on a shared read view. Does not
+acquire trx_sys->mutex; stale views are unlinked from the view list by
+later calls to read_view_open_shared() and read_view_purge_open(). */
+UNIV_INTERN
+void
+read_view_shared_release(
+/*=====================*/
+	const read_view_t*	view);	/*!< in: shared read view */
+/*********************************************************************//**
+Frees the shared read views at shutdown. The caller must own the
+trx_sys->mutex. */
+UNIV_INTERN
+void
+read_view_shared_close(void);
+/*========================*/
+/*********************************************************************//**
 Remove a read view from the trx_sys->view_list. */
 UNIV_INLINE
 void
@@ -156,6 +184,9 @@ struct read_view_t{
 	trx_id_t	creator_trx_id;
 				/*!< trx id of creating transaction, or
 				0 used in purge */
+	bool		shared;	/*!< true if the view is shared between
+				autocommit non-locking read-only
+				transactions, see read_view_open_shared() */
 	UT_LIST_NODE_T(read_view_t) view_list;
 				/*!< List of read views in trx_sys */
 };
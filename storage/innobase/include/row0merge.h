@@ -43,6 +43,10 @@ Created 13/06/2005 Jan Lindstrom
 // Forward declaration
 struct ib_sequence_t;
 
+/** Number of threads scanning the clustered index when creating
+secondary indexes */
+extern ulong	row_merge_scan_threads;
+
 /** @brief Block size for I/O operations in merge sort.
 
 The minimum is UNIV_PAGE_SIZE, or page_get_free_space_of_empty()
@@ -111,7 +115,9 @@ struct index_def_t {
 /** Structure for reporting duplicate records. */
 struct row_merge_dup_t {
 	dict_index_t*		index;	/*!< index being sorted */
-	struct TABLE*		table;	/*!< MySQL table object */
+	struct TABLE*		table;	/*!< MySQL table object,
+					or NULL to only count
+					the duplicates */
 	const ulint*		col_map;/*!< mapping of column numbers
 					in table to the rebuilt table
 					(index->table), or NULL if not
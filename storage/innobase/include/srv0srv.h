@@ -93,6 +93,10 @@ struct srv_stats_t {
 	doublewrite buffer */
 	ulint_ctr_1_t		dblwr_pages_written;
 
+	/** Number of full page images written to the redo log in place
+	of doublewrite buffer copies */
+	ulint_ctr_1_t		page_images_logged;
+
 	/** Store the number of write requests issued */
 	ulint_ctr_1_t		buf_pool_write_requests;
 
@@ -297,6 +301,12 @@ OS (provided we compiled Innobase with it in), otherwise we will
 use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 extern my_bool	srv_use_native_aio;
+/* If this flag is TRUE, then the Linux native aio uses io_uring instead
+of libaio, provided InnoDB was compiled with it */
+extern my_bool	srv_use_io_uring;
+/* Number of microseconds the read and write i/o threads busy poll the
+io_uring completion queue before sleeping in the kernel */
+extern ulong	srv_io_uring_poll_usecs;
 extern my_bool	srv_numa_interleave;
 #ifdef __WIN__
 extern ibool	srv_use_native_conditions;
@@ -332,6 +342,10 @@ extern ibool	srv_created_new_raw;
 /* Enables or disables this prefix optimization.  Disabled by default. */
 extern my_bool	srv_prefix_index_cluster_optimization;
 
+/* Look up the clustered index records of secondary index range scans in
+batches sorted by primary key. Disabled by default. */
+extern my_bool	srv_batched_cluster_reads;
+
 /** Maximum number of srv_n_log_files, or innodb_log_files_in_group */
 #define SRV_N_LOG_FILES_MAX 100
 extern ulong	srv_n_log_files;
@@ -340,6 +354,9 @@ extern ib_uint64_t	srv_log_file_size_requested;
 extern ulint	srv_log_buffer_size;
 extern ulong	srv_flush_log_at_trx_commit;
 extern uint	srv_flush_log_at_timeout;
+/** Whether dedicated log writer and flusher threads write and flush
+the redo log on behalf of the threads that wait for it */
+extern my_bool	srv_log_writer_threads;
 extern char	srv_adaptive_flushing;
 
 /* If this flag is TRUE, then we will load the indexes' (and tables') metadata
@@ -468,6 +485,21 @@ extern ulong	srv_use_doublewrite_buf;
 extern my_bool	srv_doublewrite_reset;
 extern ulong	srv_doublewrite_batch_size;
 
+/** Alternatives for innodb_log_page_images: the tablespaces whose pages
+are protected against torn writes by logging a full image of the page
+when it is made dirty, instead of by the doublewrite buffer. */
+enum srv_log_page_images_t {
+	SRV_LOG_PAGE_IMAGES_NONE = 0,	/*!< use the doublewrite buffer
+					for all pages */
+	SRV_LOG_PAGE_IMAGES_FILE_PER_TABLE,
+					/*!< log images for pages of
+					single-table tablespaces */
+	SRV_LOG_PAGE_IMAGES_ALL		/*!< log images for pages of all
+					tablespaces */
+};
+
+extern ulong	srv_log_page_images;
+
 extern double	srv_max_buf_pool_modified_pct;
 extern ulong	srv_max_purge_lag;
 extern ulong	srv_max_purge_lag_delay;
@@ -642,6 +674,9 @@ extern ulint srv_n_rollback_partial;
 extern atomic_stat<ulint>	srv_sec_rec_cluster_reads;
 /** Number of times prefix optimization avoided triggering cluster lookup */
 extern atomic_stat<ulint>	srv_sec_rec_cluster_reads_avoided;
+/** Number of batched cluster lookups that reused the leaf page of the
+previous lookup */
+extern atomic_stat<ulint>	srv_sec_rec_cluster_reads_page_reused;
 
 /** Perform deadlock detection check. */
 extern my_bool srv_deadlock_detect;
@@ -649,12 +684,24 @@ extern my_bool srv_deadlock_detect;
 /** Maximum number of deadlock detection steps allowed */
 extern uint srv_max_deadlock_detection_steps;
 
+/** Share read views between autocommit non-locking read-only
+transactions while no read-write transaction commits. */
+extern my_bool srv_read_view_cache;
+
 /* The maximum time limit for a single LRU tail flush iteration by the lru manager thread */
 extern ulint	srv_cleaner_max_lru_time;
 
 /* Enable adaptive sleep time calculation for page cleaner thread if enabled. */
 extern my_bool	srv_pc_adaptive_sleep;
 
+/** Number of page cleaner threads, including the coordinating
+page_cleaner thread itself */
+extern ulong	srv_n_page_cleaners;
+
+/** Number of threads that apply redo log records to pages in crash
+recovery, including the thread running the recovery */
+extern ulong	srv_n_recv_apply_threads;
+
 /*big_file_slow_removal speed*/
 extern ulong srv_slowrm_speed_mbps;
 
@@ -667,6 +714,7 @@ extern srv_stats_t	srv_stats;
 # ifdef UNIV_PFS_THREAD
 /* Keys to register InnoDB threads with performance schema */
 extern mysql_pfs_key_t	buf_page_cleaner_thread_key;
+extern mysql_pfs_key_t	buf_page_cleaner_worker_thread_key;
 extern mysql_pfs_key_t  buf_lru_manager_thread_key;
 extern mysql_pfs_key_t	trx_rollback_clean_thread_key;
 extern mysql_pfs_key_t	io_handler_thread_key;
@@ -676,6 +724,9 @@ extern mysql_pfs_key_t	srv_monitor_thread_key;
 extern mysql_pfs_key_t	srv_master_thread_key;
 extern mysql_pfs_key_t	srv_purge_thread_key;
 extern mysql_pfs_key_t	recv_writer_thread_key;
+extern mysql_pfs_key_t	recv_apply_thread_key;
+extern mysql_pfs_key_t	log_writer_thread_key;
+extern mysql_pfs_key_t	log_flusher_thread_key;
 extern mysql_pfs_key_t	srv_slowrm_thread_key;
 
 /* This macro register the current thread and its key with performance
@@ -867,7 +918,7 @@ srv_printf_innodb_monitor(
 /*======================*/
 	FILE*	file,		/*!< in: output stream */
 	ibool	nowait,		/*!< in: whether to wait for the
-				lock_sys_t::mutex */
+				lock_sys_t::latch */
 	ibool	include_trxs,	/*!< in: include per-transaction output */
 	srv_monitor_stats_types	status_type);	/*!< in: types of status info
 						to include */
@@ -1092,6 +1143,7 @@ struct export_var_t{
 
 	ulint innodb_dblwr_pages_written;	/*!< srv_dblwr_pages_written */
 	ulint innodb_dblwr_writes;		/*!< srv_dblwr_writes */
+	ulint innodb_page_images_logged;	/*!< srv_page_images_logged */
 	ulint innodb_hash_nonsearches;		/*!< btr_cur_n_sea */
 	ulint innodb_hash_searches;		/*!< btr_cur_n_non_sea */
 	ibool innodb_have_atomic_builtins;	/*!< HAVE_ATOMIC_BUILTINS */
@@ -1227,6 +1279,7 @@ struct export_var_t{
 
 	ulint innodb_sec_rec_cluster_reads;	/*!< srv_sec_rec_cluster_reads */
 	ulint innodb_sec_rec_cluster_reads_avoided; /*!< srv_sec_rec_cluster_reads_avoided */
+	ulint innodb_sec_rec_cluster_reads_page_reused; /*!< srv_sec_rec_cluster_reads_page_reused */
 
 	ulint innodb_defragment_compression_failures;
 	ulint innodb_defragment_failures;
@@ -1398,6 +1451,7 @@ struct srv_slot_t{
 #else /* !UNIV_HOTBACKUP */
 # define srv_use_adaptive_hash_indexes		FALSE
 # define srv_use_native_aio			FALSE
+# define srv_use_io_uring			FALSE
 # define srv_numa_interleave			FALSE
 # define srv_force_recovery			0UL
 # define srv_set_io_thread_op_info(t,info)	((void) 0)
@@ -92,6 +92,11 @@ UNIV_INTERN mysql_pfs_key_t	log_sys_mutex_key;
 UNIV_INTERN mysql_pfs_key_t	log_flush_order_mutex_key;
 #endif /* UNIV_PFS_MUTEX */
 
+#ifdef UNIV_PFS_THREAD
+UNIV_INTERN mysql_pfs_key_t	log_writer_thread_key;
+UNIV_INTERN mysql_pfs_key_t	log_flusher_thread_key;
+#endif /* UNIV_PFS_THREAD */
+
 #ifdef UNIV_DEBUG
 UNIV_INTERN ibool	log_do_write = TRUE;
 #endif /* UNIV_DEBUG */
@@ -184,6 +189,31 @@ log_buf_pool_get_oldest_modification(void)
 	return(lsn);
 }
 
+/************************************************************//**
+Waits until the strings that space was reserved for in the log buffer
+with log_reserve_for_copy() have been copied there. As the caller holds
+the log mutex, no new space can be reserved meanwhile. */
+static
+void
+log_wait_for_copies(void)
+/*=====================*/
+{
+	ulint	i = 0;
+
+	ut_ad(mutex_own(&(log_sys->mutex)));
+
+	/* The copying threads do not need any latch to finish. */
+	while (log_sys->n_pending_copies > 0) {
+		if (++i < SYNC_SPIN_ROUNDS) {
+			UT_RELAX_CPU();
+		} else {
+			os_thread_yield();
+		}
+	}
+
+	os_rmb;
+}
+
 /** Extends the log buffer.
 @param[in] len	requested minimum size in bytes */
 static
@@ -228,6 +258,9 @@ log_buffer_extend(
 		mutex_enter(&(log_sys->mutex));
 	}
 
+	/* The buffer is about to be freed. */
+	log_wait_for_copies();
+
 	move_start = ut_calc_align_down(
 		log_sys->buf_free,
 		OS_FILE_LOG_BLOCK_SIZE);
@@ -368,21 +401,25 @@ loop:
 }
 
 /************************************************************//**
-Writes to the log the string given. It is assumed that the caller holds the
-log mutex. */
-UNIV_INTERN
-void
-log_write_low(
-/*==========*/
-	byte*	str,		/*!< in: string */
+Reserves space for a string at the end of the log buffer and advances the
+lsn. The log block headers and trailers around the space are written, the
+string itself is not. It is assumed that the caller holds the log mutex.
+@return	offset of the string in the log buffer */
+static
+ulint
+log_reserve_low(
+/*============*/
 	ulint	str_len)	/*!< in: string length */
 {
 	log_t*	log	= log_sys;
+	ulint	offset;
 	ulint	len;
 	ulint	data_len;
 	byte*	log_block;
 
 	ut_ad(mutex_own(&(log->mutex)));
+
+	offset = log->buf_free;
 part_loop:
 	ut_ad(!recv_no_log_write);
 	/* Calculate a part length */
@@ -402,10 +439,7 @@ part_loop:
 			- LOG_BLOCK_TRL_SIZE;
 	}
 
-	ut_memcpy(log->buf + log->buf_free, str, len);
-
 	str_len -= len;
-	str = str + len;
 
 	log_block = static_cast<byte*>(
 		ut_align_down(
@@ -437,6 +471,97 @@ part_loop:
 	}
 
 	srv_stats.log_write_requests.inc();
+
+	return(offset);
+}
+
+/************************************************************//**
+Writes to the log the string given. It is assumed that the caller holds the
+log mutex. */
+UNIV_INTERN
+void
+log_write_low(
+/*==========*/
+	byte*	str,		/*!< in: string */
+	ulint	str_len)	/*!< in: string length */
+{
+	ut_ad(mutex_own(&(log_sys->mutex)));
+
+	log_buffer_copy(log_reserve_low(str_len), str, str_len);
+}
+
+/************************************************************//**
+Reserves space for a string in the log buffer, to be copied there by
+log_buffer_copy() after the log mutex has been released. The log block
+headers of the reserved space are written by this function. The caller
+must call log_buffer_copy_complete() when the string has been copied.
+@return	offset of the string in the log buffer */
+UNIV_INTERN
+ulint
+log_reserve_for_copy(
+/*=================*/
+	ulint	str_len)	/*!< in: string length */
+{
+	ut_ad(mutex_own(&(log_sys->mutex)));
+
+	os_atomic_increment_ulint(&log_sys->n_pending_copies, 1);
+
+	return(log_reserve_low(str_len));
+}
+
+/************************************************************//**
+Copies a string to log buffer space reserved by log_reserve_for_copy(),
+skipping the log block headers and trailers. Does not need the log mutex.
+@return	offset in the log buffer where the copy ended */
+UNIV_INTERN
+ulint
+log_buffer_copy(
+/*============*/
+	ulint		offset,		/*!< in: offset in the log buffer */
+	const byte*	str,		/*!< in: string */
+	ulint		str_len)	/*!< in: string length */
+{
+	while (str_len > 0) {
+		ulint	len;
+
+		/* Split the string as log_reserve_low() did. */
+		len = OS_FILE_LOG_BLOCK_SIZE - LOG_BLOCK_TRL_SIZE
+			- offset % OS_FILE_LOG_BLOCK_SIZE;
+
+		if (len > str_len) {
+			len = str_len;
+		}
+
+		ut_ad(offset + len <= log_sys->buf_size);
+
+		ut_memcpy(log_sys->buf + offset, str, len);
+
+		str += len;
+		str_len -= len;
+		offset += len;
+
+		if (offset % OS_FILE_LOG_BLOCK_SIZE
+		    == OS_FILE_LOG_BLOCK_SIZE - LOG_BLOCK_TRL_SIZE) {
+			/* Skip the trailer of the full block and the
+			header of the next one */
+			offset += LOG_BLOCK_TRL_SIZE + LOG_BLOCK_HDR_SIZE;
+		}
+	}
+
+	return(offset);
+}
+
+/************************************************************//**
+Signals that a string has been copied to the space reserved for it by
+log_reserve_for_copy(). */
+UNIV_INTERN
+void
+log_buffer_copy_complete(void)
+/*==========================*/
+{
+	/* This is a full memory barrier: the copied string is visible
+	to the thread that sees the count drop. */
+	os_atomic_decrement_ulint(&log_sys->n_pending_copies, 1);
 }
 
 /************************************************************//**
@@ -949,6 +1074,25 @@ log_init(void)
 
 	os_event_set(log_sys->one_flushed_event);
 
+	log_sys->n_pending_copies = 0;
+
+	log_sys->writer_threads_active = false;
+	log_sys->n_writer_threads = 0;
+	log_sys->write_requested_lsn = 0;
+	log_sys->flush_requested_lsn = 0;
+	log_sys->writer_event = os_event_create();
+	log_sys->flusher_event = os_event_create();
+
+	log_sys->write_events = static_cast<os_event_t*>(
+		mem_alloc(LOG_N_WAIT_EVENTS * sizeof(os_event_t)));
+	log_sys->flush_events = static_cast<os_event_t*>(
+		mem_alloc(LOG_N_WAIT_EVENTS * sizeof(os_event_t)));
+
+	for (ulint i = 0; i < LOG_N_WAIT_EVENTS; i++) {
+		log_sys->write_events[i] = os_event_create();
+		log_sys->flush_events[i] = os_event_create();
+	}
+
 	/*----------------------------*/
 
 	log_sys->next_checkpoint_no = 0;
@@ -1189,6 +1333,8 @@ log_sys_check_flush_completion(void)
 			/* Move the log buffer content to the start of the
 			buffer */
 
+			log_wait_for_copies();
+
 			move_start = ut_calc_align_down(
 				log_sys->write_end_offset,
 				OS_FILE_LOG_BLOCK_SIZE);
@@ -1476,14 +1622,13 @@ loop:
 }
 
 /******************************************************//**
-This function is called, e.g., when a transaction wants to commit. It checks
-that the log has been written to the log file up to the last log entry written
-by the transaction. If there is a flush running, it waits and checks if the
-flush flushed enough. If not, starts a new flush. */
-UNIV_INTERN
+Writes the log up to an lsn in the calling thread. If there is a flush
+running, it waits and checks if the flush flushed enough. If not, starts
+a new flush. */
+static
 void
-log_write_up_to(
-/*============*/
+log_write_up_to_low(
+/*================*/
 	lsn_t	lsn,	/*!< in: log sequence number up to which
 			the log should be written,
 			LSN_MAX if not specified */
@@ -1504,17 +1649,6 @@ log_write_up_to(
 #endif /* UNIV_DEBUG */
 	ulint		unlock;
 
-	ut_ad(!srv_read_only_mode);
-
-	log_sys->log_sync_callers[caller]++;
-
-	if (recv_no_ibuf_operations) {
-		/* Recovery is running and no operations on the log files are
-		allowed yet (the variable name .._no_ibuf_.. is misleading) */
-
-		return;
-	}
-
 loop:
 #ifdef UNIV_DEBUG
 	loop_count++;
@@ -1605,6 +1739,10 @@ loop:
 	os_event_reset(log_sys->no_flush_event);
 	os_event_reset(log_sys->one_flushed_event);
 
+	/* Strings that are still being copied to the buffer must be
+	complete before the buffer is written. */
+	log_wait_for_copies();
+
 	start_offset = log_sys->buf_next_to_write;
 	end_offset = log_sys->buf_free;
 
@@ -1716,6 +1854,422 @@ do_waits:
 	}
 }
 
+/******************************************************//**
+Checks if the log has been written, or written and flushed to disk, up to
+an lsn. Does not need the log mutex.
+@return	true if it has */
+UNIV_INLINE
+bool
+log_write_up_to_done(
+/*=================*/
+	lsn_t	lsn,		/*!< in: log sequence number */
+	ibool	flush_to_disk)	/*!< in: TRUE if the log must also
+				have been flushed to disk */
+{
+	os_rmb;
+
+	return(flush_to_disk
+	       ? log_sys->flushed_to_disk_lsn >= lsn
+	       : log_sys->written_to_all_lsn >= lsn);
+}
+
+/******************************************************//**
+Gets the event that threads waiting for the log writer or flusher thread
+to reach an lsn wait for.
+@return	event */
+UNIV_INLINE
+os_event_t
+log_get_wait_event(
+/*===============*/
+	os_event_t*	events,	/*!< in: write_events or flush_events */
+	lsn_t		lsn)	/*!< in: log sequence number waited for */
+{
+	return(events[(ulint) ((lsn / OS_FILE_LOG_BLOCK_SIZE)
+			       % LOG_N_WAIT_EVENTS)]);
+}
+
+/******************************************************//**
+Wakes up the threads that wait for the log writer or flusher thread to
+reach an lsn in a range. */
+static
+void
+log_wake_waiters(
+/*=============*/
+	os_event_t*	events,		/*!< in: write_events or
+					flush_events */
+	lsn_t		start_lsn,	/*!< in: lsn reached before */
+	lsn_t		end_lsn)	/*!< in: lsn reached now */
+{
+	lsn_t	block_no = start_lsn / OS_FILE_LOG_BLOCK_SIZE;
+	lsn_t	end_block_no = end_lsn / OS_FILE_LOG_BLOCK_SIZE;
+
+	if (end_block_no - block_no >= LOG_N_WAIT_EVENTS) {
+		block_no = end_block_no - (LOG_N_WAIT_EVENTS - 1);
+	}
+
+	for (; block_no <= end_block_no; block_no++) {
+		os_event_set(events[(ulint) (block_no % LOG_N_WAIT_EVENTS)]);
+	}
+}
+
+/******************************************************//**
+Asks the log writer thread, and the log flusher thread if the log is to
+be flushed to disk, to write the log up to an lsn, and waits for them if
+requested.
+@return	false if the threads were stopped before they reached the lsn */
+static
+bool
+log_write_up_to_by_threads(
+/*=======================*/
+	lsn_t	lsn,	/*!< in: log sequence number up to which
+			the log should be written,
+			LSN_MAX if not specified */
+	ulint	wait,	/*!< in: LOG_NO_WAIT, LOG_WAIT_ONE_GROUP,
+			or LOG_WAIT_ALL_GROUPS */
+	ibool	flush_to_disk)
+			/*!< in: TRUE if we want the written log
+			also to be flushed to disk */
+{
+	os_event_t	event;
+
+	mutex_enter(&(log_sys->mutex));
+
+	if (!log_sys->writer_threads_active) {
+		mutex_exit(&(log_sys->mutex));
+
+		return(false);
+	}
+
+	if (lsn > log_sys->lsn) {
+		lsn = log_sys->lsn;
+	}
+
+	if (log_write_up_to_done(lsn, flush_to_disk)) {
+		mutex_exit(&(log_sys->mutex));
+
+		return(true);
+	}
+
+	if (flush_to_disk) {
+		if (log_sys->flush_requested_lsn < lsn) {
+			log_sys->flush_requested_lsn = lsn;
+		}
+	} else if (log_sys->write_requested_lsn < lsn) {
+		log_sys->write_requested_lsn = lsn;
+	}
+
+	mutex_exit(&(log_sys->mutex));
+
+	os_event_set(log_sys->writer_event);
+
+	if (flush_to_disk) {
+		/* The log may have been written already. */
+		os_event_set(log_sys->flusher_event);
+	}
+
+	if (wait == LOG_NO_WAIT) {
+
+		return(true);
+	}
+
+	event = log_get_wait_event(flush_to_disk
+				   ? log_sys->flush_events
+				   : log_sys->write_events, lsn);
+
+	for (;;) {
+		ib_int64_t	sig_count = os_event_reset(event);
+
+		if (log_write_up_to_done(lsn, flush_to_disk)) {
+
+			return(true);
+		}
+
+		if (!log_sys->writer_threads_active) {
+
+			return(false);
+		}
+
+		os_event_wait_time_low(event, 100000, sig_count);
+	}
+}
+
+/******************************************************//**
+This function is called, e.g., when a transaction wants to commit. It checks
+that the log has been written to the log file up to the last log entry written
+by the transaction. If there is a flush running, it waits and checks if the
+flush flushed enough. If not, starts a new flush. With
+innodb_log_writer_threads, the write and the flush are left to the log
+writer and flusher threads. */
+UNIV_INTERN
+void
+log_write_up_to(
+/*============*/
+	lsn_t	lsn,	/*!< in: log sequence number up to which
+			the log should be written,
+			LSN_MAX if not specified */
+	ulint	wait,	/*!< in: LOG_NO_WAIT, LOG_WAIT_ONE_GROUP,
+			or LOG_WAIT_ALL_GROUPS */
+	ibool	flush_to_disk,
+			/*!< in: TRUE if we want the written log
+			also to be flushed to disk */
+	log_sync_type	caller)	/* in: identifies caller */
+{
+	ut_ad(!srv_read_only_mode);
+
+	log_sys->log_sync_callers[caller]++;
+
+	if (recv_no_ibuf_operations) {
+		/* Recovery is running and no operations on the log files are
+		allowed yet (the variable name .._no_ibuf_.. is misleading) */
+
+		return;
+	}
+
+	if (log_sys->writer_threads_active
+	    && log_write_up_to_by_threads(lsn, wait, flush_to_disk)) {
+
+		return;
+	}
+
+	log_write_up_to_low(lsn, wait, flush_to_disk, caller);
+}
+
+/******************************************************************//**
+The log writer thread writes the log buffer to the log files when some
+thread has asked log_write_up_to() to write it.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(log_writer_thread)(
+/*==============================*/
+	void*	arg MY_ATTRIBUTE((unused)))
+			/*!< in: a dummy parameter required by
+			os_thread_create */
+{
+	lsn_t	woken_lsn;
+
+	ut_ad(!srv_read_only_mode);
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(log_writer_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	mutex_enter(&(log_sys->mutex));
+	woken_lsn = log_sys->written_to_all_lsn;
+	mutex_exit(&(log_sys->mutex));
+
+	for (;;) {
+		ib_int64_t	sig_count;
+		lsn_t		lsn;
+		lsn_t		written_lsn;
+		bool		active;
+
+		sig_count = os_event_reset(log_sys->writer_event);
+
+		mutex_enter(&(log_sys->mutex));
+		lsn = ut_max(log_sys->write_requested_lsn,
+			     log_sys->flush_requested_lsn);
+		written_lsn = log_sys->written_to_all_lsn;
+		active = log_sys->writer_threads_active;
+		mutex_exit(&(log_sys->mutex));
+
+		if (lsn > written_lsn) {
+			/* This writes all of the log buffer, also the
+			log that was added after the request. */
+			log_write_up_to_low(lsn, LOG_WAIT_ALL_GROUPS, FALSE,
+					    LOG_WRITE_FROM_INTERNAL);
+
+			mutex_enter(&(log_sys->mutex));
+			written_lsn = log_sys->written_to_all_lsn;
+			mutex_exit(&(log_sys->mutex));
+		}
+
+		if (written_lsn > woken_lsn) {
+			log_wake_waiters(log_sys->write_events,
+					 woken_lsn, written_lsn);
+			woken_lsn = written_lsn;
+
+			os_event_set(log_sys->flusher_event);
+		}
+
+		if (!active) {
+			/* log_writer_threads_stop() was called before
+			this last round. */
+			break;
+		}
+
+		if (lsn <= written_lsn) {
+			os_event_wait_time_low(log_sys->writer_event,
+					       100000, sig_count);
+		}
+	}
+
+	mutex_enter(&(log_sys->mutex));
+	log_sys->n_writer_threads--;
+	mutex_exit(&(log_sys->mutex));
+
+	os_event_set(log_sys->flusher_event);
+
+	/* We count the number of threads in os_thread_exit(). A created
+	thread should always use that to exit and not use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/******************************************************************//**
+The log flusher thread flushes the written log to disk when some thread
+has asked log_write_up_to() to flush it.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(log_flusher_thread)(
+/*===============================*/
+	void*	arg MY_ATTRIBUTE((unused)))
+			/*!< in: a dummy parameter required by
+			os_thread_create */
+{
+	lsn_t	woken_lsn;
+
+	ut_ad(!srv_read_only_mode);
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(log_flusher_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	mutex_enter(&(log_sys->mutex));
+	woken_lsn = log_sys->flushed_to_disk_lsn;
+	mutex_exit(&(log_sys->mutex));
+
+	for (;;) {
+		ib_int64_t	sig_count;
+		lsn_t		requested_lsn;
+		lsn_t		written_lsn;
+		lsn_t		flushed_lsn;
+		bool		writer_exited;
+
+		sig_count = os_event_reset(log_sys->flusher_event);
+
+		mutex_enter(&(log_sys->mutex));
+		requested_lsn = log_sys->flush_requested_lsn;
+		written_lsn = log_sys->written_to_all_lsn;
+		flushed_lsn = log_sys->flushed_to_disk_lsn;
+		writer_exited = !log_sys->writer_threads_active
+			&& log_sys->n_writer_threads == 1;
+		mutex_exit(&(log_sys->mutex));
+
+		if (requested_lsn > flushed_lsn && written_lsn > flushed_lsn) {
+			/* With O_DSYNC and ALL_O_DIRECT the log writer
+			thread has flushed what it wrote. The log may be
+			written further while this flush is running. */
+			if (srv_unix_file_flush_method != SRV_UNIX_O_DSYNC
+			    && srv_unix_file_flush_method
+			    != SRV_UNIX_ALL_O_DIRECT) {
+
+				fil_flush(UT_LIST_GET_FIRST(
+						  log_sys->log_groups)
+					  ->space_id,
+					  FLUSH_FROM_LOG_WRITE_UP_TO);
+			}
+
+			mutex_enter(&(log_sys->mutex));
+
+			if (log_sys->flushed_to_disk_lsn < written_lsn) {
+				log_sys->flushed_to_disk_lsn = written_lsn;
+			}
+
+			log_sys->n_syncs++;
+			flushed_lsn = log_sys->flushed_to_disk_lsn;
+
+			mutex_exit(&(log_sys->mutex));
+		}
+
+		if (flushed_lsn > woken_lsn) {
+			log_wake_waiters(log_sys->flush_events,
+					 woken_lsn, flushed_lsn);
+			woken_lsn = flushed_lsn;
+		}
+
+		if (writer_exited) {
+			/* The log writer thread made its last write
+			before this round. */
+			break;
+		}
+
+		os_event_wait_time_low(log_sys->flusher_event, 100000,
+				       sig_count);
+	}
+
+	mutex_enter(&(log_sys->mutex));
+	log_sys->n_writer_threads--;
+	mutex_exit(&(log_sys->mutex));
+
+	/* We count the number of threads in os_thread_exit(). A created
+	thread should always use that to exit and not use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/******************************************************************//**
+Starts the log writer and flusher threads. */
+UNIV_INTERN
+void
+log_writer_threads_start(void)
+/*==========================*/
+{
+	ut_ad(!srv_read_only_mode);
+
+	mutex_enter(&(log_sys->mutex));
+
+	ut_ad(!log_sys->writer_threads_active);
+	ut_ad(log_sys->n_writer_threads == 0);
+
+	log_sys->writer_threads_active = true;
+	log_sys->n_writer_threads = 2;
+
+	mutex_exit(&(log_sys->mutex));
+
+	os_thread_create(log_writer_thread, NULL, NULL);
+	os_thread_create(log_flusher_thread, NULL, NULL);
+}
+
+/******************************************************************//**
+Stops the log writer and flusher threads, after they have written and
+flushed all log that was requested. log_write_up_to() does the writes
+itself afterwards. */
+UNIV_INTERN
+void
+log_writer_threads_stop(void)
+/*=========================*/
+{
+	ulint	n_threads;
+
+	mutex_enter(&(log_sys->mutex));
+
+	log_sys->writer_threads_active = false;
+	n_threads = log_sys->n_writer_threads;
+
+	mutex_exit(&(log_sys->mutex));
+
+	while (n_threads > 0) {
+		os_event_set(log_sys->writer_event);
+		os_event_set(log_sys->flusher_event);
+
+		os_thread_sleep(10000);
+
+		mutex_enter(&(log_sys->mutex));
+		n_threads = log_sys->n_writer_threads;
+		mutex_exit(&(log_sys->mutex));
+	}
+
+	/* Let the remaining waiters do their writes themselves. */
+	for (ulint i = 0; i < LOG_N_WAIT_EVENTS; i++) {
+		os_event_set(log_sys->write_events[i]);
+		os_event_set(log_sys->flush_events[i]);
+	}
+}
+
 /****************************************************************//**
 Does a syncronous flush of the log buffer to disk. */
 UNIV_INTERN
@@ -3396,6 +3950,9 @@ loop:
 		}
 	}
 
+	/* The writes that remain are done by this thread. */
+	log_writer_threads_stop();
+
 	mutex_enter(&log_sys->mutex);
 	server_busy = log_sys->n_pending_checkpoint_writes
 #ifdef UNIV_LOG_ARCHIVE
@@ -3839,6 +4396,21 @@ log_shutdown(void)
 	os_event_free(log_sys->no_flush_event);
 	os_event_free(log_sys->one_flushed_event);
 
+	ut_ad(log_sys->n_writer_threads == 0);
+
+	os_event_free(log_sys->writer_event);
+	os_event_free(log_sys->flusher_event);
+
+	for (ulint i = 0; i < LOG_N_WAIT_EVENTS; i++) {
+		os_event_free(log_sys->write_events[i]);
+		os_event_free(log_sys->flush_events[i]);
+	}
+
+	mem_free(log_sys->write_events);
+	log_sys->write_events = NULL;
+	mem_free(log_sys->flush_events);
+	log_sys->flush_events = NULL;
+
 	rw_lock_free(&log_sys->checkpoint_lock);
 
 	mutex_free(&log_sys->mutex);
@@ -166,6 +166,7 @@ UNIV_INTERN mysql_pfs_key_t	recv_sys_mutex_key;
 #ifndef UNIV_HOTBACKUP
 # ifdef UNIV_PFS_THREAD
 UNIV_INTERN mysql_pfs_key_t	recv_writer_thread_key;
+UNIV_INTERN mysql_pfs_key_t	recv_apply_thread_key;
 # endif /* UNIV_PFS_THREAD */
 
 # ifdef UNIV_PFS_MUTEX
@@ -208,6 +209,8 @@ recv_sys_create(void)
 #ifndef UNIV_HOTBACKUP
 	mutex_create(recv_writer_mutex_key, &recv_sys->writer_mutex,
 		     SYNC_LEVEL_VARYING);
+
+	recv_sys->apply_workers_done = os_event_create();
 #endif /* !UNIV_HOTBACKUP */
 
 	recv_sys->heap = NULL;
@@ -238,9 +241,14 @@ recv_sys_close(void)
 			mem_free(recv_sys->last_block_buf_start);
 		}
 
+		delete recv_sys->torn_pages;
+
 #ifndef UNIV_HOTBACKUP
 		ut_ad(!recv_writer_thread_active);
 		mutex_free(&recv_sys->writer_mutex);
+
+		ut_ad(recv_sys->n_apply_workers == 0);
+		os_event_free(recv_sys->apply_workers_done);
 #endif /* !UNIV_HOTBACKUP */
 
 		mutex_free(&recv_sys->mutex);
@@ -433,6 +441,8 @@ recv_sys_init(
 	/* Call the constructor for recv_sys_t::dblwr member */
 	new (&recv_sys->dblwr) recv_dblwr_t();
 
+	recv_sys->torn_pages = new recv_torn_pages_t();
+
 	mutex_exit(&(recv_sys->mutex));
 }
 
@@ -1320,6 +1330,11 @@ recv_parse_or_apply_log_rec_body(
 		ut_ad(!page || page_type != FIL_PAGE_TYPE_ALLOCATED);
 		ptr = mlog_parse_string(ptr, end_ptr, page, page_zip);
 		break;
+	case MLOG_PAGE_IMAGE:
+		/* Allow anything in page_type, the page is replaced. */
+		ut_a(!page_zip);
+		ptr = mlog_parse_page_image(ptr, end_ptr, page);
+		break;
 	case MLOG_FILE_RENAME:
 		/* Do not rerun file-based log entries if this is
 		IO completion from a page read. */
@@ -1507,6 +1522,11 @@ recv_add_to_hash_table(
 		fprintf(stderr, "Inserting log rec for space %lu, page %lu\n",
 			space, page_no);
 #endif
+	} else if (type == MLOG_PAGE_IMAGE) {
+		/* The image holds the page as it was at the end of its
+		mtr, the earlier records are not needed. They stay in
+		recv_sys->heap until the batch has been applied. */
+		UT_LIST_INIT(recv_addr->rec_list);
 	}
 
 	UT_LIST_ADD_LAST(rec_list, recv_addr->rec_list, recv);
@@ -1635,6 +1655,33 @@ recv_recover_page_func(
 		buf_block_get_space(block), buf_block_get_page_no(block));
 #endif
 
+	if (!recv_sys->torn_pages->empty()) {
+		recv_torn_pages_t::iterator	torn
+			= recv_sys->torn_pages->find(
+				std::make_pair(recv_addr->space,
+					       recv_addr->page_no));
+
+		if (torn == recv_sys->torn_pages->end()) {
+			/* The page was not torn. */
+		} else if (UT_LIST_GET_FIRST(recv_addr->rec_list)->type
+			   == MLOG_PAGE_IMAGE) {
+			/* The image replaces the torn page. */
+			recv_sys->torn_pages->erase(torn);
+		} else {
+			/* The records cannot be applied to a torn page,
+			an image of the page in a later batch will
+			make them obsolete. */
+			recv_addr->state = RECV_PROCESSED;
+
+			ut_a(recv_sys->n_addrs);
+			recv_sys->n_addrs--;
+
+			mutex_exit(&(recv_sys->mutex));
+
+			return;
+		}
+	}
+
 	recv_addr->state = RECV_BEING_PROCESSED;
 
 	mutex_exit(&(recv_sys->mutex));
@@ -1701,7 +1748,10 @@ recv_recover_page_func(
 			buf = ((byte*)(recv->data)) + sizeof(recv_data_t);
 		}
 
-		if (recv->type == MLOG_INIT_FILE_PAGE) {
+		if (recv->type == MLOG_INIT_FILE_PAGE
+		    || recv->type == MLOG_PAGE_IMAGE) {
+			/* The lsn on the page may have been written by
+			a torn write of a later version of the page. */
 			page_lsn = page_newest_lsn;
 
 			memset(FIL_PAGE_LSN + page, 0, 8);
@@ -1796,6 +1846,52 @@ recv_recover_page_func(
 
 }
 
+/************************************************************************//**
+Notes that a page read while log records are being applied failed its
+checksum check, as after a torn write of a page that bypassed the
+doublewrite buffer. If the records of the page in this batch start with a
+full image of it (MLOG_PAGE_IMAGE), the image replaces the page. Otherwise,
+if innodb_log_page_images is set, the records of the page are skipped
+until a later batch starts with an image of it, and
+recv_recovery_from_checkpoint_finish() reports the page if none does.
+@return	true if the page is to be repaired from an image */
+UNIV_INTERN
+bool
+recv_page_torn(
+/*===========*/
+	ulint	space,	/*!< in: space id */
+	ulint	page_no)/*!< in: page number */
+{
+	recv_addr_t*	recv_addr;
+	bool		torn = false;
+
+	mutex_enter(&(recv_sys->mutex));
+
+	if (recv_sys->apply_log_recs) {
+		recv_addr = recv_get_fil_addr_struct(space, page_no);
+
+		if (recv_addr != NULL
+		    && recv_addr->state != RECV_PROCESSED
+		    && UT_LIST_GET_LEN(recv_addr->rec_list) > 0
+		    && UT_LIST_GET_FIRST(recv_addr->rec_list)->type
+		    == MLOG_PAGE_IMAGE) {
+
+			/* The image in this batch replaces the page. */
+			torn = true;
+
+		} else if (srv_log_page_images != SRV_LOG_PAGE_IMAGES_NONE) {
+
+			recv_sys->torn_pages->insert(
+				std::make_pair(space, page_no));
+			torn = true;
+		}
+	}
+
+	mutex_exit(&(recv_sys->mutex));
+
+	return(torn);
+}
+
 #ifndef UNIV_HOTBACKUP
 /*******************************************************************//**
 Reads in pages which have hashed log records, from an area around a given
@@ -1845,9 +1941,134 @@ recv_read_in_area(
 	return(n);
 }
 
+/*******************************************************************//**
+Applies the hashed log records of one partition of recv_sys->addr_hash to
+the pages. The partition consists of every n_parts'th hash cell, starting
+from cell part, so that each page belongs to exactly one partition. Log
+records of pages that are in the buffer pool are applied by the calling
+thread; the other pages are read in, and the log records are applied to
+them by the i/o handler threads. */
+static
+void
+recv_apply_hashed_log_recs_part(
+/*============================*/
+	ulint	part,		/*!< in: partition number */
+	ulint	n_parts,	/*!< in: number of partitions */
+	ibool	print_progress)	/*!< in: whether to print the progress
+				in percent */
+{
+	recv_addr_t*	recv_addr;
+	ulint		n_cells;
+	ulint		i;
+	mtr_t		mtr;
+
+	n_cells = hash_get_n_cells(recv_sys->addr_hash);
+
+	mutex_enter(&(recv_sys->mutex));
+
+	for (i = part; i < n_cells; i += n_parts) {
+
+		for (recv_addr = static_cast<recv_addr_t*>(
+				HASH_GET_FIRST(recv_sys->addr_hash, i));
+		     recv_addr != 0;
+		     recv_addr = static_cast<recv_addr_t*>(
+				HASH_GET_NEXT(addr_hash, recv_addr))) {
+
+			ulint	space = recv_addr->space;
+			ulint	zip_size = fil_space_get_zip_size(space);
+			ulint	page_no = recv_addr->page_no;
+
+			if (recv_addr->state == RECV_NOT_PROCESSED) {
+
+				mutex_exit(&(recv_sys->mutex));
+
+				if (buf_page_peek(space, page_no)) {
+					buf_block_t*	block;
+
+					mtr_start(&mtr);
+
+					block = buf_page_get(
+						space, zip_size, page_no,
+						RW_X_LATCH, &mtr);
+					buf_block_dbg_add_level(
+						block, SYNC_NO_ORDER_CHECK);
+
+					recv_recover_page(FALSE, block);
+					mtr_commit(&mtr);
+				} else {
+					recv_read_in_area(space, zip_size,
+							  page_no);
+				}
+
+				mutex_enter(&(recv_sys->mutex));
+			}
+		}
+
+		if (print_progress
+		    && (i * 100) / n_cells
+		    != ((i + n_parts) * 100) / n_cells) {
+
+			fprintf(stderr, "%lu ", (ulong) ((i * 100) / n_cells));
+		}
+	}
+
+	mutex_exit(&(recv_sys->mutex));
+}
+
+/******************************************************************//**
+Worker thread that applies the hashed log records of one partition of
+recv_sys->addr_hash in an apply batch, next to the thread running
+recv_apply_hashed_log_recs().
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(recv_apply_thread)(
+/*==============================*/
+	void*	arg MY_ATTRIBUTE((unused)))
+			/*!< in: a dummy parameter required by
+			os_thread_create */
+{
+	ulint	part;
+	ulint	n_parts;
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(recv_apply_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	mutex_enter(&(recv_sys->mutex));
+
+	part = recv_sys->apply_next_part++;
+	n_parts = recv_sys->n_apply_parts;
+
+	mutex_exit(&(recv_sys->mutex));
+
+	ut_ad(part > 0);
+	ut_ad(part < n_parts);
+
+	recv_apply_hashed_log_recs_part(part, n_parts, FALSE);
+
+	mutex_enter(&(recv_sys->mutex));
+
+	ut_a(recv_sys->n_apply_workers > 0);
+
+	if (--recv_sys->n_apply_workers == 0) {
+		os_event_set(recv_sys->apply_workers_done);
+	}
+
+	mutex_exit(&(recv_sys->mutex));
+
+	/* We count the number of threads in os_thread_exit().
+	A created thread should always use that to exit and not
+	use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
 /*******************************************************************//**
 Empties the hash table of stored log records, applying them to appropriate
-pages. */
+pages. With innodb_recovery_apply_threads > 1 the pages are partitioned by
+their hash cell between that many threads. */
 UNIV_INTERN
 void
 recv_apply_hashed_log_recs(
@@ -1862,10 +2083,12 @@ recv_apply_hashed_log_recs(
 				the caller must in this case own the log
 				mutex */
 {
-	recv_addr_t* recv_addr;
-	ulint	i;
-	ibool	has_printed	= FALSE;
-	mtr_t	mtr;
+	ulint		i;
+	ulint		n_parts;
+	ulint		n_pages;
+	ibool		has_printed	= FALSE;
+	ib_uint64_t	start_time;
+	ib_uint64_t	apply_time;
 #ifdef XTRABACKUP
 	ulint	last_n_addrs = ULINT_MAX;
 	ulint	loops_since_change = 0;
@@ -1891,63 +2114,41 @@ loop:
 	recv_sys->apply_log_recs = TRUE;
 	recv_sys->apply_batch_on = TRUE;
 
-	for (i = 0; i < hash_get_n_cells(recv_sys->addr_hash); i++) {
+	start_time = ut_time_us(NULL);
+	n_pages = recv_sys->n_addrs;
 
-		for (recv_addr = static_cast<recv_addr_t*>(
-				HASH_GET_FIRST(recv_sys->addr_hash, i));
-		     recv_addr != 0;
-		     recv_addr = static_cast<recv_addr_t*>(
-				HASH_GET_NEXT(addr_hash, recv_addr))) {
-
-			ulint	space = recv_addr->space;
-			ulint	zip_size = fil_space_get_zip_size(space);
-			ulint	page_no = recv_addr->page_no;
+	if (n_pages > 0) {
+		ib_logf(IB_LOG_LEVEL_INFO,
+			"Starting an apply batch of log records"
+			" to the database...");
+		fputs("InnoDB: Progress in percent: ", stderr);
+		has_printed = TRUE;
+	}
 
-			if (recv_addr->state == RECV_NOT_PROCESSED) {
-				if (!has_printed) {
-					ib_logf(IB_LOG_LEVEL_INFO,
-						"Starting an apply batch"
-						" of log records"
-						" to the database...");
-					fputs("InnoDB: Progress in percent: ",
-					      stderr);
-					has_printed = TRUE;
-				}
+	/* There is no point in more threads than pages. */
+	n_parts = ut_min(srv_n_recv_apply_threads, ut_max(n_pages, 1));
 
-				mutex_exit(&(recv_sys->mutex));
+	recv_sys->n_apply_parts = n_parts;
+	recv_sys->apply_next_part = 1;
+	recv_sys->n_apply_workers = n_parts - 1;
 
-				if (buf_page_peek(space, page_no)) {
-					buf_block_t*	block;
+	os_event_reset(recv_sys->apply_workers_done);
 
-					mtr_start(&mtr);
+	mutex_exit(&(recv_sys->mutex));
 
-					block = buf_page_get(
-						space, zip_size, page_no,
-						RW_X_LATCH, &mtr);
-					buf_block_dbg_add_level(
-						block, SYNC_NO_ORDER_CHECK);
+	for (i = 1; i < n_parts; i++) {
+		os_thread_create(recv_apply_thread, NULL, NULL);
+	}
 
-					recv_recover_page(FALSE, block);
-					mtr_commit(&mtr);
-				} else {
-					recv_read_in_area(space, zip_size,
-							  page_no);
-				}
+	recv_apply_hashed_log_recs_part(0, n_parts, has_printed);
 
-				mutex_enter(&(recv_sys->mutex));
-			}
-		}
+	if (n_parts > 1) {
+		os_event_wait(recv_sys->apply_workers_done);
+	}
 
-		if (has_printed
-		    && (i * 100) / hash_get_n_cells(recv_sys->addr_hash)
-		    != ((i + 1) * 100)
-		    / hash_get_n_cells(recv_sys->addr_hash)) {
+	mutex_enter(&(recv_sys->mutex));
 
-			fprintf(stderr, "%lu ", (ulong)
-				((i * 100)
-				 / hash_get_n_cells(recv_sys->addr_hash)));
-		}
-	}
+	ut_ad(recv_sys->n_apply_workers == 0);
 
 	/* Wait until all the pages have been processed */
 
@@ -1983,6 +2184,15 @@ loop:
 		fprintf(stderr, "\n");
 	}
 
+	apply_time = ut_time_us(NULL) - start_time;
+
+	recv_sys->apply_time += apply_time;
+
+	if (n_pages > 0) {
+		recv_sys->n_apply_batches++;
+		recv_sys->n_applied_pages += n_pages;
+	}
+
 	if (!allow_ibuf) {
 		bool	success;
 
@@ -1993,6 +2203,8 @@ loop:
 		mutex_exit(&(recv_sys->mutex));
 		mutex_exit(&(log_sys->mutex));
 
+		start_time = ut_time_us(NULL);
+
 		/* Stop the recv_writer thread from issuing any LRU
 		flush batches. */
 		mutex_enter(&recv_sys->writer_mutex);
@@ -2015,6 +2227,8 @@ loop:
 		mutex_enter(&(recv_sys->mutex));
 		ut_d(recv_no_log_write = FALSE);
 
+		recv_sys->flush_time += ut_time_us(NULL) - start_time;
+
 		recv_no_ibuf_operations = FALSE;
 	}
 
@@ -2024,7 +2238,11 @@ loop:
 	recv_sys_empty_hash();
 
 	if (has_printed) {
-		fprintf(stderr, "InnoDB: Apply batch completed\n");
+		ib_logf(IB_LOG_LEVEL_INFO,
+			"Apply batch completed: %lu pages in %.2f seconds"
+			" using %lu threads",
+			(ulong) n_pages, (double) apply_time / 1000000,
+			(ulong) n_parts);
 	}
 
 	mutex_exit(&(recv_sys->mutex));
@@ -3076,6 +3294,8 @@ recv_recovery_from_checkpoint_start_func(
 	byte*           log_hdr_buf;
 	byte            log_hdr_mem[LOG_FILE_HDR_SIZE + OS_FILE_LOG_BLOCK_SIZE];
 	dberr_t		err;
+	ib_uint64_t	scan_start_time;
+	ib_uint64_t	batch_time;
 
 	/* Initialize red-black tree for fast insertions into the
 	flush_list during recovery process. */
@@ -3255,6 +3475,10 @@ recv_recovery_from_checkpoint_start_func(
 
 	/* Set the flag to publish that we are doing startup scan. */
 	recv_log_scan_is_startup_type = TYPE_CHECKPOINT;
+
+	scan_start_time = ut_time_us(NULL);
+	batch_time = recv_sys->apply_time + recv_sys->flush_time;
+
 	while (group) {
 #ifdef UNIV_LOG_ARCHIVE
 		lsn_t	old_scanned_lsn	= recv_sys->scanned_lsn;
@@ -3280,6 +3504,13 @@ recv_recovery_from_checkpoint_start_func(
 		group = UT_LIST_GET_NEXT(log_groups, group);
 	}
 
+	/* Do not count the apply batches that the scan had to run
+	because the hash table of log records grew too big. */
+	batch_time = recv_sys->apply_time + recv_sys->flush_time
+		- batch_time;
+	recv_sys->scan_time += ut_time_us(NULL) - scan_start_time
+		- batch_time;
+
 	/* Done with startup scan. Clear the flag. */
 	recv_log_scan_is_startup_type = FALSE;
 	if (TYPE_CHECKPOINT) {
@@ -3449,7 +3680,41 @@ recv_recovery_from_checkpoint_finish(void)
 
 	DBUG_PRINT("ib_log", ("apply completed"));
 
+	if (!recv_sys->torn_pages->empty()) {
+		for (recv_torn_pages_t::const_iterator it
+			     = recv_sys->torn_pages->begin();
+		     it != recv_sys->torn_pages->end();
+		     ++it) {
+			ib_logf(IB_LOG_LEVEL_ERROR,
+				"Database page corruption on disk or a failed"
+				" file read of space %lu page %lu, and the"
+				" redo log has no image of the page to"
+				" repair it from.",
+				(ulong) it->first, (ulong) it->second);
+		}
+
+		if (srv_force_recovery < SRV_FORCE_IGNORE_CORRUPT) {
+			ib_logf(IB_LOG_LEVEL_FATAL,
+				"Ending processing because of corrupt"
+				" database pages. Set innodb_force_recovery"
+				" to ignore this error.");
+		}
+
+		recv_sys->torn_pages->clear();
+	}
+
 	if (recv_needed_recovery) {
+		ib_logf(IB_LOG_LEVEL_INFO,
+			"Crash recovery took %.2f seconds to scan the log,"
+			" %.2f seconds to apply it to %lu pages in %lu"
+			" batches and %.2f seconds to flush the pages"
+			" between batches",
+			(double) recv_sys->scan_time / 1000000,
+			(double) recv_sys->apply_time / 1000000,
+			(ulong) recv_sys->n_applied_pages,
+			(ulong) recv_sys->n_apply_batches,
+			(double) recv_sys->flush_time / 1000000);
+
 		trx_sys_print_mysql_master_log_pos();
 		trx_sys_print_mysql_binlog_offset();
 	}
@@ -374,6 +374,41 @@ mlog_log_string(
 
 	mlog_catenate_string(mtr, ptr, len);
 }
+
+/********************************************************//**
+Writes a full image of an uncompressed page to the mini-transaction log,
+as an MLOG_PAGE_IMAGE record. */
+UNIV_INTERN
+void
+mlog_log_page_image(
+/*================*/
+	const buf_block_t*	block,	/*!< in: x-latched page */
+	mtr_t*			mtr)	/*!< in: mini-transaction handle */
+{
+	byte*	log_ptr;
+
+	ut_ad(mtr_memo_contains(mtr, block, MTR_MEMO_PAGE_X_FIX));
+	ut_ad(!buf_block_get_page_zip(block));
+
+	log_ptr = mlog_open(mtr, 11);
+
+	/* If no logging is requested, we may return now */
+	if (log_ptr == NULL) {
+
+		return;
+	}
+
+	/* The space id and page number are taken from the block
+	descriptor, the page frame of a page that this mtr allocated
+	may not have them yet. */
+	log_ptr = mlog_write_initial_log_record_for_file_op(
+		MLOG_PAGE_IMAGE, buf_block_get_space(block),
+		buf_block_get_page_no(block), log_ptr, mtr);
+
+	mlog_close(mtr, log_ptr);
+
+	mlog_catenate_string(mtr, buf_block_get_frame(block), UNIV_PAGE_SIZE);
+}
 #endif /* !UNIV_HOTBACKUP */
 
 /********************************************************//**
@@ -426,6 +461,32 @@ mlog_parse_string(
 	return(ptr + len);
 }
 
+/********************************************************//**
+Parses a log record written by mlog_log_page_image.
+@return	parsed record end, NULL if not a complete record */
+UNIV_INTERN
+byte*
+mlog_parse_page_image(
+/*==================*/
+	byte*	ptr,	/*!< in: buffer */
+	byte*	end_ptr,/*!< in: buffer end */
+	byte*	page)	/*!< in: page where to apply the log record, or NULL */
+{
+	if (end_ptr < ptr + UNIV_PAGE_SIZE) {
+
+		return(NULL);
+	}
+
+	if (page) {
+		/* The whole page is replaced, including a header or
+		trailer that a torn write may have left behind. The
+		page lsn is set by recv_recover_page(). */
+		memcpy(page, ptr, UNIV_PAGE_SIZE);
+	}
+
+	return(ptr + UNIV_PAGE_SIZE);
+}
+
 #ifndef UNIV_HOTBACKUP
 /********************************************************//**
 Opens a buffer for mlog, writes the initial log record and,
@@ -30,6 +30,7 @@ Created 11/26/1995 Heikki Tuuri
 #endif
 
 #include "buf0buf.h"
+#include "buf0dblwr.h"
 #include "buf0flu.h"
 #include "page0types.h"
 #include "mtr0log.h"
@@ -229,6 +230,107 @@ mtr_add_dirtied_pages_to_flush_list(
 	}
 }
 
+/************************************************************//**
+Logs a full image of the pages that the mtr makes dirty, if a torn write
+of them is to be repaired from the redo log rather than from the
+doublewrite buffer. The image follows the other log records of the mtr
+and holds the page as the mtr leaves it, recovery discards the earlier
+records for the page when it finds the image. */
+static
+void
+mtr_log_page_images(
+/*================*/
+	mtr_t*	mtr)	/*!< in/out: mtr */
+{
+	ulint	max_size;
+
+	if (srv_log_page_images == SRV_LOG_PAGE_IMAGES_NONE
+	    || !mtr->made_dirty
+	    || mtr->log_mode == MTR_LOG_NONE
+	    || mtr->log_mode == MTR_LOG_NO_REDO) {
+
+		return;
+	}
+
+	/* log_reserve_and_open() requires the mtr log to be smaller
+	than half of the log buffer, and recovery parses an mtr only
+	once all of it is in the parsing buffer. That buffer may still
+	hold up to a quarter of its size of parsed log, and must keep
+	room for the next log blocks. Pages that do not fit keep using
+	the doublewrite buffer. */
+	max_size = ut_min(log_sys->buf_size / 4,
+			  static_cast<ulint>(RECV_PARSING_BUF_SIZE
+					     - RECV_PARSING_BUF_SIZE / 4
+					     - 4 * OS_FILE_LOG_BLOCK_SIZE));
+
+	for (const dyn_block_t* block = dyn_array_get_first_block(&mtr->memo);
+	     block;
+	     block = dyn_array_get_next_block(&mtr->memo, block)) {
+		const mtr_memo_slot_t*	slot
+			= reinterpret_cast<mtr_memo_slot_t*>(
+				dyn_block_get_data(block));
+		const mtr_memo_slot_t*	end
+			= reinterpret_cast<mtr_memo_slot_t*>(
+				dyn_block_get_data(block)
+				+ dyn_block_get_used(block));
+
+		for (; slot != end; slot++) {
+			buf_block_t*	page_block;
+
+			if (slot->object == NULL
+			    || slot->type != MTR_MEMO_PAGE_X_FIX) {
+				continue;
+			}
+
+			page_block = static_cast<buf_block_t*>(slot->object);
+
+			/* Only the modification that makes the page
+			dirty logs the image. The page may be in the
+			memo more than once. */
+			if (!mtr_block_dirtied(page_block)
+			    || page_block->page.page_image_logged
+			    || !buf_dblwr_use_page_image(page_block)) {
+				continue;
+			}
+
+			if (dyn_array_get_data_size(&mtr->log)
+			    + UNIV_PAGE_SIZE > max_size) {
+				return;
+			}
+
+			mlog_log_page_image(page_block, mtr);
+
+			page_block->page.page_image_logged = TRUE;
+
+			srv_stats.page_images_logged.inc();
+		}
+	}
+}
+
+/************************************************************//**
+Copies the mini-transaction log to the space reserved for it in the log
+buffer by log_reserve_for_copy(). */
+static
+void
+mtr_log_copy(
+/*=========*/
+	mtr_t*	mtr,	/*!< in: mtr */
+	ulint	offset)	/*!< in: offset of the space in the log buffer */
+{
+	dyn_array_t*	mlog = &mtr->log;
+
+	for (dyn_block_t* block = mlog;
+	     block != 0;
+	     block = dyn_array_get_next_block(mlog, block)) {
+
+		offset = log_buffer_copy(
+			offset, dyn_block_get_data(block),
+			dyn_block_get_used(block));
+	}
+
+	log_buffer_copy_complete();
+}
+
 /************************************************************//**
 Writes the contents of a mini-transaction log, if any, to the database log. */
 static
@@ -240,6 +342,7 @@ mtr_log_reserve_and_write(
 	dyn_array_t*	mlog;
 	ulint		data_size;
 	byte*		first_data;
+	ulint		offset = ULINT_UNDEFINED;
 
 	ut_ad(!srv_read_only_mode);
 
@@ -275,20 +378,19 @@ mtr_log_reserve_and_write(
 
 	data_size = dyn_array_get_data_size(mlog);
 
-	/* Open the database log for log_write_low */
+	/* Open the database log for log_reserve_for_copy */
 	mtr->start_lsn = log_reserve_and_open(data_size);
 
 	if (mtr->log_mode == MTR_LOG_ALL) {
 
-		for (dyn_block_t* block = mlog;
-		     block != 0;
-		     block = dyn_array_get_next_block(mlog, block)) {
-
-			log_write_low(
-				dyn_block_get_data(block),
-				dyn_block_get_used(block));
-		}
-
+		/* Only the space is reserved while we hold the log
+		mutex. The log is copied to it after the mutex has been
+		released, in parallel with the copies of other mtrs. */
+		offset = log_reserve_for_copy(data_size);
+#ifdef UNIV_LOG_DEBUG
+		/* log_close() checks the records in the buffer. */
+		mtr_log_copy(mtr, offset);
+#endif /* UNIV_LOG_DEBUG */
 	} else {
 		ut_ad(mtr->log_mode == MTR_LOG_NONE
 		      || mtr->log_mode == MTR_LOG_NO_REDO);
@@ -298,6 +400,12 @@ mtr_log_reserve_and_write(
 	mtr->end_lsn = log_close();
 
 	mtr_add_dirtied_pages_to_flush_list(mtr);
+
+#ifndef UNIV_LOG_DEBUG
+	if (mtr->log_mode == MTR_LOG_ALL) {
+		mtr_log_copy(mtr, offset);
+	}
+#endif /* !UNIV_LOG_DEBUG */
 }
 #endif /* !UNIV_HOTBACKUP */
 
@@ -321,6 +429,7 @@ mtr_commit(
 
 	if (mtr->modifications && mtr->n_log_recs) {
 		ut_ad(!srv_read_only_mode);
+		mtr_log_page_images(mtr);
 		mtr_log_reserve_and_write(mtr);
 	}
 
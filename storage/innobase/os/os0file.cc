@@ -65,6 +65,11 @@ Created 10/21/1995 Heikki Tuuri
 #include <libaio.h>
 #endif
 
+#if defined(LINUX_IO_URING)
+#include <liburing.h>
+#include <algorithm>
+#endif
+
 /* Ignore posix_fadvise() on those platforms where it does not exist */
 #if defined __WIN__
 # define posix_fadvise(fd, offset, len, advice) /* nothing */
@@ -81,6 +86,7 @@ char* innobase_histogram_step_size_log_write  	= NULL;
 char* innobase_histogram_step_size_double_write = NULL;
 char* innobase_histogram_step_size_file_flush_time = NULL;
 char* innobase_histogram_step_size_fsync        = NULL;
+char* innobase_histogram_step_size_flush_batch  = NULL;
 
 /** Insert buffer segment id */
 static const ulint IO_IBUF_SEGMENT = 0;
@@ -271,6 +277,20 @@ struct os_aio_array_t{
 				/* Array of length n_segments. Each element
 				counts the number of not-submitted aio request
 				on that segment.*/
+#if defined(LINUX_IO_URING)
+	struct io_uring*	uring;
+				/* io_uring instances used instead of
+				aio_ctx when innodb_use_io_uring is set,
+				one per segment. Requests are queued and
+				submitted under the array mutex, each
+				ring is reaped only by the i/o thread of
+				its segment. Buffered requests sit in the
+				submission queue, counted by count[]. */
+	bool			uring_fixed;
+				/* true if requests may use the buffers
+				registered by os_aio_register_buffers().
+				Protected by the array mutex. */
+#endif /* LINUX_IO_URING */
 #endif /* LINUX_NATIV_AIO */
 };
 
@@ -285,6 +305,14 @@ struct os_aio_array_t{
 #define OS_AIO_IO_SETUP_RETRY_ATTEMPTS	5
 #endif
 
+#if defined(LINUX_IO_URING)
+/** Buffers registered with the io_uring instances, sorted by address */
+static struct iovec*	os_aio_uring_bufs = NULL;
+
+/** Number of elements in os_aio_uring_bufs */
+static ulint		os_aio_uring_n_bufs = 0;
+#endif /* LINUX_IO_URING */
+
 /** Array of events used in simulated aio */
 static os_event_t*	os_aio_segment_wait_events = NULL;
 
@@ -4001,6 +4029,316 @@ os_aio_native_aio_supported(void)
 }
 #endif /* LINUX_NATIVE_AIO */
 
+#if defined(LINUX_IO_URING)
+/******************************************************************//**
+Checks if the kernel supports io_uring with timed completion waits
+that do not use the submission queue (Linux 5.11), so that the i/o
+thread of a segment can wait while other threads submit.
+@return: TRUE if supported, FALSE otherwise. */
+static
+ibool
+os_aio_linux_uring_supported(void)
+/*==============================*/
+{
+	struct io_uring	ring;
+	int		ret;
+
+	ret = io_uring_queue_init(1, &ring, 0);
+
+	if (ret < 0) {
+		ib_logf(IB_LOG_LEVEL_ERROR,
+			"io_uring_queue_init() returned error[%d]", -ret);
+		return(FALSE);
+	}
+
+	ibool	supported = (ring.features & IORING_FEAT_EXT_ARG) != 0;
+
+	io_uring_queue_exit(&ring);
+
+	if (!supported) {
+		ib_logf(IB_LOG_LEVEL_ERROR,
+			"io_uring requires Linux 5.11 or later.");
+	}
+
+	return(supported);
+}
+
+/******************************************************************//**
+Marks the slots of the requests in the completion queue of an io_uring
+instance as done and removes them from the queue. The i/o threads find
+the slots in os_aio_linux_handle().
+@return number of completions reaped */
+static
+ulint
+os_aio_linux_uring_reap(
+/*====================*/
+	os_aio_array_t*	array,		/*!< in/out: aio array, its mutex
+					held */
+	ulint		segment,	/*!< in: local segment no. */
+	ulint		seg_size)	/*!< in: segment size. */
+{
+	struct io_uring*	ring = &array->uring[segment];
+	struct io_uring_cqe*	cqe;
+	ulint			start_pos = segment * seg_size;
+	unsigned		head;
+	unsigned		n_reaped = 0;
+
+	ut_ad(os_mutex_own(array->mutex));
+
+	io_uring_for_each_cqe(ring, head, cqe) {
+		os_aio_slot_t*	slot;
+
+		slot = static_cast<os_aio_slot_t*>(
+			io_uring_cqe_get_data(cqe));
+
+		/* Some sanity checks. */
+		ut_a(slot != NULL);
+		ut_a(slot->reserved);
+		ut_a(slot->pos >= start_pos);
+		ut_a(slot->pos < start_pos + seg_size);
+
+		/* Mark this request as completed. The error
+		handling will be done in the calling function. */
+		slot->n_bytes = cqe->res;
+		slot->ret = cqe->res < 0 ? cqe->res : 0;
+		slot->io_already_done = TRUE;
+
+		++n_reaped;
+	}
+
+	io_uring_cq_advance(ring, n_reaped);
+
+	return(n_reaped);
+}
+
+/******************************************************************//**
+Submits the requests queued on the io_uring instance of a segment.
+Retries while the kernel is short of resources, the requests cannot be
+taken back once they are in the submission queue.
+@return number of requests submitted */
+static
+ulint
+os_aio_linux_uring_submit(
+/*======================*/
+	os_aio_array_t*	array,		/*!< in/out: aio array, its mutex
+					held */
+	ulint		segment)	/*!< in: local segment no. */
+{
+	struct io_uring*	ring = &array->uring[segment];
+	int			ret;
+
+	ut_ad(os_mutex_own(array->mutex));
+
+	for (;;) {
+		bool	busy = false;
+
+		DBUG_EXECUTE_IF("io_uring_submit_busy",
+				DBUG_SET("-d,io_uring_submit_busy");
+				busy = true;);
+
+		ret = busy ? -EBUSY : io_uring_submit(ring);
+
+		if (ret >= 0) {
+			break;
+		}
+
+		switch (ret) {
+		case -EAGAIN:
+		case -EBUSY:
+			/* Completion queue full or out of memory. The
+			i/o thread of the segment needs array->mutex to
+			reap, which we hold, so reap here. Only if there
+			was nothing to reap wait for the kernel. */
+			if (os_aio_linux_uring_reap(
+				    array, segment,
+				    array->n_slots / array->n_segments)
+			    == 0) {
+				os_thread_sleep(1000);
+			}
+			/* fall through */
+		case -EINTR:
+			continue;
+		}
+
+		ut_print_timestamp(stderr);
+		fprintf(stderr,
+			" InnoDB: unexpected ret_code[%d] from"
+			" io_uring_submit()!\n", ret);
+		ut_error;
+	}
+
+	return(ret);
+}
+
+/******************************************************************//**
+Looks up the registered buffer that holds an i/o buffer.
+@return index of the registered buffer, -1 if none */
+static
+int
+os_aio_linux_uring_find_fixed(
+/*==========================*/
+	os_aio_array_t*	array,	/*!< in: aio array, its mutex held */
+	const byte*	buf,	/*!< in: i/o buffer */
+	ulint		len)	/*!< in: length of the buffer */
+{
+	ut_ad(os_mutex_own(array->mutex));
+
+	if (!array->uring_fixed) {
+		return(-1);
+	}
+
+	/* Binary search for the last buffer starting at or
+	before buf. */
+	ulint	low = 0;
+	ulint	high = os_aio_uring_n_bufs;
+
+	while (high - low > 1) {
+		ulint	mid = (low + high) / 2;
+
+		if ((const byte*) os_aio_uring_bufs[mid].iov_base <= buf) {
+			low = mid;
+		} else {
+			high = mid;
+		}
+	}
+
+	const byte*	base = (const byte*) os_aio_uring_bufs[low].iov_base;
+
+	if (buf >= base
+	    && buf + len <= base + os_aio_uring_bufs[low].iov_len) {
+		return(static_cast<int>(low));
+	}
+
+	return(-1);
+}
+
+/*******************************************************************//**
+Queues an AIO request on the io_uring of its segment and submits it,
+unless the read is buffered to be submitted in a batch by
+os_aio_linux_dispatch_read_array_submit().
+@return	TRUE on success. */
+static
+ibool
+os_aio_linux_uring_dispatch(
+/*========================*/
+	os_aio_array_t*	array,	/*!< in: io request array. */
+	os_aio_slot_t*	slot,	/*!< in: an already reserved slot. */
+	ibool		should_buffer)	/*!< in: should buffer the request
+					rather than submit. */
+{
+	struct io_uring*	ring;
+	struct io_uring_sqe*	sqe;
+	ulint			slots_per_segment;
+	ulint			seg;
+	ulint			submitted;
+	int			buf_index;
+
+	slots_per_segment = array->n_slots / array->n_segments;
+	seg = slot->pos / slots_per_segment;
+	ring = &array->uring[seg];
+
+	os_mutex_enter(array->mutex);
+
+	/* The ring has an entry for each slot of the segment. */
+	sqe = io_uring_get_sqe(ring);
+	ut_a(sqe != NULL);
+
+	buf_index = os_aio_linux_uring_find_fixed(array, slot->buf, slot->len);
+
+	if (slot->type == OS_FILE_READ) {
+		if (buf_index >= 0) {
+			io_uring_prep_read_fixed(
+				sqe, slot->file, slot->buf, slot->len,
+				slot->offset, buf_index);
+		} else {
+			io_uring_prep_read(
+				sqe, slot->file, slot->buf, slot->len,
+				slot->offset);
+		}
+	} else {
+		ut_a(slot->type == OS_FILE_WRITE);
+
+		if (buf_index >= 0) {
+			io_uring_prep_write_fixed(
+				sqe, slot->file, slot->buf, slot->len,
+				slot->offset, buf_index);
+		} else {
+			io_uring_prep_write(
+				sqe, slot->file, slot->buf, slot->len,
+				slot->offset);
+		}
+	}
+
+	io_uring_sqe_set_data(sqe, slot);
+
+	if (should_buffer && array == os_aio_read_array) {
+		ulint	count = ++array->count[seg];
+
+		os_mutex_exit(array->mutex);
+
+		if (count == slots_per_segment) {
+			os_aio_linux_dispatch_read_array_submit();
+		}
+
+		return(TRUE);
+	}
+
+	/* This also submits the reads buffered on the segment. */
+	submitted = os_aio_linux_uring_submit(array, seg);
+	array->count[seg] = 0;
+
+	os_mutex_exit(array->mutex);
+
+#if defined(HAVE_ATOMIC_BUILTINS) && UNIV_WORD_SIZE == 8
+	(void) os_atomic_increment_ulint(&os_aio_n_outstanding, submitted);
+#else /* !HAVE_ATOMIC_BUILTINS || UNIV_WORD == 8 */
+	os_mutex_enter(os_file_count_mutex);
+	os_aio_n_outstanding += submitted;
+	os_mutex_exit(os_file_count_mutex);
+#endif /* !HAVE_ATOMIC_BUILTINS || UNIV_WORD == 8 */
+
+	return(TRUE);
+}
+
+/******************************************************************//**
+Creates the io_uring instances of an aio array, one per segment.
+@return	TRUE on success. */
+static
+ibool
+os_aio_linux_uring_create(
+/*======================*/
+	os_aio_array_t*	array)	/*!< in/out: aio array */
+{
+	ulint	n_entries = array->n_slots / array->n_segments;
+
+	array->uring = static_cast<struct io_uring*>(
+		ut_malloc(array->n_segments * sizeof(*array->uring)));
+
+	for (ulint i = 0; i < array->n_segments; ++i) {
+		int	ret = io_uring_queue_init(
+			static_cast<unsigned>(n_entries),
+			&array->uring[i], 0);
+
+		if (ret < 0) {
+			ib_logf(IB_LOG_LEVEL_ERROR,
+				"io_uring_queue_init() returned error[%d]."
+				" You can disable io_uring by setting"
+				" innodb_use_io_uring = 0 in my.cnf",
+				-ret);
+			return(FALSE);
+		}
+	}
+
+	array->count = static_cast<ulint*>(
+		ut_malloc(array->n_segments * sizeof(ulint)));
+	memset(array->count, 0x0, sizeof(ulint) * array->n_segments);
+
+	array->uring_fixed = false;
+
+	return(TRUE);
+}
+#endif /* LINUX_IO_URING */
+
 /******************************************************************//**
 Creates an aio wait array. Note that we return NULL in case of failure.
 We don't care about freeing memory here because we assume that a
@@ -4054,6 +4392,18 @@ os_aio_array_create(
 		goto skip_native_aio;
 	}
 
+#if defined(LINUX_IO_URING)
+	array->uring = NULL;
+
+	if (srv_use_io_uring) {
+		if (!os_aio_linux_uring_create(array)) {
+			return(NULL);
+		}
+
+		goto skip_native_aio;
+	}
+#endif /* LINUX_IO_URING */
+
 	/* Initialize the io_context array. One io_context
 	per segment in the array. */
 
@@ -4136,6 +4486,16 @@ os_aio_array_free(
 	os_event_free(array->not_full);
 	os_event_free(array->is_empty);
 
+#if defined(LINUX_IO_URING)
+	if (srv_use_native_aio && srv_use_io_uring) {
+		for (ulint i = 0; i < array->n_segments; i++) {
+			io_uring_queue_exit(&array->uring[i]);
+		}
+
+		ut_free(array->uring);
+		ut_free(array->count);
+	} else
+#endif /* LINUX_IO_URING */
 #if defined(LINUX_NATIVE_AIO)
 	if (srv_use_native_aio) {
 		ut_free(array->aio_events);
@@ -4171,9 +4531,32 @@ os_aio_init(
 {
 	os_io_init_simple();
 
+#if !defined(LINUX_IO_URING)
+	if (srv_use_io_uring) {
+		ib_logf(IB_LOG_LEVEL_WARN,
+			"innodb_use_io_uring is ignored, InnoDB was"
+			" compiled without io_uring support.");
+
+		srv_use_io_uring = FALSE;
+	}
+#else
+	if (srv_use_io_uring
+	    && (!srv_use_native_aio || !os_aio_linux_uring_supported())) {
+
+		ib_logf(IB_LOG_LEVEL_WARN, "io_uring disabled.");
+
+		srv_use_io_uring = FALSE;
+	}
+
+	if (srv_use_io_uring) {
+		ib_logf(IB_LOG_LEVEL_INFO, "Using io_uring for native AIO");
+	}
+#endif /* !LINUX_IO_URING */
+
 #if defined(LINUX_NATIVE_AIO)
 	/* Check if native aio is supported on this system and tmpfs */
-	if (srv_use_native_aio && !os_aio_native_aio_supported()) {
+	if (srv_use_native_aio && !srv_use_io_uring
+	    && !os_aio_native_aio_supported()) {
 
 		ib_logf(IB_LOG_LEVEL_WARN, "Linux Native AIO disabled.");
 
@@ -4308,6 +4691,8 @@ void
 os_aio_free(void)
 /*=============*/
 {
+	os_aio_unregister_buffers();
+
 	if (os_aio_ibuf_array != 0) {
 		os_aio_array_free(os_aio_ibuf_array);
 	}
@@ -4343,6 +4728,187 @@ os_aio_free(void)
 	os_aio_n_segments = 0;
 }
 
+#if defined(LINUX_IO_URING)
+/***********************************************************************
+Orders registered buffers by address.
+@return true if a starts before b */
+static
+bool
+os_aio_uring_buf_less(
+/*==================*/
+	const struct iovec&	a,	/*!< in: buffer */
+	const struct iovec&	b)	/*!< in: buffer */
+{
+	return(a.iov_base < b.iov_base);
+}
+#endif /* LINUX_IO_URING */
+
+/***********************************************************************
+Registers memory with the io_uring instances of the data file i/o
+arrays, so that reads and writes into it use fixed buffers and the
+kernel does not map the pages on every request. The memory is pinned
+once if the kernel can share the registration between the rings, and
+once per ring otherwise. This replaces any previous registration. Does
+nothing unless innodb_use_io_uring is in effect. */
+UNIV_INTERN
+void
+os_aio_register_buffers(
+/*====================*/
+	void* const*	bufs,	/*!< in: start of each buffer */
+	const ulint*	lens,	/*!< in: length of each buffer */
+	ulint		n)	/*!< in: number of buffers */
+{
+#if defined(LINUX_IO_URING)
+	os_aio_array_t*	arrays[] = {
+		os_aio_read_array, os_aio_write_array, os_aio_ibuf_array
+	};
+
+	if (!srv_use_native_aio || !srv_use_io_uring) {
+		return;
+	}
+
+	os_aio_unregister_buffers();
+
+	if (n == 0) {
+		return;
+	}
+
+	os_aio_uring_bufs = static_cast<struct iovec*>(
+		ut_malloc(n * sizeof(*os_aio_uring_bufs)));
+
+	for (ulint i = 0; i < n; i++) {
+		os_aio_uring_bufs[i].iov_base = bufs[i];
+		os_aio_uring_bufs[i].iov_len = lens[i];
+	}
+
+	std::sort(os_aio_uring_bufs, os_aio_uring_bufs + n,
+		  os_aio_uring_buf_less);
+
+	os_aio_uring_n_bufs = n;
+
+	/* The buffers are pinned and accounted against RLIMIT_MEMLOCK
+	by the first ring only. The other rings share that registration
+	where the kernel can clone it (Linux 6.12), otherwise each of
+	them pins the memory again and the limit must cover the
+	registered memory times the number of rings. */
+	struct io_uring*	first = NULL;
+
+	for (ulint i = 0; i < UT_ARR_SIZE(arrays); i++) {
+		os_aio_array_t*	array = arrays[i];
+
+		if (array == NULL) {
+			continue;
+		}
+
+		for (ulint seg = 0; seg < array->n_segments; seg++) {
+			struct io_uring*	ring = &array->uring[seg];
+			int			ret = -EINVAL;
+
+#if defined(HAVE_IO_URING_CLONE_BUFFERS)
+			if (first != NULL) {
+				ret = io_uring_clone_buffers(ring, first);
+			}
+#endif /* HAVE_IO_URING_CLONE_BUFFERS */
+
+			if (ret < 0) {
+				ret = io_uring_register_buffers(
+					ring, os_aio_uring_bufs,
+					static_cast<unsigned>(n));
+			}
+
+			if (ret < 0) {
+				/* Usually RLIMIT_MEMLOCK is lower than
+				the memory to be pinned. */
+				ib_logf(IB_LOG_LEVEL_WARN,
+					"io_uring_register_buffers() returned"
+					" error[%d], the buffer pool i/o will"
+					" not use fixed buffers.", -ret);
+
+				os_aio_unregister_buffers();
+
+				return;
+			}
+
+			if (first == NULL) {
+				first = ring;
+			}
+		}
+	}
+
+	for (ulint i = 0; i < UT_ARR_SIZE(arrays); i++) {
+		if (arrays[i] != NULL) {
+			os_mutex_enter(arrays[i]->mutex);
+			arrays[i]->uring_fixed = true;
+			os_mutex_exit(arrays[i]->mutex);
+		}
+	}
+#endif /* LINUX_IO_URING */
+}
+
+/***********************************************************************
+Stops using and unregisters the buffers registered by
+os_aio_register_buffers(). Must be called before the memory is
+freed. */
+UNIV_INTERN
+void
+os_aio_unregister_buffers(void)
+/*===========================*/
+{
+#if defined(LINUX_IO_URING)
+	os_aio_array_t*	arrays[] = {
+		os_aio_read_array, os_aio_write_array, os_aio_ibuf_array
+	};
+
+	if (os_aio_uring_bufs == NULL) {
+		return;
+	}
+
+	for (ulint i = 0; i < UT_ARR_SIZE(arrays); i++) {
+		os_aio_array_t*	array = arrays[i];
+
+		if (array == NULL) {
+			continue;
+		}
+
+		os_mutex_enter(array->mutex);
+
+		array->uring_fixed = false;
+
+		/* Reads buffered for a batch may refer to the
+		registered buffers, hand them to the kernel now. */
+		for (ulint seg = 0; seg < array->n_segments; seg++) {
+			if (array->count[seg] > 0) {
+				ulint	submitted = os_aio_linux_uring_submit(
+					array, seg);
+
+				array->count[seg] = 0;
+#if defined(HAVE_ATOMIC_BUILTINS) && UNIV_WORD_SIZE == 8
+				(void) os_atomic_increment_ulint(
+					&os_aio_n_outstanding, submitted);
+#else /* !HAVE_ATOMIC_BUILTINS || UNIV_WORD == 8 */
+				os_mutex_enter(os_file_count_mutex);
+				os_aio_n_outstanding += submitted;
+				os_mutex_exit(os_file_count_mutex);
+#endif /* !HAVE_ATOMIC_BUILTINS || UNIV_WORD == 8 */
+			}
+		}
+
+		os_mutex_exit(array->mutex);
+
+		/* The kernel waits for the requests in flight before
+		it drops the registration. -ENXIO means that this
+		ring had nothing registered. */
+		for (ulint seg = 0; seg < array->n_segments; seg++) {
+			io_uring_unregister_buffers(&array->uring[seg]);
+		}
+	}
+
+	ut_free(os_aio_uring_bufs);
+	os_aio_uring_bufs = NULL;
+	os_aio_uring_n_bufs = 0;
+#endif /* LINUX_IO_URING */
+}
+
 #ifdef WIN_ASYNC_IO
 /************************************************************************//**
 Wakes up all async i/o threads in the array in Windows async i/o at
@@ -4623,8 +5189,9 @@ found:
 
 #elif defined(LINUX_NATIVE_AIO)
 
-	/* If we are not using native AIO skip this part. */
-	if (!srv_use_native_aio) {
+	/* If we are not using native AIO skip this part. io_uring
+	requests are prepared when they are dispatched. */
+	if (!srv_use_native_aio || srv_use_io_uring) {
 		goto skip_native_aio;
 	}
 
@@ -4840,18 +5407,27 @@ os_aio_linux_dispatch_read_array_submit()
 		}
 		/* Batch and submit all requests from the segment. */
 		slots_per_segment = array->n_slots / array->n_segments;
-		iocb_index = i * slots_per_segment;
-		submitted = io_submit(array->aio_ctx[i], count,
-				      &(array->pending[iocb_index]));
-		if (submitted <= 0) {
-			/* io_submit returns number of successfully
-			queued requests or -errno. */
-			errno = -submitted;
-			break;
+#if defined(LINUX_IO_URING)
+		if (srv_use_io_uring) {
+			/* The requests are already queued in the ring
+			of the segment. */
+			submitted = os_aio_linux_uring_submit(array, i);
+		} else
+#endif /* LINUX_IO_URING */
+		{
+			iocb_index = i * slots_per_segment;
+			submitted = io_submit(array->aio_ctx[i], count,
+					      &(array->pending[iocb_index]));
+			if (submitted <= 0) {
+				/* io_submit returns number of successfully
+				queued requests or -errno. */
+				errno = -submitted;
+				break;
+			}
+			/* Reset the aio request buffer. */
+			memset(&array->pending[iocb_index], 0x0,
+			       sizeof(struct iocb*) * slots_per_segment);
 		}
-		/* Reset the aio request buffer. */
-		memset(&array->pending[iocb_index], 0x0,
-		       sizeof(struct iocb*) * slots_per_segment);
 		array->count[i] = 0;
 		os_mutex_exit(array->mutex);
 
@@ -4899,6 +5475,12 @@ os_aio_linux_dispatch(
 	ut_ad(array);
 	ut_a(slot->reserved);
 
+#if defined(LINUX_IO_URING)
+	if (srv_use_io_uring) {
+		return(os_aio_linux_uring_dispatch(array, slot, should_buffer));
+	}
+#endif /* LINUX_IO_URING */
+
 	/* Find out what we are going to work with.
 	The iocb struct is directly in the slot.
 	The io_context is one per segment. */
@@ -5601,6 +6183,84 @@ retry:
 	ut_error;
 }
 
+#if defined(LINUX_IO_URING)
+/******************************************************************//**
+io_uring counterpart of os_aio_linux_collect(). The read and write i/o
+threads first busy poll the completion queue for
+innodb_io_uring_poll_usecs, which saves the wakeup latency on fast
+devices. Then the thread waits in the kernel with the same timeout as
+io_getevents(), so that it notices shutdown. Unlike
+os_aio_linux_collect() this returns on timeout, the caller checks the
+server state and calls again. */
+static
+void
+os_aio_linux_uring_collect(
+/*=======================*/
+	os_aio_array_t* array,		/*!< in/out: slot array. */
+	ulint		segment,	/*!< in: local segment no. */
+	ulint		seg_size)	/*!< in: segment size. */
+{
+	struct io_uring*	ring;
+	struct io_uring_cqe*	cqe;
+	ulint			poll_usecs;
+	int			ret;
+
+	ut_ad(array != NULL);
+	ut_ad(seg_size > 0);
+	ut_ad(segment < array->n_segments);
+
+	ring = &array->uring[segment];
+
+	ret = io_uring_peek_cqe(ring, &cqe);
+
+	poll_usecs = (array == os_aio_read_array
+		      || array == os_aio_write_array)
+		? srv_io_uring_poll_usecs : 0;
+
+	if (ret == -EAGAIN && poll_usecs > 0) {
+		ullint	start_time = ut_time_us(NULL);
+
+		do {
+			UT_RELAX_CPU();
+			ret = io_uring_peek_cqe(ring, &cqe);
+		} while (ret == -EAGAIN
+			 && ut_time_us(NULL) - start_time < poll_usecs);
+	}
+
+	if (ret == -EAGAIN) {
+		struct __kernel_timespec	timeout;
+
+		timeout.tv_sec = 0;
+		timeout.tv_nsec = OS_AIO_REAP_TIMEOUT;
+
+		ret = io_uring_wait_cqe_timeout(ring, &cqe, &timeout);
+	}
+
+	if (ret == 0) {
+		os_mutex_enter(array->mutex);
+		os_aio_linux_uring_reap(array, segment, seg_size);
+		os_mutex_exit(array->mutex);
+
+		return;
+	}
+
+	switch (ret) {
+	case -ETIME:
+		/* No completion before the timeout. */
+	case -EINTR:
+	case -EAGAIN:
+		return;
+	}
+
+	/* All other errors should cause a trap for now. */
+	ut_print_timestamp(stderr);
+	fprintf(stderr,
+		" InnoDB: unexpected ret_code[%d] from"
+		" io_uring_wait_cqe_timeout()!\n", ret);
+	ut_error;
+}
+#endif /* LINUX_IO_URING */
+
 /**********************************************************************//**
 This function is only used in Linux native asynchronous i/o.
 Waits for an aio operation to complete. This function is used to wait for
@@ -5677,6 +6337,12 @@ os_aio_linux_handle(
 
 		srv_set_io_thread_op_info(global_seg,
 			"waiting for completed aio requests");
+#if defined(LINUX_IO_URING)
+		if (srv_use_io_uring) {
+			os_aio_linux_uring_collect(array, segment, n);
+			continue;
+		}
+#endif /* LINUX_IO_URING */
 		os_aio_linux_collect(array, segment, n);
 	}
 
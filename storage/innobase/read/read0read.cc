@@ -192,6 +192,7 @@ read_view_create_low(
 
 	view->n_trx_ids = n;
 	view->trx_ids = (trx_id_t*) &view[1];
+	view->shared = false;
 
 	return(view);
 }
@@ -392,6 +393,253 @@ read_view_open_now(
 	return(view);
 }
 
+/** Number of read views that can be shared at a time between
+autocommit non-locking read-only transactions */
+#define READ_VIEW_N_SHARED	4
+
+/** read_view_shared_t::version of a slot that holds no usable view */
+#define READ_VIEW_SHARED_NONE	0
+
+/** A read view that is shared between autocommit non-locking read-only
+transactions. The view and in_view_list are protected by trx_sys->mutex.
+The version is only written by the holder of trx_sys->mutex but is read
+without it. n_ref is updated with atomic operations only. */
+struct read_view_shared_t {
+	read_view_t*	view;		/*!< the view, or NULL */
+	mem_heap_t*	heap;		/*!< heap the view is allocated
+					from, or NULL */
+	volatile ulint	version;	/*!< trx_sys->mvcc_version at which
+					the view was built, or
+					READ_VIEW_SHARED_NONE */
+	volatile ulint	n_ref;		/*!< number of transactions using
+					the view, plus any readers that are
+					about to validate the version */
+	bool		in_view_list;	/*!< true if the view is in
+					trx_sys->view_list */
+};
+
+/** The shared read views */
+static read_view_shared_t	read_view_shared[READ_VIEW_N_SHARED];
+
+/** Index of the most recently built shared read view */
+static volatile ulint		read_view_shared_current;
+
+/*********************************************************************//**
+Unlinks the shared read views that were built at an older version than
+the current one and are no longer referenced. A referenced stale view
+stays in the view list until a later call finds it unused. */
+static
+void
+read_view_shared_retire_stale(
+/*==========================*/
+	ulint	version)	/*!< in: current trx_sys->mvcc_version */
+{
+	ut_ad(mutex_own(&trx_sys->mutex));
+
+	for (ulint i = 0; i < READ_VIEW_N_SHARED; ++i) {
+		read_view_shared_t*	slot = &read_view_shared[i];
+		ulint			old_version = slot->version;
+
+		if (old_version == version || !slot->in_view_list) {
+			continue;
+		}
+
+		/* Readers increment n_ref before validating the version,
+		we invalidate the version before checking n_ref. The atomic
+		operations on both sides are full barriers, so either the
+		reader sees READ_VIEW_SHARED_NONE or we see its reference. */
+
+		if (old_version != READ_VIEW_SHARED_NONE) {
+			os_compare_and_swap_ulint(
+				&slot->version, old_version,
+				READ_VIEW_SHARED_NONE);
+		}
+
+		ut_ad(slot->version == READ_VIEW_SHARED_NONE);
+
+		if (slot->n_ref == 0) {
+			UT_LIST_REMOVE(
+				view_list, trx_sys->view_list, slot->view);
+			slot->in_view_list = false;
+		}
+	}
+}
+
+/*********************************************************************//**
+Returns a read view for an autocommit non-locking read-only transaction.
+The view is shared with other such transactions for as long as no
+read-write transaction commits; while one is cached the call does not
+acquire trx_sys->mutex. The view must be closed with read_view_remove().
+@return	read view struct */
+UNIV_INTERN
+read_view_t*
+read_view_open_shared(
+/*==================*/
+	trx_t*		trx)		/*!< in: autocommit non-locking
+					read-only transaction */
+{
+	ulint			version;
+	read_view_shared_t*	slot;
+	read_view_t*		view;
+
+	ut_ad(trx_is_autocommit_non_locking(trx));
+
+	version = trx_sys->mvcc_version;
+	os_rmb;
+
+	slot = &read_view_shared[read_view_shared_current];
+
+	if (slot->version == version) {
+
+		os_atomic_increment_ulint(&slot->n_ref, 1);
+
+		if (slot->version == version) {
+			/* The view is published before the version. */
+			os_rmb;
+
+			return(slot->view);
+		}
+
+		os_atomic_decrement_ulint(&slot->n_ref, 1);
+	}
+
+	mutex_enter(&trx_sys->mutex);
+
+	version = trx_sys->mvcc_version;
+	os_rmb;
+
+	/* Another transaction may have built the view meanwhile. The
+	version cannot be invalidated while we hold the mutex. */
+
+	for (ulint i = 0; i < READ_VIEW_N_SHARED; ++i) {
+		slot = &read_view_shared[i];
+
+		if (slot->version == version) {
+
+			os_atomic_increment_ulint(&slot->n_ref, 1);
+
+			view = slot->view;
+
+			mutex_exit(&trx_sys->mutex);
+
+			return(view);
+		}
+	}
+
+	read_view_shared_retire_stale(version);
+
+	slot = NULL;
+
+	for (ulint i = 0; i < READ_VIEW_N_SHARED; ++i) {
+		if (!read_view_shared[i].in_view_list
+		    && read_view_shared[i].n_ref == 0) {
+
+			slot = &read_view_shared[i];
+			break;
+		}
+	}
+
+	if (slot == NULL) {
+		/* All shared views are still in use by transactions
+		that started before the latest commit. */
+
+		view = read_view_open_now_low(
+			trx->id, trx->global_read_view_heap);
+
+		mutex_exit(&trx_sys->mutex);
+
+		return(view);
+	}
+
+	if (slot->heap == NULL) {
+		slot->heap = mem_heap_create(256);
+	} else {
+		mem_heap_empty(slot->heap);
+	}
+
+	/* A transaction that became committed in memory after we read
+	the version may or may not be visible in the view; either is
+	fine, because it would not be visible to a view validated at
+	the version we read. */
+
+	view = read_view_open_now_low(trx->id, slot->heap);
+	view->shared = true;
+
+	slot->view = view;
+	slot->in_view_list = true;
+
+	os_atomic_increment_ulint(&slot->n_ref, 1);
+
+	/* Publish the view before the version it is valid for. */
+	os_wmb;
+
+	slot->version = version;
+	read_view_shared_current = slot - read_view_shared;
+
+	mutex_exit(&trx_sys->mutex);
+
+	return(view);
+}
+
+/*********************************************************************//**
+Drops the reference of a transaction on a shared read view. Does not
+acquire trx_sys->mutex; stale views are unlinked from the view list by
+later calls to read_view_open_shared() and read_view_purge_open(). */
+UNIV_INTERN
+void
+read_view_shared_release(
+/*=====================*/
+	const read_view_t*	view)	/*!< in: shared read view */
+{
+	ut_ad(view->shared);
+
+	for (ulint i = 0; i < READ_VIEW_N_SHARED; ++i) {
+		read_view_shared_t*	slot = &read_view_shared[i];
+
+		/* The slot cannot be rebuilt while we hold a reference. */
+
+		if (slot->view == view) {
+			ut_ad(slot->n_ref > 0);
+
+			os_atomic_decrement_ulint(&slot->n_ref, 1);
+
+			return;
+		}
+	}
+
+	ut_error;
+}
+
+/*********************************************************************//**
+Frees the shared read views at shutdown. The caller must own the
+trx_sys->mutex. */
+UNIV_INTERN
+void
+read_view_shared_close(void)
+/*========================*/
+{
+	ut_ad(mutex_own(&trx_sys->mutex));
+
+	for (ulint i = 0; i < READ_VIEW_N_SHARED; ++i) {
+		read_view_shared_t*	slot = &read_view_shared[i];
+
+		ut_a(slot->n_ref == 0);
+
+		if (slot->in_view_list) {
+			UT_LIST_REMOVE(
+				view_list, trx_sys->view_list, slot->view);
+		}
+
+		if (slot->heap != NULL) {
+			mem_heap_free(slot->heap);
+		}
+
+		memset(slot, 0x0, sizeof(*slot));
+	}
+
+	read_view_shared_current = 0;
+}
+
 /*********************************************************************//**
 Makes a copy of the oldest existing read view, with the exception that also
 the creating trx of the oldest view is set as not visible in the 'copied'
@@ -413,6 +661,9 @@ read_view_purge_open(
 
 	mutex_enter(&trx_sys->mutex);
 
+	/* Do not let an unused shared view hold back purge. */
+	read_view_shared_retire_stale(trx_sys->mvcc_version);
+
 	oldest_view = UT_LIST_GET_LAST(trx_sys->view_list);
 
 	if (oldest_view == NULL) {
@@ -461,6 +712,7 @@ read_view_purge_open(
 	}
 
 	view->creator_trx_id = 0;
+	view->shared = false;
 
 	view->low_limit_no = oldest_view->low_limit_no;
 	view->low_limit_id = oldest_view->low_limit_id;
@@ -67,6 +67,10 @@ UNIV_INTERN char	srv_disable_sort_file_cache;
 /* Maximum pending doc memory limit in bytes for a fts tokenization thread */
 #define FTS_PENDING_DOC_MEMORY_LIMIT	1000000
 
+/** Number of threads scanning the clustered index when creating
+secondary indexes */
+UNIV_INTERN ulong	row_merge_scan_threads	= 1;
+
 #ifdef UNIV_DEBUG
 /******************************************************//**
 Display a merge tuple. */
@@ -632,7 +636,7 @@ row_merge_dup_report(
 	row_merge_dup_t*	dup,	/*!< in/out: for reporting duplicates */
 	const dfield_t*		entry)	/*!< in: duplicate index entry */
 {
-	if (!dup->n_dup++) {
+	if (!dup->n_dup++ && dup->table != NULL) {
 		/* Only report the first duplicate record,
 		but count all duplicate records. */
 		innobase_fields_to_mysql(dup->table, dup->index, entry);
@@ -1285,6 +1289,625 @@ row_merge_file_create_if_needed(
 	return(file->fd);
 }
 
+/** State shared by the threads of a parallel clustered index scan */
+struct row_merge_scan_ctx_t {
+	trx_t*			trx;		/*!< transaction */
+	struct TABLE*		table;		/*!< MySQL table object, for
+						reporting erroneous records */
+	const dict_table_t*	old_table;	/*!< table being scanned */
+	bool			online;		/*!< true if creating
+						indexes online */
+	dict_index_t**		index;		/*!< indexes to be created */
+	merge_file_t*		files;		/*!< temporary files; blocks
+						are appended by reserving
+						merge_file_t::offset with
+						an atomic increment */
+	const ulint*		key_numbers;	/*!< MySQL key numbers */
+	ulint			n_index;	/*!< number of indexes */
+	os_fast_mutex_t		mutex;		/*!< protects error and
+						error_key_num, and serializes
+						duplicate reporting into
+						table->record[0] */
+	volatile dberr_t	error;		/*!< first error reported by
+						any thread */
+	ulint			error_key_num;	/*!< trx->error_key_num for
+						error */
+};
+
+/** One key range of a parallel clustered index scan */
+struct row_merge_scan_t {
+	row_merge_scan_ctx_t*	ctx;		/*!< shared scan state */
+	const dtuple_t*		start;		/*!< first key of the range,
+						or NULL to start from the
+						beginning of the index */
+	const dtuple_t*		end;		/*!< first key after the
+						range, or NULL to scan to
+						the end of the index */
+	ib_uint64_t*		n_rec;		/*!< number of records
+						written, for each index */
+	os_thread_t		thread_hdl;	/*!< thread scanning the
+						range */
+};
+
+/** Note the first error of a parallel clustered index scan. The other
+threads stop at their next page boundary.
+@param[in,out]	ctx		parallel scan state
+@param[in]	err		error code
+@param[in]	error_key_num	MySQL key number of the failing index, or 0 */
+static
+void
+row_merge_scan_set_error(
+	row_merge_scan_ctx_t*	ctx,
+	dberr_t			err,
+	ulint			error_key_num)
+{
+	ut_ad(err != DB_SUCCESS);
+
+	os_fast_mutex_lock(&ctx->mutex);
+
+	if (ctx->error == DB_SUCCESS) {
+		ctx->error_key_num = error_key_num;
+		ctx->error = err;
+	}
+
+	os_fast_mutex_unlock(&ctx->mutex);
+}
+
+/** Split the clustered index into key ranges of roughly equal size for
+a parallel scan, using the node pointers on the root page.
+@param[in]	index		clustered index
+@param[in]	n_ranges	number of ranges wanted
+@param[out]	bounds		the n_ranges - 1 keys separating the ranges
+@param[in,out]	heap		memory heap for bounds
+@return number of ranges, 1 if the index cannot be split */
+static
+ulint
+row_merge_scan_split(
+	dict_index_t*		index,
+	ulint			n_ranges,
+	const dtuple_t**	bounds,
+	mem_heap_t*		heap)
+{
+	mtr_t		mtr;
+	buf_block_t*	block;
+	const page_t*	page;
+	const rec_t*	rec;
+	ulint		n_recs;
+
+	mtr_start(&mtr);
+
+	block = btr_root_block_get(index, RW_S_LATCH, &mtr);
+	page = buf_block_get_frame(block);
+	n_recs = page_get_n_recs(page);
+
+	if (page_is_leaf(page) || n_recs < 2) {
+		mtr_commit(&mtr);
+		return(1);
+	}
+
+	if (n_ranges > n_recs) {
+		n_ranges = n_recs;
+	}
+
+	/* Every (n_recs / n_ranges)th node pointer starts a new range.
+	The first node pointer is never chosen, so the bounds are in
+	ascending order and no range is empty of subtrees. */
+
+	rec = page_rec_get_next_const(page_get_infimum_rec(page));
+
+	for (ulint i = 0, n = 1; n < n_ranges; i++) {
+		if (i == n * n_recs / n_ranges) {
+			bounds[n - 1] = dict_index_build_data_tuple(
+				index, const_cast<rec_t*>(rec),
+				dict_index_get_n_unique_in_tree(index), heap);
+			n++;
+		}
+
+		rec = page_rec_get_next_const(rec);
+	}
+
+	mtr_commit(&mtr);
+
+	return(n_ranges);
+}
+
+/** Sort the buffered entries of one index and write them as a block to
+the merge file.
+@param[in,out]	ctx	parallel scan state
+@param[in,out]	scan	key range being scanned
+@param[in]	i	position of the index in ctx->index[]
+@param[in,out]	buf	sort buffer, emptied on success
+@param[out]	block	file buffer of srv_sort_buf_size bytes
+@return DB_SUCCESS or error code */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+row_merge_scan_write_buf(
+	row_merge_scan_ctx_t*	ctx,
+	row_merge_scan_t*	scan,
+	ulint			i,
+	row_merge_buf_t*	buf,
+	row_merge_block_t*	block)
+{
+	merge_file_t*	file = &ctx->files[i];
+
+	if (dict_index_is_unique(buf->index)) {
+		/* Only count the duplicates while sorting, so that the
+		threads do not serialize on ctx->mutex. */
+		row_merge_dup_t	dup = {buf->index, NULL, NULL, 0};
+
+		row_merge_buf_sort(buf, &dup);
+
+		if (dup.n_dup) {
+			/* The duplicates are adjacent in the sorted
+			buffer. Report the first one into the shared
+			table->record[0]. */
+			ulint		n_uniq = dict_index_get_n_unique(
+				buf->index);
+			ulint		n_field = dict_index_get_n_fields(
+				buf->index);
+
+			dup.table = ctx->table;
+			dup.n_dup = 0;
+
+			os_fast_mutex_lock(&ctx->mutex);
+
+			for (ulint j = 1;
+			     j < buf->n_tuples && !dup.n_dup; j++) {
+				row_merge_tuple_cmp(n_uniq, n_field,
+						    buf->tuples[j - 1],
+						    buf->tuples[j], &dup);
+			}
+
+			os_fast_mutex_unlock(&ctx->mutex);
+
+			return(DB_DUPLICATE_KEY);
+		}
+	} else {
+		row_merge_buf_sort(buf, NULL);
+	}
+
+	row_merge_buf_write(buf, file, block);
+
+	if (!row_merge_write(file->fd,
+			     os_atomic_increment_ulint(&file->offset, 1) - 1,
+			     block)) {
+		return(DB_TEMP_FILE_WRITE_FAILURE);
+	}
+
+	UNIV_MEM_INVALID(&block[0], srv_sort_buf_size);
+
+	scan->n_rec[i] += buf->n_tuples;
+
+	return(DB_SUCCESS);
+}
+
+/** Scan one key range of the clustered index and write the entries of
+the indexes being created as sorted blocks to the merge files. This is
+the single-table, no-FTS subset of row_merge_read_clustered_index().
+@param[in,out]	scan		key range to scan
+@param[out]	error_key_num	MySQL key number of the failing index
+@return DB_SUCCESS or error code */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+row_merge_scan_range(
+	row_merge_scan_t*	scan,
+	ulint*			error_key_num)
+{
+	row_merge_scan_ctx_t*	ctx = scan->ctx;
+	trx_t*			trx = ctx->trx;
+	const dict_table_t*	table = ctx->old_table;
+	dict_index_t*		clust_index;
+	row_merge_buf_t**	merge_buf;
+	row_merge_block_t*	block;
+	ulint			block_size;
+	mem_heap_t*		row_heap;
+	btr_pcur_t		pcur;
+	mtr_t			mtr;
+	dberr_t			err = DB_SUCCESS;
+
+	*error_key_num = 0;
+
+	block_size = srv_sort_buf_size;
+	block = static_cast<row_merge_block_t*>(
+		os_mem_alloc_large(&block_size, FALSE));
+
+	if (block == NULL) {
+		return(DB_OUT_OF_MEMORY);
+	}
+
+	merge_buf = static_cast<row_merge_buf_t**>(
+		mem_alloc(ctx->n_index * sizeof *merge_buf));
+
+	for (ulint i = 0; i < ctx->n_index; i++) {
+		merge_buf[i] = row_merge_buf_create(ctx->index[i]);
+	}
+
+	row_heap = mem_heap_create(sizeof(mrec_buf_t));
+
+	clust_index = dict_table_get_first_index(table);
+
+	mtr_start(&mtr);
+
+	if (scan->start == NULL) {
+		btr_pcur_open_at_index_side(
+			true, clust_index, BTR_SEARCH_LEAF, &pcur, true, 0,
+			&mtr);
+	} else {
+		/* Position on the last record before the range, so that
+		the loop below moves to its first record. */
+		btr_pcur_open(clust_index, scan->start, PAGE_CUR_L,
+			      BTR_SEARCH_LEAF, &pcur, &mtr);
+	}
+
+	for (;;) {
+		const rec_t*	rec;
+		ulint*		offsets;
+		const dtuple_t*	row;
+		row_ext_t*	ext;
+		page_cur_t*	cur	= btr_pcur_get_page_cur(&pcur);
+
+		page_cur_move_to_next(cur);
+
+		if (page_cur_is_after_last(cur)) {
+			if (ctx->error != DB_SUCCESS) {
+				/* Another thread failed. */
+				break;
+			}
+
+			if (UNIV_UNLIKELY(trx_is_interrupted(trx))) {
+				err = DB_INTERRUPTED;
+				break;
+			}
+
+			if (rw_lock_get_waiters(
+				    dict_index_get_lock(clust_index))) {
+				/* Yield to the waiters on the clustered
+				index tree lock, as in
+				row_merge_read_clustered_index(). */
+				btr_pcur_move_to_prev_on_page(&pcur);
+				ut_ad(btr_pcur_is_on_user_rec(&pcur)
+				      || buf_block_get_page_no(
+					      btr_pcur_get_block(&pcur))
+				      == clust_index->page);
+
+				btr_pcur_store_position(&pcur, &mtr);
+				mtr_commit(&mtr);
+
+				os_thread_yield();
+
+				mtr_start(&mtr);
+				btr_pcur_restore_position(
+					BTR_SEARCH_LEAF, &pcur, &mtr);
+
+				if (!btr_pcur_move_to_next_user_rec(
+					    &pcur, &mtr)) {
+					break;
+				}
+			} else {
+				ulint		next_page_no;
+				buf_block_t*	block;
+
+				next_page_no = btr_page_get_next(
+					page_cur_get_page(cur), &mtr);
+
+				if (next_page_no == FIL_NULL) {
+					break;
+				}
+
+				block = page_cur_get_block(cur);
+				block = btr_block_get(
+					buf_block_get_space(block),
+					buf_block_get_zip_size(block),
+					next_page_no, BTR_SEARCH_LEAF,
+					clust_index, &mtr);
+
+				btr_leaf_page_release(page_cur_get_block(cur),
+						      BTR_SEARCH_LEAF, &mtr);
+				page_cur_set_before_first(block, cur);
+				page_cur_move_to_next(cur);
+
+				ut_ad(!page_cur_is_after_last(cur));
+			}
+		}
+
+		rec = page_cur_get_rec(cur);
+
+		offsets = rec_get_offsets(rec, clust_index, NULL,
+					  ULINT_UNDEFINED, &row_heap);
+
+		if (scan->end != NULL
+		    && cmp_dtuple_rec(scan->end, rec, offsets) <= 0) {
+			/* The next range starts here. */
+			break;
+		}
+
+		if (ctx->online) {
+			/* Perform a REPEATABLE READ, see
+			row_merge_read_clustered_index(). All threads
+			share trx->read_view, which is not modified. */
+			ut_ad(trx->read_view);
+
+			if (!read_view_sees_trx_id(
+				    trx->read_view,
+				    row_get_rec_trx_id(
+					    rec, clust_index, offsets))) {
+				rec_t*	old_vers;
+
+				row_vers_build_for_consistent_read(
+					rec, &mtr, clust_index, &offsets,
+					trx->read_view, &row_heap,
+					row_heap, &old_vers);
+
+				rec = old_vers;
+
+				if (!rec) {
+					mem_heap_empty(row_heap);
+					continue;
+				}
+			}
+
+			ut_ad(!rec_offs_any_null_extern(rec, offsets));
+		}
+
+		if (rec_get_deleted_flag(rec, dict_table_is_comp(table))) {
+			mem_heap_empty(row_heap);
+			continue;
+		}
+
+		ut_ad(!rec_offs_any_null_extern(rec, offsets));
+
+		row = row_build(ROW_COPY_POINTERS, clust_index,
+				rec, offsets, table, NULL, NULL, &ext,
+				row_heap);
+
+		for (ulint i = 0; i < ctx->n_index; i++) {
+			doc_id_t	doc_id = 0;
+			bool		exceed_page = false;
+
+			if (row_merge_buf_add(
+				    merge_buf[i], NULL, table, NULL, row, ext,
+				    &doc_id, NULL, &exceed_page)) {
+
+				if (exceed_page) {
+					err = DB_TOO_BIG_RECORD;
+					*error_key_num = ctx->key_numbers[i];
+					break;
+				}
+
+				continue;
+			}
+
+			/* The buffer is full. */
+			err = row_merge_scan_write_buf(
+				ctx, scan, i, merge_buf[i], block);
+
+			if (err != DB_SUCCESS) {
+				*error_key_num = ctx->key_numbers[i];
+				break;
+			}
+
+			merge_buf[i] = row_merge_buf_empty(merge_buf[i]);
+
+			if (!row_merge_buf_add(
+				    merge_buf[i], NULL, table, NULL, row, ext,
+				    &doc_id, NULL, &exceed_page)) {
+				/* An empty buffer should have enough
+				room for at least one record. */
+				ut_error;
+			}
+
+			if (exceed_page) {
+				err = DB_TOO_BIG_RECORD;
+				*error_key_num = ctx->key_numbers[i];
+				break;
+			}
+		}
+
+		if (err != DB_SUCCESS) {
+			break;
+		}
+
+		mem_heap_empty(row_heap);
+	}
+
+	mtr_commit(&mtr);
+	btr_pcur_close(&pcur);
+
+	/* Write out the remaining entries of the range. */
+
+	for (ulint i = 0; i < ctx->n_index; i++) {
+		if (err == DB_SUCCESS && ctx->error == DB_SUCCESS
+		    && merge_buf[i]->n_tuples > 0) {
+
+			err = row_merge_scan_write_buf(
+				ctx, scan, i, merge_buf[i], block);
+
+			if (err != DB_SUCCESS) {
+				*error_key_num = ctx->key_numbers[i];
+			}
+		}
+
+		row_merge_buf_free(merge_buf[i]);
+	}
+
+	mem_free(merge_buf);
+	mem_heap_free(row_heap);
+	os_mem_free_large(block, block_size);
+
+	return(err);
+}
+
+/*********************************************************************//**
+Thread scanning one key range of the clustered index.
+@return OS_THREAD_DUMMY_RETURN */
+static
+os_thread_ret_t
+row_merge_scan_thread(
+/*==================*/
+	void*	arg)	/*!< in/out: row_merge_scan_t for the range */
+{
+	row_merge_scan_t*	scan = static_cast<row_merge_scan_t*>(arg);
+	ulint			error_key_num;
+	dberr_t			err;
+
+	err = row_merge_scan_range(scan, &error_key_num);
+
+	if (err != DB_SUCCESS) {
+		row_merge_scan_set_error(scan->ctx, err, error_key_num);
+	}
+
+	os_thread_exit(NULL, false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Read the clustered index of the table with row_merge_scan_threads
+threads, each scanning a key range, and write the entries of the
+secondary indexes being created to the merge files. The merge files
+receive sorted blocks from all threads in any order, which
+row_merge_sort() merges exactly like the blocks of a single-threaded
+scan.
+@param[in]	trx		transaction
+@param[in,out]	table		MySQL table object, for reporting erroneous
+				records
+@param[in]	old_table	table where rows are read from, and where
+				the indexes are created
+@param[in]	online		true if creating indexes online
+@param[in]	index		indexes to be created
+@param[in]	files		temporary files
+@param[in]	key_numbers	MySQL key numbers to create
+@param[in]	n_index		number of indexes to create
+@param[in]	bounds		keys separating the ranges
+@param[in]	n_ranges	number of ranges, one more than bounds
+@param[in,out]	tmpfd		temporary file handle
+@param[in]	path		location for the temporary files
+@return DB_SUCCESS or error code */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+row_merge_read_clustered_index_parallel(
+	trx_t*			trx,
+	struct TABLE*		table,
+	const dict_table_t*	old_table,
+	bool			online,
+	dict_index_t**		index,
+	merge_file_t*		files,
+	const ulint*		key_numbers,
+	ulint			n_index,
+	const dtuple_t**	bounds,
+	ulint			n_ranges,
+	int*			tmpfd,
+	const char*		path)
+{
+	row_merge_scan_ctx_t	ctx;
+	row_merge_scan_t*	scans;
+	ib_uint64_t*		n_rec;
+	dberr_t			err;
+	ulint			error_key_num;
+	os_thread_id_t		thd_id;
+	DBUG_ENTER("row_merge_read_clustered_index_parallel");
+
+	ut_ad(n_ranges > 1);
+
+	/* The threads append blocks to the merge files; create them,
+	and the file for row_merge_sort(), up front. */
+
+	for (ulint i = 0; i < n_index; i++) {
+		if (row_merge_file_create_if_needed(
+			    &files[i], tmpfd, 0, path) < 0) {
+			trx->error_key_num = i;
+			DBUG_RETURN(DB_OUT_OF_MEMORY);
+		}
+	}
+
+	ctx.trx = trx;
+	ctx.table = table;
+	ctx.old_table = old_table;
+	ctx.online = online;
+	ctx.index = index;
+	ctx.files = files;
+	ctx.key_numbers = key_numbers;
+	ctx.n_index = n_index;
+	ctx.error = DB_SUCCESS;
+	ctx.error_key_num = 0;
+	os_fast_mutex_init(PFS_NOT_INSTRUMENTED, &ctx.mutex);
+
+	scans = static_cast<row_merge_scan_t*>(
+		mem_alloc(n_ranges * sizeof *scans));
+	n_rec = static_cast<ib_uint64_t*>(
+		mem_zalloc(n_ranges * n_index * sizeof *n_rec));
+
+	for (ulint r = 0; r < n_ranges; r++) {
+		scans[r].ctx = &ctx;
+		scans[r].start = r > 0 ? bounds[r - 1] : NULL;
+		scans[r].end = r < n_ranges - 1 ? bounds[r] : NULL;
+		scans[r].n_rec = &n_rec[r * n_index];
+	}
+
+	DEBUG_SYNC_C("row_merge_scan_parallel");
+
+	/* Scan the first range in this thread. */
+
+	for (ulint r = 1; r < n_ranges; r++) {
+		scans[r].thread_hdl = os_thread_create(
+			row_merge_scan_thread, &scans[r], &thd_id);
+	}
+
+	err = row_merge_scan_range(&scans[0], &error_key_num);
+
+	if (err != DB_SUCCESS) {
+		row_merge_scan_set_error(&ctx, err, error_key_num);
+	}
+
+	for (ulint r = 1; r < n_ranges; r++) {
+		os_thread_join(scans[r].thread_hdl);
+	}
+
+	err = ctx.error;
+
+	if (err != DB_SUCCESS) {
+		trx->error_key_num = ctx.error_key_num;
+	} else {
+		for (ulint i = 0; i < n_index; i++) {
+			files[i].n_rec = 0;
+
+			for (ulint r = 0; r < n_ranges; r++) {
+				files[i].n_rec += scans[r].n_rec[i];
+			}
+
+			if (files[i].offset == 0) {
+				/* No entries; skip the sort and insert. */
+				row_merge_file_destroy(&files[i]);
+			}
+
+			if (online) {
+				/* Note the newest transaction that
+				modified this index when the scan was
+				completed, see
+				row_merge_read_clustered_index(). */
+				trx_id_t	max_trx_id;
+
+				rw_lock_x_lock(dict_index_get_lock(index[i]));
+				ut_a(dict_index_get_online_status(index[i])
+				     == ONLINE_INDEX_CREATION);
+
+				max_trx_id = row_log_get_max_trx(index[i]);
+
+				if (max_trx_id > index[i]->trx_id) {
+					index[i]->trx_id = max_trx_id;
+				}
+
+				rw_lock_x_unlock(dict_index_get_lock(index[i]));
+			}
+		}
+	}
+
+	os_fast_mutex_free(&ctx.mutex);
+	mem_free(n_rec);
+	mem_free(scans);
+
+	DBUG_RETURN(err);
+}
+
 /** Reads clustered index of the table and create temporary files
 containing the index entries for the indexes to be built.
 @param[in]	trx		transaction
@@ -1364,6 +1987,40 @@ row_merge_read_clustered_index(
 	ut_ad(trx->mysql_thd != NULL);
 	const char*	path = thd_innodb_tmpdir(trx->mysql_thd);
 
+	/* The variable can be changed while we use it; the bounds
+	array must be sized for the number of ranges that is split. */
+	const ulint	n_threads = row_merge_scan_threads;
+
+	if (n_threads > 1
+	    && old_table == new_table && fts_sort_idx == NULL) {
+		/* Creating secondary indexes only: the entries do not
+		depend on the order of the scan, so split it. */
+		mem_heap_t*		heap = mem_heap_create(1024);
+		const dtuple_t**	bounds;
+		ulint			n_ranges;
+
+		bounds = static_cast<const dtuple_t**>(
+			mem_heap_alloc(heap, n_threads * sizeof *bounds));
+
+		n_ranges = row_merge_scan_split(
+			dict_table_get_first_index(old_table),
+			n_threads, bounds, heap);
+
+		if (n_ranges > 1) {
+			err = row_merge_read_clustered_index_parallel(
+				trx, table, old_table, online, index,
+				files, key_numbers, n_index, bounds,
+				n_ranges, tmpfd, path);
+
+			mem_heap_free(heap);
+			trx->op_info = "";
+
+			DBUG_RETURN(err);
+		}
+
+		mem_heap_free(heap);
+	}
+
 	/* Create and initialize memory for record buffers */
 
 	merge_buf = static_cast<row_merge_buf_t**>(
@@ -1227,7 +1227,7 @@ row_sel_try_search_shortcut(
 				index */
 	ibool		search_latch_locked,
 				/*!< in: whether the search holds
-				btr_search_latch */
+				btr_search_get_latch(plan->index) */
 	mtr_t*		mtr)	/*!< in: mtr */
 {
 	dict_index_t*	index;
@@ -1245,7 +1245,8 @@ row_sel_try_search_shortcut(
 	ut_ad(!plan->must_get_clust);
 #ifdef UNIV_SYNC_DEBUG
 	if (search_latch_locked) {
-		ut_ad(rw_lock_own(&btr_search_latch, RW_LOCK_SHARED));
+		ut_ad(rw_lock_own(btr_search_get_latch(index),
+				  RW_LOCK_SHARED));
 	}
 #endif /* UNIV_SYNC_DEBUG */
 
@@ -1339,6 +1340,10 @@ row_sel(
 	rec_t*		old_vers;
 	rec_t*		clust_rec;
 	ibool		search_latch_locked;
+	rw_lock_t*	search_latch			= NULL;
+					/*!< the adaptive hash index
+					partition latch, when
+					search_latch_locked */
 	ibool		consistent_read;
 
 	/* The following flag becomes TRUE when we are doing a
@@ -1416,11 +1421,24 @@ table_loop:
 	if (consistent_read && plan->unique_search && !plan->pcur_is_open
 	    && !plan->must_get_clust
 	    && !plan->table->big_rows) {
+		if (search_latch_locked
+		    && search_latch != btr_search_get_latch(index)) {
+			/* The index belongs to another partition of the
+			adaptive hash index */
+
+			rw_lock_s_unlock(search_latch);
+
+			search_latch_locked = FALSE;
+		}
+
 		if (!search_latch_locked) {
-			rw_lock_s_lock(&btr_search_latch);
+			search_latch = btr_search_get_latch(index);
+
+			rw_lock_s_lock(search_latch);
 
 			search_latch_locked = TRUE;
-		} else if (rw_lock_get_writer(&btr_search_latch) == RW_LOCK_WAIT_EX) {
+		} else if (rw_lock_get_writer(search_latch)
+			   == RW_LOCK_WAIT_EX) {
 
 			/* There is an x-latch request waiting: release the
 			s-latch for a moment; as an s-latch here is often
@@ -1429,8 +1447,8 @@ table_loop:
 			from acquiring an s-latch for a long time, lowering
 			performance significantly in multiprocessors. */
 
-			rw_lock_s_unlock(&btr_search_latch);
-			rw_lock_s_lock(&btr_search_latch);
+			rw_lock_s_unlock(search_latch);
+			rw_lock_s_lock(search_latch);
 		}
 
 		found_flag = row_sel_try_search_shortcut(node, plan,
@@ -1455,7 +1473,7 @@ table_loop:
 	}
 
 	if (search_latch_locked) {
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(search_latch);
 
 		search_latch_locked = FALSE;
 	}
@@ -2034,7 +2052,7 @@ lock_wait_or_error:
 
 func_exit:
 	if (search_latch_locked) {
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(search_latch);
 	}
 	if (UNIV_LIKELY_NULL(heap)) {
 		mem_heap_free(heap);
@@ -3057,6 +3075,12 @@ public:
 	@param[in]	mtr		mtr used to get access to the
 					non-clustered record; the same mtr is used to
 					access the clustered index
+	@param[in]	positioned	true if the caller has already
+					positioned prebuilt->clust_pcur on the
+					clustered index record, in a batched
+					lookup of a copy of rec; a missing
+					clustered index record is then not an
+					error
 	@return	DB_SUCCESS, DB_SUCCESS_LOCKED_REC, or error code */
 	dberr_t operator()(
 	row_prebuilt_t*		prebuilt,
@@ -3066,7 +3090,8 @@ public:
 	const rec_t**		out_rec,
 	ulint**			offsets,
 	mem_heap_t**		offset_heap,
-	mtr_t*			mtr);
+	mtr_t*			mtr,
+	bool			positioned = false);
 };
 
 /** Retrieves the clustered index record corresponding to a record in a
@@ -3093,6 +3118,12 @@ interface.
 @param[in]	mtr		mtr used to get access to the
 				non-clustered record; the same mtr is used to
 				access the clustered index
+@param[in]	positioned	true if the caller has already
+				positioned prebuilt->clust_pcur on the
+				clustered index record, in a batched
+				lookup of a copy of rec; a missing
+				clustered index record is then not an
+				error
 @return	DB_SUCCESS, DB_SUCCESS_LOCKED_REC, or error code */
 MY_ATTRIBUTE((nonnull, warn_unused_result))
 dberr_t
@@ -3104,7 +3135,8 @@ Row_sel_get_clust_rec_for_mysql::operator()(
 	const rec_t**		out_rec,
 	ulint**			offsets,
 	mem_heap_t**		offset_heap,
-	mtr_t*			mtr)
+	mtr_t*			mtr,
+	bool			positioned)
 {
 	dict_index_t*	clust_index;
 	const rec_t*	clust_rec;
@@ -3117,14 +3149,16 @@ Row_sel_get_clust_rec_for_mysql::operator()(
 	*out_rec = NULL;
 	trx = thr_get_trx(thr);
 
-	row_build_row_ref_in_tuple(prebuilt->clust_ref, rec,
-				   sec_index, *offsets, trx);
-
 	clust_index = dict_table_get_first_index(sec_index->table);
 
-	btr_pcur_open_with_no_init(clust_index, prebuilt->clust_ref,
-				   PAGE_CUR_LE, BTR_SEARCH_LEAF,
-				   &prebuilt->clust_pcur, 0, mtr);
+	if (!positioned) {
+		row_build_row_ref_in_tuple(prebuilt->clust_ref, rec,
+					   sec_index, *offsets, trx);
+
+		btr_pcur_open_with_no_init(clust_index, prebuilt->clust_ref,
+					   PAGE_CUR_LE, BTR_SEARCH_LEAF,
+					   &prebuilt->clust_pcur, 0, mtr);
+	}
 
 	clust_rec = btr_pcur_get_rec(&prebuilt->clust_pcur);
 
@@ -3144,11 +3178,18 @@ Row_sel_get_clust_rec_for_mysql::operator()(
 		secondary index records associated with earlier versions of
 		the clustered index record. In that case we know that the
 		clustered index record did not exist in the read view of
-		trx. */
-
-		if (!rec_get_deleted_flag(rec,
-					  dict_table_is_comp(sec_index->table))
-		    || prebuilt->select_lock_type != LOCK_NONE) {
+		trx.
+
+		A batched lookup (positioned) works on a copy of rec, and the
+		secondary index page may have been released since the copy
+		was made. A rollback of the insert of the row may have
+		removed both records in the meantime. Such a row did not
+		exist in the read view either. */
+
+		if (!positioned
+		    && (!rec_get_deleted_flag(
+				rec, dict_table_is_comp(sec_index->table))
+			|| prebuilt->select_lock_type != LOCK_NONE)) {
 			ut_print_timestamp(stderr);
 			fputs("  InnoDB: error clustered record"
 			      " for sec rec not found\n"
@@ -3569,6 +3610,349 @@ row_sel_enqueue_cache_row_for_mysql(
 	++prebuilt->n_fetch_cached;
 }
 
+/********************************************************************//**
+Checks if the rows found by row_search_for_mysql() may be converted to
+the MySQL format and stored in the prefetch cache.
+@return TRUE if the prefetch cache can be used */
+UNIV_INLINE
+ibool
+row_sel_use_fetch_cache(
+/*====================*/
+	const row_prebuilt_t*	prebuilt,	/*!< in: prebuilt struct */
+	ulint			match_mode)	/*!< in: 0 or ROW_SEL_EXACT
+						or ROW_SEL_EXACT_PREFIX */
+{
+	/* Inside an update, for example, we do not cache rows,
+	since we may use the cursor position to do the actual
+	update, that is why we require ...lock_type == LOCK_NONE.
+	Since we keep space in prebuilt only for the BLOBs of
+	a single row, we cannot cache rows in the case there
+	are BLOBs in the fields to be fetched. In HANDLER we do
+	not cache rows because there the cursor is a scrollable
+	cursor. */
+
+	return((match_mode == ROW_SEL_EXACT
+		|| prebuilt->n_rows_fetched >= MYSQL_FETCH_CACHE_THRESHOLD)
+	       && prebuilt->select_lock_type == LOCK_NONE
+	       && !prebuilt->templ_contains_blob
+	       && !prebuilt->clust_index_was_generated
+	       && !prebuilt->used_in_HANDLER
+	       && !prebuilt->innodb_api
+	       && prebuilt->template_type != ROW_MYSQL_DUMMY_TEMPLATE
+	       && !prebuilt->in_fts_query);
+}
+
+/** Maximum number of secondary index records whose clustered index
+records are looked up in one batch: one row for the MySQL record buffer
+and the rest for the prefetch cache */
+#define ROW_SEL_CLUST_BATCH_SIZE	(MYSQL_FETCH_CACHE_SIZE + 1)
+
+/** Secondary index records whose clustered index records
+row_search_for_mysql() looks up in one batch, in primary key order */
+struct row_sel_clust_batch_t {
+	ulint		n_recs;		/*!< number of buffered records */
+	mem_heap_t*	heap;		/*!< memory heap for the copies of
+					the records, or NULL */
+	const rec_t*	recs[ROW_SEL_CLUST_BATCH_SIZE];
+					/*!< copies of the secondary index
+					records, in index order */
+	dtuple_t*	refs[ROW_SEL_CLUST_BATCH_SIZE];
+					/*!< clustered index search tuples
+					built from recs[] */
+};
+
+/** Orders the records of a batch by their clustered index keys */
+struct row_sel_clust_batch_less {
+	const row_sel_clust_batch_t*	batch;
+
+	explicit row_sel_clust_batch_less(
+		const row_sel_clust_batch_t*	batch) : batch(batch) {}
+
+	bool operator()(ulint i, ulint j) const
+	{
+		return(dtuple_coll_cmp(batch->refs[i], batch->refs[j]) < 0);
+	}
+};
+
+/********************************************************************//**
+Gets the number of records that can still be added to a batch before
+the MySQL record buffer and the prefetch cache would overflow.
+@return number of free slots */
+UNIV_INLINE
+ulint
+row_sel_clust_batch_free(
+/*=====================*/
+	const row_sel_clust_batch_t*	batch,	/*!< in: batch */
+	const row_prebuilt_t*		prebuilt,/*!< in: prebuilt struct */
+	const byte*			next_buf)/*!< in: next_buf of
+						row_search_for_mysql() */
+{
+	ulint	n_slots = MYSQL_FETCH_CACHE_SIZE - prebuilt->n_fetch_cached;
+
+	if (next_buf == NULL) {
+		/* The MySQL record buffer has not been written to. */
+		n_slots++;
+	}
+
+	ut_ad(batch->n_recs <= n_slots);
+
+	return(n_slots - batch->n_recs);
+}
+
+/********************************************************************//**
+Adds a copy of a secondary index record to a batch. */
+static
+void
+row_sel_clust_batch_add(
+/*====================*/
+	row_sel_clust_batch_t*	batch,		/*!< in/out: batch */
+	dict_index_t*		sec_index,	/*!< in: secondary index */
+	const rec_t*		rec,		/*!< in: record in sec_index */
+	const ulint*		offsets)	/*!< in: rec_get_offsets(rec,
+						sec_index) */
+{
+	rec_t*	copy;
+
+	ut_ad(batch->n_recs < ROW_SEL_CLUST_BATCH_SIZE);
+	ut_ad(rec_offs_validate(rec, sec_index, offsets));
+
+	if (batch->heap == NULL) {
+		batch->heap = mem_heap_create(
+			ROW_SEL_CLUST_BATCH_SIZE * 128);
+	}
+
+	copy = rec_copy(mem_heap_alloc(batch->heap, rec_offs_size(offsets)),
+			rec, offsets);
+
+	batch->recs[batch->n_recs] = copy;
+	batch->refs[batch->n_recs] = row_build_row_ref(
+		ROW_COPY_POINTERS, sec_index, copy, batch->heap);
+	batch->n_recs++;
+}
+
+/********************************************************************//**
+Positions prebuilt->clust_pcur on a clustered index record within the
+leaf page that the previous lookup of the batch ended up on. The keys of
+a batch are looked up in ascending order, so the record is on that page
+if the key is not greater than the last user record on the page.
+@return TRUE if the cursor was positioned */
+static
+ibool
+row_sel_clust_batch_search_on_page(
+/*===============================*/
+	btr_pcur_t*		pcur,		/*!< in/out: clustered index
+						cursor, positioned by the
+						previous lookup */
+	dict_index_t*		clust_index,	/*!< in: clustered index */
+	const dtuple_t*		ref,		/*!< in: search tuple */
+	mem_heap_t**		heap)		/*!< in/out: memory heap */
+{
+	buf_block_t*	block = btr_pcur_get_block(pcur);
+	const rec_t*	last;
+	ulint		offsets_[REC_OFFS_NORMAL_SIZE];
+	ulint*		offsets = offsets_;
+	ulint		up_match = 0;
+	ulint		up_bytes = 0;
+	ulint		low_match = 0;
+	ulint		low_bytes = 0;
+
+	rec_offs_init(offsets_);
+
+	last = page_rec_get_prev_const(
+		page_get_supremum_rec(buf_block_get_frame(block)));
+
+	if (!page_rec_is_user_rec(last)) {
+		return(FALSE);
+	}
+
+	offsets = rec_get_offsets(last, clust_index, offsets,
+				  dict_index_get_n_unique(clust_index), heap);
+
+	if (cmp_dtuple_rec(ref, last, offsets) > 0) {
+		return(FALSE);
+	}
+
+	page_cur_search_with_match(block, clust_index, ref, PAGE_CUR_LE,
+				   &up_match, &up_bytes,
+				   &low_match, &low_bytes,
+				   btr_pcur_get_page_cur(pcur));
+
+	pcur->btr_cur.up_match = up_match;
+	pcur->btr_cur.up_bytes = up_bytes;
+	pcur->btr_cur.low_match = low_match;
+	pcur->btr_cur.low_bytes = low_bytes;
+
+	return(TRUE);
+}
+
+/********************************************************************//**
+Looks up the clustered index records of the secondary index records in a
+batch in primary key order, and stores the rows that exist in the read
+view in the MySQL record buffer and the prefetch cache, in the order of
+the secondary index. Lookups whose key is on the leaf page of the
+previous lookup search that page instead of descending the B-tree.
+@return DB_SUCCESS or error code */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+row_sel_clust_batch_fetch(
+/*======================*/
+	row_sel_clust_batch_t*	batch,		/*!< in/out: batch; emptied
+						on return */
+	row_prebuilt_t*		prebuilt,	/*!< in/out: prebuilt struct */
+	dict_index_t*		sec_index,	/*!< in: secondary index */
+	que_thr_t*		thr,		/*!< in: query thread */
+	byte*			buf,		/*!< in/out: MySQL record
+						buffer */
+	byte**			next_buf,	/*!< in/out: next_buf of
+						row_search_for_mysql() */
+	Row_sel_get_clust_rec_for_mysql&
+				get_clust_rec,	/*!< in/out: clustered index
+						record lookup */
+	mem_heap_t**		offset_heap,	/*!< in/out: memory heap */
+	mtr_t*			mtr)		/*!< in/out: mini-transaction
+						holding the latch on the
+						secondary index leaf page */
+{
+	dict_index_t*	clust_index;
+	btr_pcur_t*	clust_pcur	= &prebuilt->clust_pcur;
+	buf_block_t*	block		= NULL;
+	byte*		dest[ROW_SEL_CLUST_BATCH_SIZE];
+	ibool		stored[ROW_SEL_CLUST_BATCH_SIZE];
+	ulint		order[ROW_SEL_CLUST_BATCH_SIZE];
+	ulint		offsets_[REC_OFFS_NORMAL_SIZE];
+	ulint*		offsets		= offsets_;
+	ulint		n_slots;
+	ulint		i;
+	dberr_t		err		= DB_SUCCESS;
+
+	rec_offs_init(offsets_);
+
+	ut_ad(batch->n_recs > 0);
+	ut_ad(prebuilt->select_lock_type == LOCK_NONE);
+	ut_ad(!prebuilt->idx_cond);
+
+	clust_index = dict_table_get_first_index(sec_index->table);
+
+	if (prebuilt->fetch_cache[0] == NULL) {
+		/* Allocate memory for the fetch cache */
+		ut_ad(prebuilt->n_fetch_cached == 0);
+
+		row_sel_prefetch_cache_init(prebuilt);
+	}
+
+	ut_ad(prebuilt->fetch_cache_first == 0);
+
+	/* Convert each row to the buffer it would have been stored in
+	by a lookup in index order. */
+
+	n_slots = prebuilt->n_fetch_cached;
+
+	for (i = 0; i < batch->n_recs; i++) {
+		if (i == 0 && *next_buf == NULL) {
+			dest[i] = buf;
+		} else {
+			ut_a(n_slots < MYSQL_FETCH_CACHE_SIZE);
+			dest[i] = prebuilt->fetch_cache[n_slots++];
+			UNIV_MEM_INVALID(dest[i], prebuilt->mysql_row_len);
+		}
+
+		stored[i] = FALSE;
+		order[i] = i;
+	}
+
+	std::sort(order, order + batch->n_recs,
+		  row_sel_clust_batch_less(batch));
+
+	for (ulint j = 0; j < batch->n_recs; j++) {
+		const rec_t*	clust_rec;
+
+		i = order[j];
+
+		if (block != NULL
+		    && row_sel_clust_batch_search_on_page(
+			    clust_pcur, clust_index, batch->refs[i],
+			    offset_heap)) {
+
+			srv_sec_rec_cluster_reads_page_reused.inc();
+		} else {
+			if (block != NULL) {
+				/* Release the leaf page of the previous
+				lookup before descending the B-tree, so that
+				at most one clustered index leaf page is
+				latched at a time, as in single lookups. */
+				btr_leaf_page_release(block, BTR_SEARCH_LEAF,
+						      mtr);
+			}
+
+			btr_pcur_open_with_no_init(clust_index,
+						   batch->refs[i],
+						   PAGE_CUR_LE,
+						   BTR_SEARCH_LEAF,
+						   clust_pcur, 0, mtr);
+
+			block = btr_pcur_get_block(clust_pcur);
+		}
+
+		offsets = rec_get_offsets(batch->recs[i], sec_index, offsets,
+					  ULINT_UNDEFINED, offset_heap);
+
+		err = get_clust_rec(prebuilt, sec_index, batch->recs[i], thr,
+				    &clust_rec, &offsets, offset_heap, mtr,
+				    true);
+
+		if (err != DB_SUCCESS) {
+			goto func_exit;
+		}
+
+		/* Skip rows that did not exist in the read view, and
+		delete-marked rows. */
+
+		if (clust_rec == NULL
+		    || rec_get_deleted_flag(
+			    clust_rec, dict_table_is_comp(clust_index->table))) {
+			continue;
+		}
+
+		/* Only fresh inserts may contain incomplete externally
+		stored columns. Pretend that such records do not exist,
+		as in row_search_for_mysql(). */
+
+		stored[i] = row_sel_store_mysql_rec(
+			dest[i], prebuilt, clust_rec, TRUE, clust_index,
+			offsets);
+	}
+
+	/* Queue the rows in the order of the secondary index, closing
+	the gaps left by the skipped rows. */
+
+	for (i = 0; i < batch->n_recs; i++) {
+		byte*	row_buf;
+
+		if (!stored[i]) {
+			continue;
+		}
+
+		if (*next_buf == NULL) {
+			row_buf = buf;
+			*next_buf = buf;
+		} else {
+			ut_ad(prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE);
+			row_buf = prebuilt->fetch_cache[
+				prebuilt->n_fetch_cached++];
+		}
+
+		if (row_buf != dest[i]) {
+			memcpy(row_buf, dest[i], prebuilt->mysql_row_len);
+		}
+	}
+
+func_exit:
+	batch->n_recs = 0;
+	mem_heap_empty(batch->heap);
+
+	return(err);
+}
+
 /*********************************************************************//**
 Tries to do a shortcut to fetch a clustered index record with a unique key,
 using the hash index if possible (not always). We assume that the search
@@ -4123,10 +4507,14 @@ row_search_for_mysql(
 	ibool		table_lock_waited		= FALSE;
 	byte*		next_buf			= 0;
 	ibool		use_clustered_index		= FALSE;
+	ibool		batch_clust_reads		= FALSE;
+	row_sel_clust_batch_t	clust_batch;
 	uint		read_level = 0;
 	ulint		latch_mode = BTR_SEARCH_LEAF;
 
 	rec_offs_init(offsets_);
+	clust_batch.n_recs = 0;
+	clust_batch.heap = NULL;
 
 	ut_ad(index && pcur && search_tuple);
 
@@ -4203,15 +4591,16 @@ row_search_for_mysql(
 	/* PHASE 0: Release a possible s-latch we are holding on the
 	adaptive hash index latch if there is someone waiting behind */
 
-	if (UNIV_UNLIKELY(rw_lock_get_writer(&btr_search_latch) != RW_LOCK_NOT_LOCKED)
-	    && trx->has_search_latch) {
+	if (trx->has_search_latch
+	    && UNIV_UNLIKELY(rw_lock_get_writer(trx->search_latch)
+			     != RW_LOCK_NOT_LOCKED)) {
 
 		/* There is an x-latch request on the adaptive hash index:
 		release the s-latch to reduce starvation and wait for
 		BTR_SEA_TIMEOUT rounds before trying to keep it again over
 		calls from MySQL */
 
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(trx->search_latch);
 		trx->has_search_latch = FALSE;
 
 		trx->search_latch_timeout = BTR_SEA_TIMEOUT;
@@ -4363,8 +4752,18 @@ row_search_for_mysql(
 			hash index semaphore! */
 
 #ifndef UNIV_SEARCH_DEBUG
+			if (trx->has_search_latch
+			    && trx->search_latch
+			    != btr_search_get_latch(index)) {
+				/* We kept the latch of another partition
+				of the adaptive hash index over calls */
+				rw_lock_s_unlock(trx->search_latch);
+				trx->has_search_latch = FALSE;
+			}
+
 			if (!trx->has_search_latch) {
-				rw_lock_s_lock(&btr_search_latch);
+				trx->search_latch = btr_search_get_latch(index);
+				rw_lock_s_lock(trx->search_latch);
 				trx->has_search_latch = TRUE;
 			}
 #endif
@@ -4436,7 +4835,7 @@ release_search_latch_if_needed:
 
 					trx->search_latch_timeout--;
 
-					rw_lock_s_unlock(&btr_search_latch);
+					rw_lock_s_unlock(trx->search_latch);
 					trx->has_search_latch = FALSE;
 				}
 
@@ -4460,7 +4859,7 @@ release_search_latch_if_needed:
 	/* PHASE 3: Open or restore index cursor position */
 
 	if (trx->has_search_latch) {
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(trx->search_latch);
 		trx->has_search_latch = FALSE;
 	}
 
@@ -4507,6 +4906,16 @@ release_search_latch_if_needed:
 
 	clust_index = dict_table_get_first_index(index->table);
 
+	/* In a range scan of a secondary index whose rows go to the
+	prefetch cache, defer the clustered index lookups until a batch
+	of them can be done in primary key order. */
+
+	batch_clust_reads = srv_batched_cluster_reads
+		&& index != clust_index
+		&& prebuilt->need_to_access_clustered
+		&& !prebuilt->idx_cond
+		&& row_sel_use_fetch_cache(prebuilt, match_mode);
+
 	/* Do some start-of-statement preparations */
 
 	if (!prebuilt->sql_stat_start) {
@@ -5093,6 +5502,10 @@ no_gap_lock:
 					err = DB_RECORD_NOT_FOUND;
 					goto idx_cond_failed;
 				case ICP_MATCH:
+					if (batch_clust_reads) {
+						goto add_to_clust_batch;
+					}
+
 					goto requires_clust_rec;
 				}
 
@@ -5224,6 +5637,50 @@ locks_ok:
 		}
 	}
 
+	if (use_clustered_index && batch_clust_reads) {
+add_to_clust_batch:
+		/* We use a 'goto' to the preceding label also when a
+		consistent read of the secondary index record requires us
+		to look up old versions of the clustered index record. */
+
+		row_sel_clust_batch_add(&clust_batch, index, rec, offsets);
+
+		if (row_sel_clust_batch_free(&clust_batch, prebuilt,
+					     next_buf) > 0) {
+			goto next_rec;
+		}
+
+		err = row_sel_clust_batch_fetch(
+			&clust_batch, prebuilt, index, thr, buf, &next_buf,
+			row_sel_get_clust_rec_for_mysql, &heap, &mtr);
+
+		mtr_has_extra_clust_latch = TRUE;
+
+		if (err != DB_SUCCESS) {
+			goto lock_wait_or_error;
+		}
+
+		if (prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE) {
+			goto next_rec;
+		}
+
+		err = DB_SUCCESS;
+		goto idx_cond_failed;
+	} else if (clust_batch.n_recs > 0) {
+		/* Return the deferred rows before this one, which
+		does not need a clustered index lookup. */
+
+		err = row_sel_clust_batch_fetch(
+			&clust_batch, prebuilt, index, thr, buf, &next_buf,
+			row_sel_get_clust_rec_for_mysql, &heap, &mtr);
+
+		mtr_has_extra_clust_latch = TRUE;
+
+		if (err != DB_SUCCESS) {
+			goto lock_wait_or_error;
+		}
+	}
+
 	if (use_clustered_index) {
 requires_clust_rec:
 		ut_ad(index != clust_index);
@@ -5328,25 +5785,7 @@ requires_clust_rec:
 	by a page latch that was acquired when pcur was positioned.
 	The latch will not be released until mtr_commit(&mtr). */
 
-	if ((match_mode == ROW_SEL_EXACT
-	     || prebuilt->n_rows_fetched >= MYSQL_FETCH_CACHE_THRESHOLD)
-	    && prebuilt->select_lock_type == LOCK_NONE
-	    && !prebuilt->templ_contains_blob
-	    && !prebuilt->clust_index_was_generated
-	    && !prebuilt->used_in_HANDLER
-	    && !prebuilt->innodb_api
-	    && prebuilt->template_type
-	    != ROW_MYSQL_DUMMY_TEMPLATE
-	    && !prebuilt->in_fts_query) {
-
-		/* Inside an update, for example, we do not cache rows,
-		since we may use the cursor position to do the actual
-		update, that is why we require ...lock_type == LOCK_NONE.
-		Since we keep space in prebuilt only for the BLOBs of
-		a single row, we cannot cache rows in the case there
-		are BLOBs in the fields to be fetched. In HANDLER we do
-		not cache rows because there the cursor is a scrollable
-		cursor. */
+	if (row_sel_use_fetch_cache(prebuilt, match_mode)) {
 
 		ut_a(prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE);
 
@@ -5640,6 +6079,19 @@ lock_table_wait:
 
 normal_return:
 	/*-------------------------------------------------------------*/
+	if (clust_batch.n_recs > 0) {
+		/* The scan ended before the batch was full. */
+
+		dberr_t	batch_err = row_sel_clust_batch_fetch(
+			&clust_batch, prebuilt, index, thr, buf, &next_buf,
+			row_sel_get_clust_rec_for_mysql, &heap, &mtr);
+
+		if (batch_err != DB_SUCCESS) {
+			err = batch_err;
+			goto lock_wait_or_error;
+		}
+	}
+
 	que_thr_stop_for_mysql_no_error(thr, trx);
 
 	mtr_commit(&mtr);
@@ -5678,6 +6130,10 @@ func_exit:
 		mem_heap_free(heap);
 	}
 
+	if (UNIV_LIKELY_NULL(clust_batch.heap)) {
+		mem_heap_free(clust_batch.heap);
+	}
+
 	/* Set or reset the "did semi-consistent read" flag on return.
 	The flag did_semi_consistent_read is set if and only if
 	the record being returned was fetched with a semi-consistent read. */
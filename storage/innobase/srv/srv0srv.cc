@@ -152,6 +152,12 @@ OS (provided we compiled Innobase with it in), otherwise we will
 use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 UNIV_INTERN my_bool	srv_use_native_aio = TRUE;
+/* If this flag is TRUE, then the Linux native aio uses io_uring instead
+of libaio, provided InnoDB was compiled with it */
+UNIV_INTERN my_bool	srv_use_io_uring = FALSE;
+/* Number of microseconds the read and write i/o threads busy poll the
+io_uring completion queue before sleeping in the kernel */
+UNIV_INTERN ulong	srv_io_uring_poll_usecs = 0;
 UNIV_INTERN my_bool	srv_numa_interleave = FALSE;
 
 #ifdef __WIN__
@@ -199,6 +205,7 @@ UNIV_INTERN ib_uint64_t	srv_log_file_size_requested;
 UNIV_INTERN ulint	srv_log_buffer_size	= ULINT_MAX;
 UNIV_INTERN ulong	srv_flush_log_at_trx_commit = 1;
 UNIV_INTERN uint	srv_flush_log_at_timeout = 1;
+UNIV_INTERN my_bool	srv_log_writer_threads = FALSE;
 UNIV_INTERN ulong	srv_page_size		= UNIV_PAGE_SIZE_DEF;
 UNIV_INTERN ulong	srv_page_size_shift	= UNIV_PAGE_SIZE_SHIFT_DEF;
 
@@ -339,6 +346,14 @@ UNIV_INTERN ulong srv_innodb_stats_method = SRV_STATS_NULLS_EQUAL;
 /* Enable adaptive sleep time calculation for page cleaner thread if enabled. */
 UNIV_INTERN my_bool	srv_pc_adaptive_sleep;
 
+/** Number of page cleaner threads, including the coordinating
+page_cleaner thread itself */
+UNIV_INTERN ulong	srv_n_page_cleaners = 1;
+
+/** Number of threads that apply redo log records to pages in crash
+recovery, including the thread running the recovery */
+UNIV_INTERN ulong	srv_n_recv_apply_threads = 1;
+
 /** The maximum time limit for a single LRU tail flush iteration by the page
 cleaner thread */
 UNIV_INTERN ulint	srv_cleaner_max_lru_time = 1000;
@@ -432,6 +447,10 @@ UNIV_INTERN my_bool	srv_deadlock_detect = TRUE;
 /** Maximum number of deadlock detection steps allowed. */
 UNIV_INTERN uint	srv_max_deadlock_detection_steps = 0;
 
+/** Share read views between autocommit non-locking read-only
+transactions while no read-write transaction commits. */
+UNIV_INTERN my_bool	srv_read_view_cache = FALSE;
+
 /** Enable INFORMATION_SCHEMA.innodb_cmp_per_index */
 UNIV_INTERN my_bool	srv_cmp_per_index_enabled = FALSE;
 
@@ -461,6 +480,10 @@ UNIV_INTERN my_bool srv_recv_ibuf_operations = FALSE;
 /* Enables or disables this prefix optimization.  Disabled by default. */
 UNIV_INTERN my_bool	srv_prefix_index_cluster_optimization = 0;
 
+/* Look up the clustered index records of secondary index range scans in
+batches sorted by primary key. Disabled by default. */
+UNIV_INTERN my_bool	srv_batched_cluster_reads = 0;
+
 /* When estimating number of different key values in an index, sample
 this many index pages, there are 2 ways to calculate statistics:
 * persistent stats that are calculated by ANALYZE TABLE and saved
@@ -477,6 +500,10 @@ UNIV_INTERN double		srv_stats_recalc_threshold = 0.1;
 UNIV_INTERN ulong	srv_use_doublewrite_buf	= 1;
 UNIV_INTERN my_bool	srv_doublewrite_reset = FALSE;
 
+/** The tablespaces whose pages are protected by full page images in the
+redo log instead of the doublewrite buffer, see srv_log_page_images_t. */
+UNIV_INTERN ulong	srv_log_page_images = SRV_LOG_PAGE_IMAGES_NONE;
+
 /** doublewrite buffer is 1MB is size i.e.: it can hold 128 16K pages.
 The following parameter is the size of the buffer that is used for
 batch flushing i.e.: LRU flushing and flush_list flushing. The rest
@@ -614,6 +641,10 @@ atomic_stat<ulint>	srv_sec_rec_cluster_reads;
 /** Number of times prefix optimization avoided triggering cluster lookup */
 atomic_stat<ulint>	srv_sec_rec_cluster_reads_avoided;
 
+/** Number of batched cluster lookups that reused the leaf page of the
+previous lookup */
+atomic_stat<ulint>	srv_sec_rec_cluster_reads_page_reused;
+
 
 /* This is only ever touched by the master thread. It records the
 time when the last flush of log file has happened. The master
@@ -1444,7 +1475,14 @@ srv_printf_innodb_monitor(
 		      "-------------------------------------\n", file);
 		ibuf_print(file);
 
-		ha_print_info(file, btr_search_sys->hash_index);
+		for (ulint i = 0; i < btr_search_index_num; i++) {
+			if (btr_search_index_num > 1) {
+				fprintf(file, "Partition %lu: ", (ulong) i);
+			}
+
+			ha_print_info(file,
+				      btr_search_sys->parts[i].hash_index);
+		}
 
 		fprintf(file,
 			"%.2f hash searches/s, %.2f non-hash searches/s\n",
@@ -1900,6 +1938,8 @@ srv_export_innodb_status(void)
 
 	export_vars.innodb_dblwr_writes = srv_stats.dblwr_writes;
 
+	export_vars.innodb_page_images_logged = srv_stats.page_images_logged;
+
 	export_vars.innodb_pages_created = stat.n_pages_created;
 
 	export_vars.innodb_pages_read = stat.n_pages_read;
@@ -2046,6 +2086,8 @@ srv_export_innodb_status(void)
 		srv_sec_rec_cluster_reads.load();
 	export_vars.innodb_sec_rec_cluster_reads_avoided =
 		srv_sec_rec_cluster_reads_avoided.load();
+	export_vars.innodb_sec_rec_cluster_reads_page_reused =
+		srv_sec_rec_cluster_reads_page_reused.load();
 
 	export_vars.innodb_preflush_async_limit = log_sys->max_modified_age_async;
 	export_vars.innodb_preflush_sync_limit = log_sys->max_modified_age_sync;
@@ -2307,7 +2349,7 @@ loop:
 		if (srv_print_innodb_monitor) {
 			/* Reset mutex_skipped counter everytime
 			srv_print_innodb_monitor changes. This is to
-			ensure we will not be blocked by lock_sys->mutex
+			ensure we will not be blocked by lock_sys->latch
 			for short duration information printing,
 			such as requested by sync_array_print_long_waits() */
 			if (!last_srv_print_monitor) {
@@ -1890,7 +1890,12 @@ innobase_start_or_create_for_mysql(void)
 			    + 1 /* dict_stats_thread */
 			    + 1 /* fts_optimize_thread */
 			    + 1 /* recv_writer_thread */
+			    + srv_n_recv_apply_threads - 1
+			    /* recv_apply_thread */
 			    + 1 /* buf_flush_page_cleaner_thread */
+			    + srv_n_page_cleaners - 1
+			    /* buf_flush_page_cleaner_worker */
+			    + 2 /* log_writer_thread, log_flusher_thread */
 			    + 1 /* trx_rollback_or_clean_all_recovered */
 			    + 128 /* added as margin, for use of
 				  InnoDB Memcached etc. */
@@ -2854,7 +2859,18 @@ files_checked:
 	}
 
 	if (!srv_read_only_mode) {
+		buf_flush_page_cleaner_init();
+
 		os_thread_create(buf_flush_page_cleaner_thread, NULL, NULL);
+
+		for (i = 1; i < srv_n_page_cleaners; i++) {
+			os_thread_create(buf_flush_page_cleaner_worker,
+					 NULL, NULL);
+		}
+
+		if (srv_log_writer_threads) {
+			log_writer_threads_start();
+		}
 	}
 
 	os_thread_create(buf_flush_lru_manager_thread, NULL, NULL);
@@ -633,6 +633,8 @@ trx_sys_create(void)
 
 	mutex_create(trx_sys_mutex_key, &trx_sys->mutex, SYNC_TRX_SYS);
 	mutex_create(trx_sys_mutex_key, &trx_sys->trx_memory_mutex, SYNC_TRX);
+
+	trx_sys->mvcc_version = 1;
 }
 
 /*****************************************************************//**
@@ -1207,6 +1209,8 @@ trx_sys_close(void)
 
 	mutex_enter(&trx_sys->mutex);
 
+	read_view_shared_close();
+
 	if (UT_LIST_GET_LEN(trx_sys->view_list) > 1) {
 		fprintf(stderr,
 			"InnoDB: Error: all read views were not closed"
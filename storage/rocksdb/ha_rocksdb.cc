@@ -219,6 +219,13 @@ void ha_rocksdb::inc_covered_sk_lookup() {
   global_stats.covered_secondary_key_lookups.inc();
 }
 
+Rdb_bypass_plan_cache *ha_rocksdb::get_bypass_plan_cache() {
+  if (!m_bypass_plan_cache) {
+    m_bypass_plan_cache.reset(new Rdb_bypass_plan_cache());
+  }
+  return m_bypass_plan_cache.get();
+}
+
 void dbug_dump_database(rocksdb::DB *db);
 static handler *rocksdb_create_handler(my_core::handlerton *hton,
                                        my_core::TABLE_SHARE *table_arg,
@@ -243,6 +250,8 @@ static rocksdb::CompactRangeOptions getCompactRangeOptions(
 ///////////////////////////////////////////////////////////
 static char *rocksdb_default_cf_options = nullptr;
 static char *rocksdb_override_cf_options = nullptr;
+static char *rocksdb_cold_data_dir = nullptr;
+static char *rocksdb_tiered_cf_options = nullptr;
 static char *rocksdb_update_cf_options = nullptr;
 static my_bool rocksdb_use_default_sk_cf = false;
 
@@ -680,6 +689,7 @@ static my_bool rocksdb_force_flush_memtable_now_var = 0;
 static my_bool rocksdb_force_flush_memtable_and_lzero_now_var = 0;
 static my_bool rocksdb_enable_ttl = 1;
 static my_bool rocksdb_enable_ttl_read_filtering = 1;
+static my_bool rocksdb_enable_pk_value_offsets = 0;
 static int rocksdb_debug_ttl_rec_ts = 0;
 static int rocksdb_debug_ttl_snapshot_ts = 0;
 static int rocksdb_debug_ttl_read_filter_ts = 0;
@@ -697,6 +707,7 @@ static uint32_t rocksdb_table_stats_sampling_pct;
 static uint32_t rocksdb_table_stats_recalc_threshold_pct = 10;
 static unsigned long long rocksdb_table_stats_recalc_threshold_count = 100ul;
 static my_bool rocksdb_table_stats_use_table_scan = 0;
+my_bool rocksdb_table_stats_use_sketches = 0;
 static int32_t rocksdb_table_stats_background_thread_nice_value =
     THREAD_PRIO_MAX;
 static unsigned long long rocksdb_table_stats_max_num_rows_scanned = 0ul;
@@ -733,6 +744,7 @@ static uint32_t rocksdb_select_bypass_rejected_query_history_size = 0;
 static uint32_t rocksdb_select_bypass_debug_row_delay = 0;
 static unsigned long long  // NOLINT(runtime/int)
     rocksdb_select_bypass_multiget_min = 0;
+static uint32_t rocksdb_select_bypass_plan_cache_size = 0;
 static my_bool rocksdb_skip_locks_if_skip_unique_check = FALSE;
 static my_bool rocksdb_alter_column_default_inplace = FALSE;
 std::atomic<uint64_t> rocksdb_row_lock_deadlocks(0);
@@ -747,6 +759,12 @@ std::atomic<uint64_t> rocksdb_num_get_for_update_calls(0);
 std::atomic<uint64_t> rocksdb_select_bypass_executed(0);
 std::atomic<uint64_t> rocksdb_select_bypass_rejected(0);
 std::atomic<uint64_t> rocksdb_select_bypass_failed(0);
+std::atomic<uint64_t> rocksdb_select_bypass_plan_cache_hits(0);
+std::atomic<uint64_t> rocksdb_select_bypass_plan_cache_misses(0);
+std::atomic<uint64_t> rocksdb_scan_readahead_scans(0);
+std::atomic<uint64_t> rocksdb_scan_readahead_rows(0);
+std::atomic<uint64_t> rocksdb_scan_readahead_wasted(0);
+std::atomic<uint64_t> rocksdb_bloom_filter_costed_ranges(0);
 
 static int rocksdb_trace_block_cache_access(
     THD *const thd MY_ATTRIBUTE((__unused__)),
@@ -1085,6 +1103,19 @@ const int64 RDB_MIN_BLOCK_CACHE_SIZE = 1024;
 const int RDB_MAX_CHECKSUMS_PCT = 100;
 const ulong RDB_DEADLOCK_DETECT_DEPTH = 50;
 const ulong ROCKSDB_MAX_MRR_BATCH_SIZE = 1000;
+
+/*
+  Cost of looking up one key in a MultiGet batch, relative to a single point
+  lookup. Keys in a batch share memtable and SST index/filter probes, and
+  their data blocks are read in parallel.
+*/
+const double ROCKSDB_MRR_MULTIGET_KEY_COST = 0.5;
+
+/*
+  Cost of a point lookup that a bloom filter rules out, relative to one that
+  has to read data blocks: the filter blocks still need to be checked.
+*/
+const double ROCKSDB_BLOOM_FILTER_SKIP_COST = 0.1;
 const uint ROCKSDB_MAX_BOTTOM_PRI_BACKGROUND_COMPACTIONS = 64;
 
 // TODO: 0 means don't wait at all, and we don't support it yet?
@@ -1306,6 +1337,13 @@ static MYSQL_THDVAR_ULONG(bulk_load_size, PLUGIN_VAR_RQCMDARG,
                           /*min*/ 1,
                           /*max*/ RDB_MAX_BULK_LOAD_SIZE, 0);
 
+static MYSQL_THDVAR_UINT(
+    bulk_load_writer_threads, PLUGIN_VAR_RQCMDARG,
+    "Number of background threads building SST files during bulk-load. "
+    "With 0, SST files are written by the session thread. Each thread "
+    "buffers up to one SST file worth of keys in memory.",
+    nullptr, nullptr, /* default */ 0, /* min */ 0, /* max */ 64, 0);
+
 static MYSQL_THDVAR_ULONGLONG(
     merge_buf_size, PLUGIN_VAR_RQCMDARG,
     "Size to allocate for merge sort buffers written out to disk "
@@ -1879,6 +1917,21 @@ static MYSQL_SYSVAR_STR(override_cf_options, rocksdb_override_cf_options,
                         "option overrides per cf for RocksDB", nullptr, nullptr,
                         "");
 
+static MYSQL_SYSVAR_STR(cold_data_dir, rocksdb_cold_data_dir,
+                        PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+                        "Directory on slower storage holding the lower LSM "
+                        "levels of tiered column families",
+                        nullptr, nullptr, "");
+
+static MYSQL_SYSVAR_STR(
+    tiered_cf_options, rocksdb_tiered_cf_options,
+    PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+    "Column families to tier between rocksdb_datadir and "
+    "rocksdb_cold_data_dir, as cf_name={hot_tier_size=<bytes>};... "
+    "A column family must stay tiered once it has files in the cold "
+    "directory",
+    nullptr, nullptr, "");
+
 static MYSQL_SYSVAR_STR(update_cf_options, rocksdb_update_cf_options,
                         PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_MEMALLOC |
                             PLUGIN_VAR_ALLOCATED,
@@ -1914,6 +1967,19 @@ static MYSQL_THDVAR_BOOL(skip_fill_cache, PLUGIN_VAR_RQCMDARG,
                          "Skip filling block cache on read requests", nullptr,
                          nullptr, FALSE);
 
+static MYSQL_THDVAR_ULONGLONG(
+    scan_readahead_size, PLUGIN_VAR_RQCMDARG,
+    "ReadOptions::readahead_size used by range and full scans once they have "
+    "read rocksdb_scan_readahead_after_rows rows. 0 disables readahead.",
+    nullptr, nullptr, /* default */ 0, /* min */ 0,
+    /* max */ 64 * 1024 * 1024, 0);
+
+static MYSQL_THDVAR_UINT(
+    scan_readahead_after_rows, PLUGIN_VAR_RQCMDARG,
+    "Number of rows a range or full scan has to read before it is considered "
+    "sequential and switched to readahead.",
+    nullptr, nullptr, /* default */ 1000, /* min */ 1, /* max */ UINT_MAX, 0);
+
 static MYSQL_THDVAR_BOOL(
     unsafe_for_binlog, PLUGIN_VAR_RQCMDARG,
     "Allowing statement based binary logging which may break consistency",
@@ -1985,6 +2051,14 @@ static MYSQL_SYSVAR_BOOL(
     "Enable expired TTL records to be dropped during compaction.", nullptr,
     nullptr, TRUE);
 
+static MYSQL_SYSVAR_BOOL(
+    enable_pk_value_offsets, rocksdb_enable_pk_value_offsets,
+    PLUGIN_VAR_RQCMDARG,
+    "Store an offset directory of the variable length columns in primary key "
+    "values of new tables, so that reads of a few columns can skip the "
+    "others. Tables created with this can not be read by older versions.",
+    nullptr, nullptr, FALSE);
+
 static MYSQL_SYSVAR_BOOL(
     enable_ttl_read_filtering, rocksdb_enable_ttl_read_filtering,
     PLUGIN_VAR_RQCMDARG,
@@ -2248,6 +2322,14 @@ static MYSQL_SYSVAR_BOOL(table_stats_use_table_scan,
                          rocksdb_update_table_stats_use_table_scan,
                          rocksdb_table_stats_use_table_scan);
 
+static MYSQL_SYSVAR_BOOL(
+    table_stats_use_sketches, rocksdb_table_stats_use_sketches,
+    PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+    "Keep HyperLogLog sketches of the distinct key prefixes written to each "
+    "index, so that index cardinality includes rows not yet flushed to SST "
+    "files without running ANALYZE TABLE",
+    nullptr, nullptr, FALSE);
+
 static MYSQL_SYSVAR_BOOL(
     large_prefix, rocksdb_large_prefix, PLUGIN_VAR_RQCMDARG,
     "Support large index prefix length of 3072 bytes. If off, the maximum "
@@ -2349,11 +2431,33 @@ static MYSQL_SYSVAR_ULONGLONG(
     "MultiGet",
     nullptr, nullptr, SIZE_T_MAX, /* min */ 0, /* max */ SIZE_T_MAX, 0);
 
+static MYSQL_SYSVAR_UINT(
+    select_bypass_plan_cache_size, rocksdb_select_bypass_plan_cache_size,
+    PLUGIN_VAR_RQCMDARG,
+    "Maximum number of resolved SELECT bypass plans, keyed by statement "
+    "digest, cached per open table. Requires statement digests to be "
+    "computed. Set to 0 to turn off",
+    nullptr, nullptr, 0, /* min */ 0, /* max */ 1024, 0);
+
 static MYSQL_THDVAR_LONG(mrr_batch_size, PLUGIN_VAR_RQCMDARG,
                          "maximum number of keys to fetch during each MRR",
                          nullptr, nullptr, /* default */ 100, /* min */ 0,
                          /* max */ ROCKSDB_MAX_MRR_BATCH_SIZE, 0);
 
+static MYSQL_THDVAR_BOOL(
+    mrr_cost_based_multiget, PLUGIN_VAR_RQCMDARG,
+    "With optimizer_switch='mrr=on,mrr_cost_based=on', use MultiGet-MRR for "
+    "range scans and batched key access when its estimated cost is lower "
+    "than the default MRR implementation",
+    nullptr, nullptr, FALSE);
+
+static MYSQL_THDVAR_BOOL(
+    bloom_filter_aware_costing, PLUGIN_VAR_RQCMDARG,
+    "Lower the estimated cost of equality ranges that can use the bloom "
+    "filter of their column family, based on the fraction of lookups the "
+    "filters of the table have ruled out",
+    nullptr, nullptr, FALSE);
+
 static MYSQL_SYSVAR_BOOL(skip_locks_if_skip_unique_check,
                          rocksdb_skip_locks_if_skip_unique_check,
                          PLUGIN_VAR_RQCMDARG,
@@ -2389,6 +2493,7 @@ static struct st_mysql_sys_var *rocksdb_system_variables[] = {
     MYSQL_SYSVAR(read_free_rpl_tables),
     MYSQL_SYSVAR(read_free_rpl),
     MYSQL_SYSVAR(bulk_load_size),
+    MYSQL_SYSVAR(bulk_load_writer_threads),
     MYSQL_SYSVAR(merge_buf_size),
     MYSQL_SYSVAR(enable_bulk_load_api),
     MYSQL_SYSVAR(enable_pipelined_write),
@@ -2470,6 +2575,8 @@ static struct st_mysql_sys_var *rocksdb_system_variables[] = {
 
     MYSQL_SYSVAR(default_cf_options),
     MYSQL_SYSVAR(override_cf_options),
+    MYSQL_SYSVAR(cold_data_dir),
+    MYSQL_SYSVAR(tiered_cf_options),
     MYSQL_SYSVAR(update_cf_options),
     MYSQL_SYSVAR(use_default_sk_cf),
 
@@ -2478,6 +2585,8 @@ static struct st_mysql_sys_var *rocksdb_system_variables[] = {
     MYSQL_SYSVAR(write_ignore_missing_column_families),
 
     MYSQL_SYSVAR(skip_fill_cache),
+    MYSQL_SYSVAR(scan_readahead_size),
+    MYSQL_SYSVAR(scan_readahead_after_rows),
     MYSQL_SYSVAR(unsafe_for_binlog),
 
     MYSQL_SYSVAR(records_in_range),
@@ -2500,6 +2609,7 @@ static struct st_mysql_sys_var *rocksdb_system_variables[] = {
     MYSQL_SYSVAR(force_flush_memtable_and_lzero_now),
     MYSQL_SYSVAR(enable_ttl),
     MYSQL_SYSVAR(enable_ttl_read_filtering),
+    MYSQL_SYSVAR(enable_pk_value_offsets),
     MYSQL_SYSVAR(debug_ttl_rec_ts),
     MYSQL_SYSVAR(debug_ttl_snapshot_ts),
     MYSQL_SYSVAR(debug_ttl_read_filter_ts),
@@ -2528,6 +2638,7 @@ static struct st_mysql_sys_var *rocksdb_system_variables[] = {
     MYSQL_SYSVAR(table_stats_recalc_threshold_count),
     MYSQL_SYSVAR(table_stats_max_num_rows_scanned),
     MYSQL_SYSVAR(table_stats_use_table_scan),
+    MYSQL_SYSVAR(table_stats_use_sketches),
     MYSQL_SYSVAR(table_stats_background_thread_nice_value),
 
     MYSQL_SYSVAR(large_prefix),
@@ -2551,7 +2662,10 @@ static struct st_mysql_sys_var *rocksdb_system_variables[] = {
     MYSQL_SYSVAR(select_bypass_allow_filters),
     MYSQL_SYSVAR(select_bypass_debug_row_delay),
     MYSQL_SYSVAR(select_bypass_multiget_min),
+    MYSQL_SYSVAR(select_bypass_plan_cache_size),
     MYSQL_SYSVAR(mrr_batch_size),
+    MYSQL_SYSVAR(mrr_cost_based_multiget),
+    MYSQL_SYSVAR(bloom_filter_aware_costing),
     MYSQL_SYSVAR(skip_locks_if_skip_unique_check),
     MYSQL_SYSVAR(alter_column_default_inplace),
     nullptr};
@@ -2735,6 +2849,18 @@ class Rdb_transaction {
   ulonglong m_row_lock_count = 0;
   std::unordered_map<GL_INDEX_ID, ulonglong> m_auto_incr_map;
 
+  /*
+    Changes to the cardinality sketches of the indexes, by the current
+    statement and by the statements before it. Like the row writes, they
+    only become visible in Rdb_key_def::m_sketch when the transaction
+    commits.
+  */
+  using Rdb_sketch_deltas =
+      std::unordered_map<std::shared_ptr<Rdb_index_sketch>,
+                         std::unique_ptr<Rdb_index_sketch>>;
+  Rdb_sketch_deltas m_stmt_sketch_deltas;
+  Rdb_sketch_deltas m_sketch_deltas;
+
   bool m_is_delayed_snapshot = false;
   bool m_is_two_phase = false;
 
@@ -3164,7 +3290,8 @@ class Rdb_transaction {
         table_name = "./" + table_name;
         auto sst_info = std::make_shared<Rdb_sst_info>(
             rdb, table_name, index_name, rdb_merge.get_cf(),
-            *rocksdb_db_options, THDVAR(get_thd(), trace_sst_api));
+            *rocksdb_db_options, THDVAR(get_thd(), trace_sst_api),
+            THDVAR(get_thd(), bulk_load_writer_threads));
 
         while ((rc2 = rdb_merge.next(&merge_key, &merge_val)) == 0) {
           if ((rc2 = sst_info->put(merge_key, merge_val)) != 0) {
@@ -3399,7 +3526,7 @@ class Rdb_transaction {
       rocksdb::ColumnFamilyHandle *const column_family, bool skip_bloom_filter,
       bool fill_cache, const rocksdb::Slice &eq_cond_lower_bound,
       const rocksdb::Slice &eq_cond_upper_bound, bool read_current = false,
-      bool create_snapshot = true) {
+      bool create_snapshot = true, size_t readahead_size = 0) {
     // Make sure we are not doing both read_current (which implies we don't
     // want a snapshot) and create_snapshot which makes sure we create
     // a snapshot
@@ -3425,6 +3552,7 @@ class Rdb_transaction {
       options.prefix_same_as_start = true;
     }
     options.fill_cache = fill_cache;
+    options.readahead_size = readahead_size;
     if (read_current) {
       options.snapshot = nullptr;
     }
@@ -3446,11 +3574,45 @@ class Rdb_transaction {
       it->m_update_time = tm;
     }
     modified_tables.clear();
+
+    merge_stmt_sketch_deltas();
+    for (const auto &it : m_sketch_deltas) {
+      it.first->merge(*it.second);
+    }
+    m_sketch_deltas.clear();
   }
   void on_rollback() {
     modified_tables.clear();
+    m_stmt_sketch_deltas.clear();
+    m_sketch_deltas.clear();
   }
+
+  void merge_stmt_sketch_deltas() {
+    for (auto &it : m_stmt_sketch_deltas) {
+      auto &delta = m_sketch_deltas[it.first];
+      if (delta) {
+        delta->merge(*it.second);
+      } else {
+        delta = std::move(it.second);
+      }
+    }
+    m_stmt_sketch_deltas.clear();
+  }
+
  public:
+  /*
+    The sketch collecting the changes of the current statement to the
+    cardinality sketch of an index.
+  */
+  Rdb_index_sketch *get_sketch_delta(
+      const std::shared_ptr<Rdb_index_sketch> &sketch) {
+    auto &delta = m_stmt_sketch_deltas[sketch];
+    if (!delta) {
+      delta.reset(new Rdb_index_sketch(sketch->get_key_parts()));
+    }
+    return delta.get();
+  }
+
   void log_table_write_op(Rdb_tbl_def *tbl) {
     modified_tables.insert(tbl);
   }
@@ -3485,6 +3647,7 @@ class Rdb_transaction {
       do_set_savepoint();
       m_writes_at_last_savepoint = m_write_count;
     }
+    merge_stmt_sketch_deltas();
 
     return HA_EXIT_SUCCESS;
   }
@@ -3505,6 +3668,7 @@ class Rdb_transaction {
       do_set_savepoint();
       m_write_count = m_writes_at_last_savepoint;
     }
+    m_stmt_sketch_deltas.clear();
   }
 
   virtual void rollback_stmt() = 0;
@@ -5872,6 +6036,21 @@ static int rocksdb_init_func(void *const p) {
     DBUG_RETURN(HA_EXIT_FAILURE);
   }
 
+  if (!cf_options_map->set_tiering(rocksdb_datadir, rocksdb_cold_data_dir,
+                                   rocksdb_tiered_cf_options)) {
+    // NO_LINT_DEBUG
+    sql_print_error("RocksDB: Failed to initialize tiered CF options.");
+    DBUG_RETURN(HA_EXIT_FAILURE);
+  }
+
+  if (*rocksdb_cold_data_dir) {
+    status = rocksdb_db_options->env->CreateDirIfMissing(rocksdb_cold_data_dir);
+    if (!status.ok()) {
+      rdb_log_status_error(status, "Failed to create cold data directory");
+      DBUG_RETURN(HA_EXIT_FAILURE);
+    }
+  }
+
   /*
     If there are no column families, we're creating the new database.
     Create one column family named "default".
@@ -5896,6 +6075,13 @@ static int rocksdb_init_func(void *const p) {
     sql_print_information("    target_file_size_base=%" PRIu64,
                           opts.target_file_size_base);
 
+    if (!opts.cf_paths.empty()) {
+      // NO_LINT_DEBUG
+      sql_print_information("    hot_tier_size=%" PRIu64 " cold_data_dir=%s",
+                            opts.cf_paths.front().target_size,
+                            opts.cf_paths.back().path.c_str());
+    }
+
     /*
       Temporarily disable compactions to prevent a race condition where
       compaction starts before compaction filter is ready.
@@ -6614,6 +6800,9 @@ ha_rocksdb::ha_rocksdb(my_core::handlerton *const hton,
       m_scan_it(nullptr),
       m_scan_it_skips_bloom(false),
       m_scan_it_snapshot(nullptr),
+      m_scan_it_readahead_countdown(0),
+      m_scan_it_readahead(false),
+      m_scan_it_readahead_rows(0),
       m_scan_it_lower_bound(nullptr),
       m_scan_it_upper_bound(nullptr),
       m_tbl_def(nullptr),
@@ -7114,6 +7303,7 @@ int ha_rocksdb::close(void) {
   m_pk_descr = nullptr;
   m_key_descr_arr = nullptr;
   m_converter = nullptr;
+  m_bypass_plan_cache = nullptr;
   free_key_buffers();
 
   if (m_table_handler != nullptr) {
@@ -7804,12 +7994,17 @@ int ha_rocksdb::create_key_def(const TABLE *const table_arg, const uint i,
   uchar index_type;
   uint16_t kv_version;
 
+  // The value offset directory is opt-in as older binaries can't read it
+  const uint16 pk_latest_version =
+      rocksdb_enable_pk_value_offsets
+          ? Rdb_key_def::PRIMARY_FORMAT_VERSION_LATEST
+          : Rdb_key_def::PRIMARY_FORMAT_VERSION_TTL;
+
   if (is_hidden_pk(i, table_arg, tbl_def_arg)) {
     index_type = Rdb_key_def::INDEX_TYPE_HIDDEN_PRIMARY;
-    kv_version = Rdb_key_def::PRIMARY_FORMAT_VERSION_LATEST;
+    kv_version = pk_latest_version;
   } else if (i == table_arg->s->primary_key) {
     index_type = Rdb_key_def::INDEX_TYPE_PRIMARY;
-    uint16 pk_latest_version = Rdb_key_def::PRIMARY_FORMAT_VERSION_LATEST;
     kv_version = pk_latest_version;
   } else {
     index_type = Rdb_key_def::INDEX_TYPE_SECONDARY;
@@ -8870,6 +9065,14 @@ int ha_rocksdb::index_read_map_impl(uchar *const buf, const uchar *const key,
 
     rc = get_row_by_rowid(buf, m_pk_packed_tuple, size, skip_lookup, false);
 
+    if (!skip_lookup) {
+      record_bloom_lookup(
+          kd,
+          rocksdb::Slice(reinterpret_cast<const char *>(m_pk_packed_tuple),
+                         size),
+          true, rc);
+    }
+
     if (!rc && !skip_lookup) {
       stats.rows_read++;
       stats.rows_index_first++;
@@ -8981,6 +9184,11 @@ int ha_rocksdb::index_read_map_impl(uchar *const buf, const uchar *const key,
         position_to_correct_key(kd, find_flag, using_full_key, key, keypart_map,
                                 slice, &move_forward, tx->m_snapshot_timestamp);
 
+    if (find_flag == HA_READ_KEY_EXACT) {
+      record_bloom_lookup(kd, rocksdb::Slice(slice.data(), eq_cond_len),
+                          use_all_keys, rc);
+    }
+
     if (rc) {
       break;
     }
@@ -9513,6 +9721,7 @@ int ha_rocksdb::index_next_with_direction(uchar *const buf, bool move_forward) {
         } else {
           m_scan_it->Prev();
         }
+        scan_it_next_row(*m_key_descr_arr[active_index], move_forward);
       }
       rc = rocksdb_skip_expired_records(*m_key_descr_arr[active_index],
                                         m_scan_it, !move_forward);
@@ -10432,7 +10641,8 @@ int ha_rocksdb::bulk_load_key(Rdb_transaction *const tx, const Rdb_key_def &kd,
   if (m_sst_info == nullptr || m_sst_info->is_done()) {
     m_sst_info.reset(new Rdb_sst_info(rdb, m_table_handler->m_table_name,
                                       kd.get_name(), cf, *rocksdb_db_options,
-                                      THDVAR(ha_thd(), trace_sst_api)));
+                                      THDVAR(ha_thd(), trace_sst_api),
+                                      THDVAR(ha_thd(), bulk_load_writer_threads)));
     res = tx->start_bulk_load(this, m_sst_info);
     if (res != HA_EXIT_SUCCESS) {
       DBUG_RETURN(res);
@@ -10585,6 +10795,13 @@ int ha_rocksdb::update_write_pk(const Rdb_key_def &kd,
   if (rc == HA_EXIT_SUCCESS) {
     row_info.tx->update_bytes_written(
         bytes_written + row_info.new_pk_slice.size() + value_slice.size());
+
+    if (kd.m_sketch && (row_info.old_data == nullptr || pk_changed)) {
+      Rdb_index_sketch *const delta =
+          row_info.tx->get_sketch_delta(kd.m_sketch);
+      kd.sketch_key(row_info.new_pk_slice, delta);
+      if (row_info.old_data == nullptr) delta->add_rows(1);
+    }
   }
   return rc;
 }
@@ -10694,6 +10911,12 @@ int ha_rocksdb::update_write_sk(const TABLE *const table_arg,
   row_info.tx->update_bytes_written(bytes_written + new_key_slice.size() +
                                     new_value_slice.size());
 
+  if (kd.m_sketch && rc == HA_EXIT_SUCCESS) {
+    Rdb_index_sketch *const delta = row_info.tx->get_sketch_delta(kd.m_sketch);
+    kd.sketch_key(new_key_slice, delta);
+    if (row_info.old_data == nullptr) delta->add_rows(1);
+  }
+
   return rc;
 }
 
@@ -10930,6 +11153,15 @@ void ha_rocksdb::setup_scan_iterator(const Rdb_key_def &kd,
     release_scan_iterator();
   }
 
+  /*
+    Every call starts a new range or a new lookup, which says nothing about
+    whether it will be long. Go back to an iterator without readahead, it's
+    re-armed below.
+  */
+  if (m_scan_it_readahead) {
+    release_scan_iterator();
+  }
+
   /*
     SQL layer can call rnd_init() multiple times in a row.
     In that case, re-use the iterator, but re-position it at the table start.
@@ -10952,9 +11184,88 @@ void ha_rocksdb::setup_scan_iterator(const Rdb_key_def &kd,
     }
     m_scan_it_skips_bloom = skip_bloom;
   }
+
+  // Count the rows of this range only. Scans on the snapshot of
+  // commit_in_the_middle are not switched to readahead, see
+  // enable_scan_readahead()
+  if (m_scan_it_snapshot == nullptr &&
+      THDVAR(ha_thd(), scan_readahead_size) > 0) {
+    m_scan_it_readahead_countdown =
+        THDVAR(ha_thd(), scan_readahead_after_rows);
+  } else {
+    m_scan_it_readahead_countdown = 0;
+  }
+}
+
+/*
+  Called every time m_scan_it is moved to the next row of a scan
+*/
+inline void ha_rocksdb::scan_it_next_row(const Rdb_key_def &kd,
+                                         const bool move_forward) {
+  if (m_scan_it_readahead) {
+    m_scan_it_readahead_rows++;
+  } else if (m_scan_it_readahead_countdown > 0 &&
+             --m_scan_it_readahead_countdown == 0) {
+    enable_scan_readahead(kd, move_forward);
+  }
+}
+
+/*
+  A scan that has read rocksdb_scan_readahead_after_rows rows with the same
+  iterator is most likely a long sequential scan. Re-open the iterator with
+  readahead at the current position, so that the upcoming data blocks of
+  each SST file are read in large chunks instead of one block at a time.
+*/
+void ha_rocksdb::enable_scan_readahead(const Rdb_key_def &kd,
+                                       const bool move_forward) {
+  DBUG_ASSERT(m_scan_it != nullptr);
+  DBUG_ASSERT(!m_scan_it_readahead);
+
+  if (m_scan_it_snapshot != nullptr || !is_valid_iterator(m_scan_it)) {
+    return;
+  }
+
+  const std::string key = m_scan_it->key().ToString();
+  Rdb_transaction *const tx = get_or_create_tx(table->in_use);
+  rocksdb::Iterator *const it = tx->get_iterator(
+      kd.get_cf(), m_scan_it_skips_bloom, !THDVAR(ha_thd(), skip_fill_cache),
+      m_scan_it_lower_bound_slice, m_scan_it_upper_bound_slice,
+      false /* read_current */, true /* create_snapshot */,
+      THDVAR(ha_thd(), scan_readahead_size));
+
+  if (move_forward) {
+    it->Seek(key);
+  } else {
+    it->SeekForPrev(key);
+  }
+
+  // Both iterators read from the same snapshot, so the new one must land on
+  // the very same key. Keep using the old one if it didn't for any reason.
+  if (!is_valid_iterator(it) || it->key() != rocksdb::Slice(key)) {
+    delete it;
+    return;
+  }
+
+  delete m_scan_it;
+  m_scan_it = it;
+  m_scan_it_readahead = true;
+  m_scan_it_readahead_rows = 0;
+  rocksdb_scan_readahead_scans++;
 }
 
 void ha_rocksdb::release_scan_iterator() {
+  if (m_scan_it_readahead) {
+    // A scan that ended soon after switching to readahead has most likely
+    // read ahead data it never used
+    rocksdb_scan_readahead_rows += m_scan_it_readahead_rows;
+    if (m_scan_it_readahead_rows <
+        THDVAR(ha_thd(), scan_readahead_after_rows)) {
+      rocksdb_scan_readahead_wasted++;
+    }
+    m_scan_it_readahead = false;
+  }
+  m_scan_it_readahead_countdown = 0;
+
   delete m_scan_it;
   m_scan_it = nullptr;
 
@@ -11080,6 +11391,7 @@ int ha_rocksdb::rnd_next_with_direction(uchar *const buf, bool move_forward) {
       } else {
         m_scan_it->Prev(); /* this call cannot fail */
       }
+      scan_it_next_row(*m_pk_descr, move_forward);
     }
 
     if (!is_valid_iterator(m_scan_it)) {
@@ -11329,6 +11641,13 @@ int ha_rocksdb::delete_row(const uchar *const buf) {
   tx->incr_delete_count();
   tx->log_table_write_op(m_tbl_def);
 
+  // Deleted keys stay in the sketches, only the row count goes down
+  for (uint i = 0; i < m_tbl_def->m_key_count; i++) {
+    if (m_key_descr_arr[i]->m_sketch) {
+      tx->get_sketch_delta(m_key_descr_arr[i]->m_sketch)->add_rows(-1);
+    }
+  }
+
   if (do_bulk_commit(tx)) {
     DBUG_RETURN(HA_ERR_ROCKSDB_BULK_LOAD);
   }
@@ -11402,6 +11721,52 @@ int ha_rocksdb::adjust_handler_stats_table_scan() {
   DBUG_RETURN(HA_EXIT_SUCCESS);
 }
 
+/*
+  Set rec_per_key of the keys from the index statistics, or from the
+  cardinality sketches if they have seen more rows than the statistics.
+*/
+void ha_rocksdb::update_rec_per_key() {
+  for (uint i = 0; i < m_tbl_def->m_key_count; i++) {
+    if (is_hidden_pk(i, table, m_tbl_def)) {
+      continue;
+    }
+    KEY *const k = &table->key_info[i];
+    for (uint j = 0; j < k->actual_key_parts; j++) {
+      const Rdb_index_stats &k_stats = m_key_descr_arr[i]->m_stats;
+      const auto &k_sketch = m_key_descr_arr[i]->m_sketch;
+      uint x;
+
+      if (k_sketch && j < k_sketch->get_key_parts() &&
+          k_sketch->get_rows() > k_stats.m_rows) {
+        x = k_sketch->get_rec_per_key(j);
+      } else if (k_stats.m_distinct_keys_per_prefix.size() > j &&
+                 k_stats.m_distinct_keys_per_prefix[j] > 0) {
+        x = k_stats.m_rows / k_stats.m_distinct_keys_per_prefix[j];
+        /*
+          If the number of rows is less than the number of prefixes (due to
+          sampling), the average number of rows with the same prefix is 1.
+         */
+        if (x == 0) {
+          x = 1;
+        }
+      } else {
+        x = 0;
+      }
+      if (x > stats.records) x = stats.records;
+      if ((x == 0 && rocksdb_debug_optimizer_no_zero_cardinality) ||
+          rocksdb_debug_optimizer_n_rows > 0) {
+        // Fake cardinality implementation. For example, (idx1, idx2, idx3)
+        // index
+        // will have rec_per_key for (idx1)=4, (idx1,2)=2, and (idx1,2,3)=1.
+        // rec_per_key for the whole index is 1, and multiplied by 2^n if
+        // n suffix columns of the index are not used.
+        x = 1 << (k->actual_key_parts - j - 1);
+      }
+      k->rec_per_key[j] = x;
+    }
+  }
+}
+
 /**
   @return
     HA_EXIT_SUCCESS  OK
@@ -11449,43 +11814,13 @@ int ha_rocksdb::info(uint flag) {
   if (flag & HA_STATUS_CONST) {
     ref_length = m_pk_descr->max_storage_fmt_length();
 
-    for (uint i = 0; i < m_tbl_def->m_key_count; i++) {
-      if (is_hidden_pk(i, table, m_tbl_def)) {
-        continue;
-      }
-      KEY *const k = &table->key_info[i];
-      for (uint j = 0; j < k->actual_key_parts; j++) {
-        const Rdb_index_stats &k_stats = m_key_descr_arr[i]->m_stats;
-        uint x;
-
-        if (k_stats.m_distinct_keys_per_prefix.size() > j &&
-            k_stats.m_distinct_keys_per_prefix[j] > 0) {
-          x = k_stats.m_rows / k_stats.m_distinct_keys_per_prefix[j];
-          /*
-            If the number of rows is less than the number of prefixes (due to
-            sampling), the average number of rows with the same prefix is 1.
-           */
-          if (x == 0) {
-            x = 1;
-          }
-        } else {
-          x = 0;
-        }
-        if (x > stats.records) x = stats.records;
-        if ((x == 0 && rocksdb_debug_optimizer_no_zero_cardinality) ||
-            rocksdb_debug_optimizer_n_rows > 0) {
-          // Fake cardinality implementation. For example, (idx1, idx2, idx3)
-          // index
-          // will have rec_per_key for (idx1)=4, (idx1,2)=2, and (idx1,2,3)=1.
-          // rec_per_key for the whole index is 1, and multiplied by 2^n if
-          // n suffix columns of the index are not used.
-          x = 1 << (k->actual_key_parts - j - 1);
-        }
-        k->rec_per_key[j] = x;
-      }
-    }
+    update_rec_per_key();
 
     stats.create_time = m_tbl_def->get_create_time();
+  } else if ((flag & HA_STATUS_VARIABLE) && rocksdb_table_stats_use_sketches) {
+    // The sketches change with every write, so don't wait for ANALYZE TABLE
+    // or the table to be reopened
+    update_rec_per_key();
   }
 
   if (flag & HA_STATUS_TIME) {
@@ -14431,6 +14766,19 @@ static SHOW_VAR rocksdb_status_vars[] = {
                        &rocksdb_select_bypass_rejected, SHOW_LONGLONG),
     DEF_STATUS_VAR_PTR("select_bypass_failed", &rocksdb_select_bypass_failed,
                        SHOW_LONGLONG),
+    DEF_STATUS_VAR_PTR("select_bypass_plan_cache_hits",
+                       &rocksdb_select_bypass_plan_cache_hits, SHOW_LONGLONG),
+    DEF_STATUS_VAR_PTR("select_bypass_plan_cache_misses",
+                       &rocksdb_select_bypass_plan_cache_misses,
+                       SHOW_LONGLONG),
+    DEF_STATUS_VAR_PTR("scan_readahead_scans", &rocksdb_scan_readahead_scans,
+                       SHOW_LONGLONG),
+    DEF_STATUS_VAR_PTR("scan_readahead_rows", &rocksdb_scan_readahead_rows,
+                       SHOW_LONGLONG),
+    DEF_STATUS_VAR_PTR("scan_readahead_wasted", &rocksdb_scan_readahead_wasted,
+                       SHOW_LONGLONG),
+    DEF_STATUS_VAR_PTR("bloom_filter_costed_ranges",
+                       &rocksdb_bloom_filter_costed_ranges, SHOW_LONGLONG),
     // the variables generated by SHOW_FUNC are sorted only by prefix (first
     // arg in the tuple below), so make sure it is unique to make sorting
     // deterministic as quick sort is not stable
@@ -14480,6 +14828,10 @@ void Rdb_background_thread::run() {
       ddl_manager.persist_stats();
     }
 
+    if (rocksdb_table_stats_use_sketches) {
+      ddl_manager.persist_sketches();
+    }
+
     timespec ts;
     clock_gettime(CLOCK_REALTIME, &ts);
 
@@ -14528,6 +14880,9 @@ void Rdb_background_thread::run() {
 
   // save remaining stats which might've left unsaved
   ddl_manager.persist_stats();
+  if (rocksdb_table_stats_use_sketches) {
+    ddl_manager.persist_sketches();
+  }
 }
 
 void Rdb_index_stats_thread::run() {
@@ -14931,6 +15286,26 @@ bool ha_rocksdb::check_bloom_and_set_bounds(
   return can_use_bloom;
 }
 
+/**
+  Count a point lookup of the index for its bloom filter statistics, see
+  bloom_filter_positive_ratio().
+
+  @param kd
+  @param eq_cond      Equal condition part of the key
+  @param use_all_keys True if all key parts are set with equal conditions
+  @param rc           Result of the lookup
+*/
+void ha_rocksdb::record_bloom_lookup(const Rdb_key_def &kd,
+                                     const rocksdb::Slice &eq_cond,
+                                     const bool use_all_keys, const int rc) {
+  if (!kd.has_bloom_filter() || (rc && rc != HA_ERR_KEY_NOT_FOUND) ||
+      !can_use_bloom_filter(ha_thd(), kd, eq_cond, use_all_keys)) {
+    return;
+  }
+  kd.m_bloom_lookups++;
+  if (!rc) kd.m_bloom_lookups_found++;
+}
+
 /**
   Deciding if it is possible to use bloom filter or not.
 
@@ -15916,6 +16291,10 @@ get_select_bypass_multiget_min() {
   return rocksdb_select_bypass_multiget_min;
 }
 
+uint32_t get_select_bypass_plan_cache_size() {
+  return rocksdb_select_bypass_plan_cache_size;
+}
+
 const rocksdb::ReadOptions &rdb_tx_acquire_snapshot(Rdb_transaction *tx) {
   tx->acquire_snapshot(true);
   return tx->m_read_opts;
@@ -15975,21 +16354,47 @@ ha_rows ha_rocksdb::multi_range_read_info_const(uint keyno, RANGE_SEQ_IF *seq,
   ha_rows res;
   THD *thd = table->in_use;
 
-  // We allow MultiGet-MRR only with these settings:
+  // MultiGet-MRR is always used with these settings:
   //   optimizer_switch='mrr=on,mrr_cost_based=off'
-  // mrr_cost_based is not supported
+  // With mrr_cost_based=on, it is used where it is cheaper than the default
+  // implementation if @@rocksdb_mrr_cost_based_multiget is set.
   bool mrr_enabled =
       thd->optimizer_switch_flag(OPTIMIZER_SWITCH_MRR) &&
       !thd->optimizer_switch_flag(OPTIMIZER_SWITCH_MRR_COST_BASED);
+  bool mrr_cost_based = thd->optimizer_switch_flag(OPTIMIZER_SWITCH_MRR) &&
+                        THDVAR(thd, mrr_cost_based_multiget) &&
+                        !mrr_enabled;
   uint def_bufsz = *bufsz;
   res = handler::multi_range_read_info_const(keyno, seq, seq_init_param,
                                              n_ranges, &def_bufsz, flags, cost);
 
   if (res == HA_POS_ERROR) return res;  // Not possible to do the scan
 
+  if (THDVAR(thd, bloom_filter_aware_costing)) {
+    uint total_ranges = 0;
+    const ha_rows bloom_ranges = bloom_filter_ranges(
+        keyno, seq, seq_init_param, n_ranges, *flags, &total_ranges);
+    if (bloom_ranges == HA_POS_ERROR) return HA_POS_ERROR;
+    double positive_ratio;
+    if (bloom_ranges > 0 &&
+        bloom_filter_positive_ratio(*m_key_descr_arr[keyno],
+                                    &positive_ratio)) {
+      rocksdb_bloom_filter_costed_ranges += bloom_ranges;
+      // Lookups the filter rules out only pay for the filter check
+      const double skipped =
+          (1.0 - positive_ratio) * (1.0 - ROCKSDB_BLOOM_FILTER_SKIP_COST);
+      Cost_estimate bloom_cost;
+      bloom_cost.add_io(cost->get_io_cost() *
+                        (1.0 - skipped * bloom_ranges / total_ranges));
+      bloom_cost.add_cpu(cost->get_cpu_cost());
+      *cost = bloom_cost;
+    }
+  }
+
   // Use the default MRR implementation if @@optimizer_switch value tells us
   // to, or if the query needs to do a locking read.
-  if (!mrr_enabled || m_lock_rows != RDB_LOCK_NONE) return res;
+  if ((!mrr_enabled && !mrr_cost_based) || m_lock_rows != RDB_LOCK_NONE)
+    return res;
 
   // How many buffer required to store all requried keys
   uint calculated_buf = mrr_get_length_per_rec() * res * 10 + 1;
@@ -16022,7 +16427,8 @@ ha_rows ha_rocksdb::multi_range_read_info_const(uint keyno, RANGE_SEQ_IF *seq,
       if (table->in_use->killed) return HA_POS_ERROR;
     }
 
-    if (all_eq_ranges) {
+    if (all_eq_ranges &&
+        (mrr_enabled || mrr_multiget_is_cheaper(keyno, res, cost))) {
       // Indicate that we will use MultiGet MRR
       *flags &= ~HA_MRR_USE_DEFAULT_IMPL;
       *flags |= HA_MRR_SUPPORT_SORTED;
@@ -16031,7 +16437,8 @@ ha_rows ha_rocksdb::multi_range_read_info_const(uint keyno, RANGE_SEQ_IF *seq,
   } else {
     // For scans on secondary keys, we use MultiGet when we read the PK values.
     // We only need PK values when the scan is non-index-only.
-    if (!(*flags & HA_MRR_INDEX_ONLY)) {
+    if (!(*flags & HA_MRR_INDEX_ONLY) &&
+        (mrr_enabled || mrr_multiget_is_cheaper(keyno, res, cost))) {
       *flags &= ~HA_MRR_USE_DEFAULT_IMPL;
       *flags |= HA_MRR_SUPPORT_SORTED;
       *flags |= HA_MRR_CONVERT_REF_TO_RANGE;
@@ -16043,6 +16450,121 @@ ha_rows ha_rocksdb::multi_range_read_info_const(uint keyno, RANGE_SEQ_IF *seq,
 }
 
 
+/*
+  Count the equality ranges that can use the bloom filter of the index.
+
+  @param  keyno           Index to scan
+  @param  seq             Range sequence
+  @param  seq_init_param  Range sequence initialization parameter
+  @param  n_ranges        Number of ranges in the sequence
+  @param  flags           MRR flags the sequence was initialized with
+  @param  total_ranges OUT  Number of ranges in the sequence
+
+  @return
+    Number of ranges whose lookups are checked against the bloom filter, or
+    HA_POS_ERROR if the query was killed
+*/
+ha_rows ha_rocksdb::bloom_filter_ranges(uint keyno, RANGE_SEQ_IF *seq,
+                                        void *seq_init_param, uint n_ranges,
+                                        uint flags, uint *total_ranges) {
+  const Rdb_key_def &kd = *m_key_descr_arr[keyno];
+  *total_ranges = 0;
+  if (!kd.has_bloom_filter()) return 0;
+
+  THD *thd = table->in_use;
+
+  // The handler's own key buffers may be in use by a scan that is open
+  // while the ranges are costed, e.g. when a join re-plans its range access
+  const uint max_size = kd.max_storage_fmt_length();
+  uchar *const pack_buffer = static_cast<uchar *>(thd->alloc(max_size));
+  uchar *const packed_tuple = static_cast<uchar *>(thd->alloc(max_size));
+  if (pack_buffer == nullptr || packed_tuple == nullptr) return HA_POS_ERROR;
+
+  ha_rows bloom_ranges = 0;
+  KEY_MULTI_RANGE range;
+  range_seq_t seq_it = seq->init(seq_init_param, n_ranges, flags);
+  while (!seq->next(seq_it, &range)) {
+    if (thd->killed) return HA_POS_ERROR;
+    (*total_ranges)++;
+    if (!(range.range_flag & EQ_RANGE)) continue;
+
+    const uint size =
+        kd.pack_index_tuple(table, pack_buffer, packed_tuple,
+                            range.start_key.key, range.start_key.keypart_map);
+    const rocksdb::Slice eq_cond(reinterpret_cast<const char *>(packed_tuple),
+                                 size);
+    const bool use_all_keys =
+        my_count_bits(range.start_key.keypart_map) == kd.get_key_parts();
+    if (can_use_bloom_filter(thd, kd, eq_cond, use_all_keys)) bloom_ranges++;
+  }
+  return bloom_ranges;
+}
+
+/*
+  Fraction of the point lookups of an index that found a key, among the ones
+  that could use its bloom filter. The others are the lookups the filter can
+  rule out, so this is how often the filter of this index lets a lookup
+  through.
+
+  @param  kd          The index
+  @param  ratio  OUT  The fraction
+
+  @return
+    false  No lookup was recorded yet, so there is nothing to go by
+    true   Otherwise
+*/
+bool ha_rocksdb::bloom_filter_positive_ratio(const Rdb_key_def &kd,
+                                             double *const ratio) const {
+  const uint64_t lookups = kd.m_bloom_lookups.load(std::memory_order_relaxed);
+  if (lookups == 0) return false;
+
+  const uint64_t found =
+      kd.m_bloom_lookups_found.load(std::memory_order_relaxed);
+  *ratio = std::min(1.0, static_cast<double>(found) / lookups);
+  return true;
+}
+
+/*
+  Check whether MultiGet-MRR is cheaper than the default MRR implementation.
+
+  @param  keyno       Index to scan
+  @param  rows        Expected number of rows
+  @param  cost  INOUT IN:  Estimated cost of the default implementation
+                      OUT: Estimated cost of MultiGet-MRR, if it is cheaper
+
+  For secondary keys, the index itself is read like in an index-only scan,
+  while the rows are fetched from the primary key with one MultiGet call per
+  @@rocksdb_mrr_batch_size keys.
+
+  @return
+    true   MultiGet-MRR should be used
+    false  Use the default implementation
+*/
+bool ha_rocksdb::mrr_multiget_is_cheaper(uint keyno, ha_rows rows,
+                                         Cost_estimate *cost) {
+  const long batch_size = THDVAR(table->in_use, mrr_batch_size);
+  if (batch_size == 0 || rows == 0) return false;
+
+  const double n_rows = rows2double(rows);
+  Cost_estimate multiget_cost;
+  if (keyno != table->s->primary_key) {
+    multiget_cost.add_io(index_only_read_time(keyno, n_rows) *
+                         Cost_estimate::IO_BLOCK_READ_COST());
+  }
+  const double n_batches = (rows + batch_size - 1) / batch_size;
+  multiget_cost.add_io(
+      (n_batches + n_rows * ROCKSDB_MRR_MULTIGET_KEY_COST) *
+      Cost_estimate::IO_BLOCK_READ_COST());
+
+  if (multiget_cost.get_io_cost() >= cost->get_io_cost()) return false;
+
+  // The optimizer costs the plan with what the storage engine will do
+  multiget_cost.add_cpu(cost->get_cpu_cost());
+  *cost = multiget_cost;
+  return true;
+}
+
+
 ha_rows ha_rocksdb::multi_range_read_info(uint keyno, uint n_ranges, uint keys,
                                           uint *bufsz, uint *flags,
                                           Cost_estimate *cost) {
@@ -16051,18 +16573,26 @@ ha_rows ha_rocksdb::multi_range_read_info(uint keyno, uint n_ranges, uint keys,
   bool mrr_enabled =
       thd->optimizer_switch_flag(OPTIMIZER_SWITCH_MRR) &&
       !thd->optimizer_switch_flag(OPTIMIZER_SWITCH_MRR_COST_BASED);
+  bool mrr_cost_based = thd->optimizer_switch_flag(OPTIMIZER_SWITCH_MRR) &&
+                        THDVAR(thd, mrr_cost_based_multiget) &&
+                        !mrr_enabled;
 
   res =
       handler::multi_range_read_info(keyno, n_ranges, keys, bufsz, flags, cost);
-  if (res || m_lock_rows != RDB_LOCK_NONE || !mrr_enabled) return res;
+  if (res || m_lock_rows != RDB_LOCK_NONE || (!mrr_enabled && !mrr_cost_based))
+    return res;
 
-  if (keyno == table->s->primary_key && (*flags & HA_MRR_FULL_EXTENDED_KEYS)) {
+  // This is also how batched key access decides whether it can be used, so
+  // BKA joins on MyRocks tables are done with MultiGet
+  if (keyno == table->s->primary_key && (*flags & HA_MRR_FULL_EXTENDED_KEYS) &&
+      (mrr_enabled || mrr_multiget_is_cheaper(keyno, keys, cost))) {
     *flags &= ~HA_MRR_USE_DEFAULT_IMPL;
     *flags |= HA_MRR_CONVERT_REF_TO_RANGE;
     *flags |= HA_MRR_SUPPORT_SORTED;
   }
 
-  if (keyno != table->s->primary_key && !(*flags & HA_MRR_INDEX_ONLY)) {
+  if (keyno != table->s->primary_key && !(*flags & HA_MRR_INDEX_ONLY) &&
+      (mrr_enabled || mrr_multiget_is_cheaper(keyno, keys, cost))) {
     *flags &= ~HA_MRR_USE_DEFAULT_IMPL;
     *flags |= HA_MRR_CONVERT_REF_TO_RANGE;
     *flags &= ~HA_MRR_SUPPORT_SORTED; // Non-sorted mode
@@ -68,6 +68,7 @@
 
 namespace myrocks {
 
+class Rdb_bypass_plan_cache;
 class Rdb_converter;
 class Rdb_key_def;
 class Rdb_tbl_def;
@@ -78,6 +79,7 @@ class Rdb_field_encoder;
 
 extern char *rocksdb_read_free_rpl_tables;
 extern ulong rocksdb_max_row_locks;
+extern my_bool rocksdb_table_stats_use_sketches;
 #if defined(HAVE_PSI_INTERFACE)
 extern PSI_rwlock_key key_rwlock_read_free_rpl_tables;
 #endif
@@ -152,6 +154,16 @@ class ha_rocksdb : public my_core::handler {
 
   const rocksdb::Snapshot *m_scan_it_snapshot;
 
+  /*
+    Rows left before m_scan_it is switched to readahead, 0 if it won't be.
+    See enable_scan_readahead().
+  */
+  uint m_scan_it_readahead_countdown;
+
+  /* Whether m_scan_it was re-opened with readahead, and rows read since */
+  bool m_scan_it_readahead;
+  uint64 m_scan_it_readahead_rows;
+
   /* Buffers used for upper/lower bounds for m_scan_it. */
   uchar *m_scan_it_lower_bound;
   uchar *m_scan_it_upper_bound;
@@ -225,6 +237,9 @@ class ha_rocksdb : public my_core::handler {
   /* class to convert between Mysql format and RocksDB format*/
   std::unique_ptr<Rdb_converter> m_converter;
 
+  /* Resolved SELECT bypass plans for this table, created on first use */
+  std::unique_ptr<Rdb_bypass_plan_cache> m_bypass_plan_cache;
+
   /*
     Pointer to the original TTL timestamp value (8 bytes) during UPDATE.
   */
@@ -327,6 +342,8 @@ class ha_rocksdb : public my_core::handler {
                            const bool use_all_keys, const uint eq_cond_len)
       MY_ATTRIBUTE((__nonnull__));
   void release_scan_iterator(void);
+  void scan_it_next_row(const Rdb_key_def &kd, const bool move_forward);
+  void enable_scan_readahead(const Rdb_key_def &kd, const bool move_forward);
 
   rocksdb::Status get_for_update(Rdb_transaction *const tx,
                                  const Rdb_key_def &kd,
@@ -703,6 +720,15 @@ class ha_rocksdb : public my_core::handler {
   void mrr_free_rows();
   void mrr_free();
   uint mrr_get_length_per_rec();
+  bool mrr_multiget_is_cheaper(uint keyno, ha_rows rows, Cost_estimate *cost);
+  ha_rows bloom_filter_ranges(uint keyno, RANGE_SEQ_IF *seq,
+                              void *seq_init_param, uint n_ranges, uint flags,
+                              uint *total_ranges);
+  bool bloom_filter_positive_ratio(const Rdb_key_def &kd,
+                                   double *const ratio) const;
+  void record_bloom_lookup(const Rdb_key_def &kd,
+                           const rocksdb::Slice &eq_cond,
+                           const bool use_all_keys, const int rc);
 
   struct key_def_cf_info {
     std::shared_ptr<rocksdb::ColumnFamilyHandle> cf_handle;
@@ -1018,9 +1044,11 @@ class ha_rocksdb : public my_core::handler {
   bool is_read_free_rpl_table() const;
   int adjust_handler_stats_sst_and_memtable();
   int adjust_handler_stats_table_scan();
+  void update_rec_per_key();
 
   void update_row_read(ulonglong count);
   static void inc_covered_sk_lookup();
+  Rdb_bypass_plan_cache *get_bypass_plan_cache();
 
   void build_decoder();
   void check_build_decoder();
@@ -1131,6 +1159,8 @@ uint32_t get_select_bypass_debug_row_delay();
 unsigned long long  // NOLINT(runtime/int)
 get_select_bypass_multiget_min();
 
+uint32_t get_select_bypass_plan_cache_size();
+
 Rdb_transaction *&get_tx_from_thd(THD *const thd);
 
 const rocksdb::ReadOptions &rdb_tx_acquire_snapshot(Rdb_transaction *tx);
@@ -1181,5 +1211,7 @@ bool rdb_tx_started(Rdb_transaction *tx);
 extern std::atomic<uint64_t> rocksdb_select_bypass_executed;
 extern std::atomic<uint64_t> rocksdb_select_bypass_rejected;
 extern std::atomic<uint64_t> rocksdb_select_bypass_failed;
+extern std::atomic<uint64_t> rocksdb_select_bypass_plan_cache_hits;
+extern std::atomic<uint64_t> rocksdb_select_bypass_plan_cache_misses;
 
 }  // namespace myrocks
@@ -95,8 +95,9 @@ struct sql_cond {
  */
 class select_parser {
  public:
-  select_parser(THD *thd, st_select_lex *select_lex)
-      : m_thd(thd), m_select_lex(select_lex) {
+  select_parser(THD *thd, st_select_lex *select_lex,
+                const Rdb_bypass_plan *plan = nullptr)
+      : m_thd(thd), m_select_lex(select_lex), m_plan(plan) {
     // Single table only
     DBUG_ASSERT(select_lex->table_list.elements == 1);
     m_table_list = select_lex->table_list.first;
@@ -257,12 +258,27 @@ class select_parser {
   uint64_t get_offset_limit() const { return m_offset_limit; }
   const char *get_error_msg() const { return m_error_msg; }
 
+  /*
+    Returns the resolved shape of the statement for reuse by later
+    statements with the same digest. Only valid after a successful parse
+   */
+  Rdb_bypass_plan get_plan() const {
+    return {m_index, m_field_list, m_cond_fields};
+  }
+
  private:
   THD *m_thd;
   TABLE *m_table;
   TABLE_LIST *m_table_list;
   st_select_lex *m_select_lex;
 
+  // Previously resolved shape of the same statement, if any
+  const Rdb_bypass_plan *m_plan;
+
+  // Fields referenced in WHERE in parse order, including the ones we
+  // end up skipping
+  std::vector<Field *> m_cond_fields;
+
   uint m_index;
   bool m_is_order_desc;
   std::vector<Field *> m_field_list;
@@ -277,6 +293,11 @@ class select_parser {
 
  private:
   bool parse_index() {
+    if (m_plan != nullptr) {
+      m_index = m_plan->m_index;
+      return false;
+    }
+
     if (m_table_list->index_hints != nullptr) {
       if (m_table_list->index_hints->elements == 1) {
         // Must be a FORCE INDEX
@@ -328,9 +349,14 @@ class select_parser {
 
       // At this point we only know field name and need to resolve the
       // field ourselves (under normal circumstances MySQL does it for us)
-      Field *field =
-          find_field_in_table(m_thd, m_table, name, strlen(name), false,
-                              &field_item->cached_field_index);
+      Field *field;
+      if (m_plan != nullptr &&
+          m_field_list.size() < m_plan->m_field_list.size()) {
+        field = m_plan->m_field_list[m_field_list.size()];
+      } else {
+        field = find_field_in_table(m_thd, m_table, name, strlen(name), false,
+                                    &field_item->cached_field_index);
+      }
       if (!field) {
         my_snprintf(m_error_msg_buf, sizeof(m_error_msg_buf) / sizeof(char),
                     "Unrecognized field name: '%s'", name);
@@ -474,15 +500,22 @@ class select_parser {
 
     // Locate the field
     auto field_name = field_arg->field_name;
-    Field *found =
-        find_field_in_table(m_thd, m_table, field_name, strlen(field_name),
-                            false, &field_arg->cached_field_index);
+    Field *found;
+    if (m_plan != nullptr &&
+        m_cond_fields.size() < m_plan->m_cond_fields.size()) {
+      found = m_plan->m_cond_fields[m_cond_fields.size()];
+    } else {
+      found = find_field_in_table(m_thd, m_table, field_name,
+                                  strlen(field_name), false,
+                                  &field_arg->cached_field_index);
+    }
     if (!found) {
       my_snprintf(m_error_msg_buf, sizeof(m_error_msg_buf) / sizeof(char),
                   "Unrecognized field name: '%s'", field_name);
       m_error_msg = m_error_msg_buf;
       return true;
     }
+    m_cond_fields.push_back(found);
 
     if (found->real_maybe_null()) {
       m_error_msg = "NULL fields not supported";
@@ -735,6 +768,7 @@ class select_exec {
   int eval_and_send();
   bool run_pk_point_query(txn_wrapper *txn);
   bool run_sk_point_query(txn_wrapper *txn);
+  bool run_sk_point_query_multiget(txn_wrapper *txn);
   bool pack_index_tuple(uint key_part_no, Rdb_string_writer *writer,
                         const Field *field, Item *item);
   bool pack_cond(uint key_part_no, const sql_cond &cond, bool is_start = true);
@@ -1522,6 +1556,10 @@ bool INLINE_ATTR select_exec::setup_iterator(txn_wrapper *txn,
 }
 
 bool INLINE_ATTR select_exec::run_sk_point_query(txn_wrapper *txn) {
+  if (m_key_index_tuples.size() > get_select_bypass_multiget_min()) {
+    return run_sk_point_query_multiget(txn);
+  }
+
   for (auto &writer : m_key_index_tuples) {
     if (unlikely(handle_killed())) {
       return true;
@@ -1558,6 +1596,127 @@ bool INLINE_ATTR select_exec::run_sk_point_query(txn_wrapper *txn) {
   return false;
 }
 
+/*
+  Run SK point query using MultiGet. Since the key is fully specified
+  (SK+PK), each packed key is the exact RocksDB key, so the whole IN-list
+  can be looked up with a single MultiGet on the SK column family.
+  Rows not covered by the SK are then resolved with a second MultiGet on
+  the PK column family, rather than one Get per row.
+ */
+bool INLINE_ATTR select_exec::run_sk_point_query_multiget(txn_wrapper *txn) {
+  size_t size = m_key_index_tuples.size();
+  std::vector<rocksdb::Slice> key_slices;
+  key_slices.reserve(size);
+  std::vector<rocksdb::PinnableSlice> value_slices(size);
+  std::vector<rocksdb::Status> statuses(size);
+
+  for (auto &writer : m_key_index_tuples) {
+    key_slices.push_back(writer.get_key_slice());
+  }
+
+  bool sorted_input = (m_key_def->m_is_reverse_cf == m_parser.is_order_desc());
+
+  txn->multi_get(m_key_def->get_cf(), size, sorted_input, key_slices.data(),
+                 value_slices.data(), statuses.data());
+
+  // For each found SK entry not covering the lookup, remember the index
+  // into the PK lookup batch. -1 means the row is either missing or can be
+  // unpacked from the SK alone
+  std::vector<int> pk_lookup_pos(size, -1);
+  uint pk_lookup_count = 0;
+  std::vector<uchar> pk_tuple_buf;
+  std::vector<uint> pk_tuple_sizes;
+
+  for (size_t i = 0; i < size; ++i) {
+    if (statuses[i].IsNotFound()) {
+      continue;
+    } else if (!statuses[i].ok()) {
+      txn->report_error(statuses[i]);
+      return true;
+    }
+
+    if (m_keyread_only ||
+        m_key_def->covers_lookup(&value_slices[i], &m_lookup_bitmap)) {
+      continue;
+    }
+
+    // Extract PK from the SK - all PK tuples are packed back to back in
+    // pk_tuple_buf so that the slices stay valid through the MultiGet
+    size_t offset = pk_tuple_buf.size();
+    pk_tuple_buf.resize(offset + m_pk_def->max_storage_fmt_length());
+    uint pk_tuple_size = m_key_def->get_primary_key_tuple(
+        m_table, *m_pk_def, &key_slices[i], pk_tuple_buf.data() + offset);
+    if (pk_tuple_size == RDB_INVALID_KEY_LEN) {
+      m_handler->print_error(HA_ERR_ROCKSDB_CORRUPT_DATA, 0);
+      return true;
+    }
+    pk_tuple_buf.resize(offset + pk_tuple_size);
+    pk_tuple_sizes.push_back(pk_tuple_size);
+    pk_lookup_pos[i] = pk_lookup_count++;
+  }
+
+  std::vector<rocksdb::Slice> pk_slices;
+  pk_slices.reserve(pk_lookup_count);
+  size_t offset = 0;
+  for (uint pk_tuple_size : pk_tuple_sizes) {
+    pk_slices.emplace_back(
+        reinterpret_cast<const char *>(pk_tuple_buf.data() + offset),
+        pk_tuple_size);
+    offset += pk_tuple_size;
+  }
+
+  std::vector<rocksdb::PinnableSlice> pk_values(pk_lookup_count);
+  std::vector<rocksdb::Status> pk_statuses(pk_lookup_count);
+  if (pk_lookup_count > 0) {
+    // PK order doesn't necessarily follow SK order
+    txn->multi_get(m_pk_def->get_cf(), pk_lookup_count, false /* sorted */,
+                   pk_slices.data(), pk_values.data(), pk_statuses.data());
+  }
+
+  for (size_t i = 0; i < size; ++i) {
+    if (unlikely(handle_killed())) {
+      return true;
+    }
+
+    if (statuses[i].IsNotFound()) {
+      continue;
+    }
+
+    int rc;
+    int pos = pk_lookup_pos[i];
+    if (pos < 0) {
+      rc = m_key_def->unpack_record(
+          m_table, m_table->record[0], &key_slices[i], &value_slices[i],
+          m_converter->get_verify_row_debug_checksums());
+      if (!rc) {
+        ha_rocksdb::inc_covered_sk_lookup();
+      }
+    } else {
+      if (!pk_statuses[pos].ok()) {
+        txn->report_error(pk_statuses[pos]);
+        return true;
+      }
+      rc = m_converter->decode(m_pk_def, m_table->record[0], &pk_slices[pos],
+                               &pk_values[pos]);
+    }
+
+    if (rc) {
+      m_handler->print_error(rc, 0);
+      return true;
+    }
+
+    int ret = eval_and_send();
+    if (ret > 0) {
+      return true;
+    } else if (ret < 0) {
+      // no more items
+      return false;
+    }
+  }
+
+  return false;
+}
+
 /*
   Evaluate the condition using item->val_int, assuming item pointing
   to record[0] and is already unpacked.
@@ -1928,6 +2087,27 @@ bool handle_unsupported_bypass(THD *thd, const char *error_msg) {
   }
 }
 
+/*
+  Compute the key for the bypass plan cache from the statement digest.
+  Returns false if no usable digest was computed for the statement
+ */
+static bool get_bypass_plan_key(THD *thd, std::string *key) {
+  if (thd->m_digest == nullptr) {
+    return false;
+  }
+
+  sql_digest_storage *digest_storage = &thd->m_digest->m_digest_storage;
+  if (digest_storage->is_empty() || digest_storage->m_full) {
+    // A truncated digest could be shared by different statements
+    return false;
+  }
+
+  uchar md5[MD5_HASH_SIZE];
+  compute_digest_md5(digest_storage, md5);
+  key->assign(reinterpret_cast<char *>(md5), MD5_HASH_SIZE);
+  return true;
+}
+
 bool rocksdb_handle_single_table_select(THD *thd, SELECT_LEX *select_lex) {
   // Checks for hint and policy
   if (!is_bypass_on(select_lex)) {
@@ -1935,12 +2115,33 @@ bool rocksdb_handle_single_table_select(THD *thd, SELECT_LEX *select_lex) {
     return false;
   }
 
+  // Look for an already resolved plan of the same statement shape
+  Rdb_bypass_plan_cache *plan_cache = nullptr;
+  const Rdb_bypass_plan *plan = nullptr;
+  std::string plan_key;
+  uint32_t plan_cache_size = get_select_bypass_plan_cache_size();
+  if (plan_cache_size > 0 && get_bypass_plan_key(thd, &plan_key)) {
+    auto handler =
+        static_cast<ha_rocksdb *>(select_lex->table_list.first->table->file);
+    plan_cache = handler->get_bypass_plan_cache();
+    plan = plan_cache->find(plan_key);
+    if (plan != nullptr) {
+      rocksdb_select_bypass_plan_cache_hits++;
+    } else {
+      rocksdb_select_bypass_plan_cache_misses++;
+    }
+  }
+
   // Parse the SELECT statement
-  select_parser select_stmt(thd, select_lex);
+  select_parser select_stmt(thd, select_lex, plan);
   if (select_stmt.parse()) {
     return handle_unsupported_bypass(thd, select_stmt.get_error_msg());
   }
 
+  if (plan_cache != nullptr && plan == nullptr) {
+    plan_cache->insert(plan_key, select_stmt.get_plan(), plan_cache_size);
+  }
+
   // Execute SELECT statement
   select_exec exec(select_stmt);
   if (exec.run()) {
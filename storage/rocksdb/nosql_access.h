@@ -20,6 +20,7 @@
 #include <deque>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 /* C standard header files */
@@ -42,6 +43,46 @@ struct REJECTED_ITEM {
 
 namespace myrocks {
 
+/*
+  Shape of a bypass SELECT as resolved against one TABLE instance: the
+  index used and the fields referenced by the select list and WHERE clause,
+  in parse order. Statements with the same digest only differ in their
+  constants, so they resolve to the same shape and only need to bind the
+  new values.
+ */
+struct Rdb_bypass_plan {
+  uint m_index;
+  std::vector<Field *> m_field_list;
+  std::vector<Field *> m_cond_fields;
+};
+
+/*
+  Per-handler cache of bypass plans keyed by statement digest. Field
+  pointers are only valid for the TABLE the handler belongs to, so the
+  cache lives and dies with the handler and needs no locking.
+ */
+class Rdb_bypass_plan_cache {
+ public:
+  const Rdb_bypass_plan *find(const std::string &digest) const {
+    const auto it = m_plans.find(digest);
+    return it == m_plans.end() ? nullptr : &it->second;
+  }
+
+  void insert(const std::string &digest, Rdb_bypass_plan &&plan,
+              size_t max_size) {
+    if (m_plans.size() >= max_size) {
+      // Shapes are few in practice - start over rather than tracking LRU
+      m_plans.clear();
+    }
+    m_plans.emplace(digest, std::move(plan));
+  }
+
+  void clear() { m_plans.clear(); }
+
+ private:
+  std::unordered_map<std::string, Rdb_bypass_plan> m_plans;
+};
+
 bool rocksdb_handle_single_table_select(THD *thd, st_select_lex *select_lex);
 
 extern std::deque<REJECTED_ITEM> rejected_bypass_queries;
@@ -19,6 +19,7 @@
 
 /* Standard C++ header files */
 #include <algorithm>
+#include <cmath>
 #include <map>
 #include <string>
 #include <vector>
@@ -516,6 +517,154 @@ void Rdb_index_stats::adjust_cardinality(double adjustment_factor) {
   }
 }
 
+Rdb_index_sketch::Rdb_index_sketch(const uint key_parts)
+    : m_key_parts(key_parts),
+      m_registers(new std::atomic<uint8_t>[key_parts * REGISTER_COUNT]),
+      m_rows(0),
+      m_dirty(false) {
+  for (uint i = 0; i < m_key_parts * REGISTER_COUNT; i++) {
+    m_registers[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+/*
+  FNV-1a, so that the hash of a key prefix can be extended with the next key
+  part. add_prefix() mixes the bits before they are used.
+*/
+uint64_t Rdb_index_sketch::hash_bytes(uint64_t hash, const char *const data,
+                                      const size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    hash ^= static_cast<uchar>(data[i]);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+void Rdb_index_sketch::add_prefix(const uint key_part, uint64_t hash) {
+  DBUG_ASSERT(key_part < m_key_parts);
+
+  // MurmurHash3 finalizer
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+
+  // The low bits pick the register, the rest give the rank of the value
+  const uint64_t rest = hash >> REGISTER_BITS;
+  const uint8_t rank =
+      rest == 0 ? 64 - REGISTER_BITS + 1 : __builtin_ctzll(rest) + 1;
+
+  raise_register(key_part * REGISTER_COUNT + (hash & (REGISTER_COUNT - 1)),
+                 rank);
+}
+
+void Rdb_index_sketch::raise_register(const uint i, const uint8_t rank) {
+  std::atomic<uint8_t> &reg = m_registers[i];
+  uint8_t cur = reg.load(std::memory_order_relaxed);
+  while (cur < rank) {
+    if (reg.compare_exchange_weak(cur, rank, std::memory_order_relaxed)) {
+      m_dirty = true;
+      break;
+    }
+  }
+}
+
+void Rdb_index_sketch::add_rows(const int64_t rows) {
+  m_rows.fetch_add(rows, std::memory_order_relaxed);
+  m_dirty = true;
+}
+
+/*
+  Adds the keys and rows counted by another sketch of the same index, e.g.
+  the changes made by a transaction that commits.
+*/
+void Rdb_index_sketch::merge(const Rdb_index_sketch &other) {
+  DBUG_ASSERT(other.m_key_parts == m_key_parts);
+
+  for (uint i = 0; i < m_key_parts * REGISTER_COUNT; i++) {
+    raise_register(i, other.m_registers[i].load(std::memory_order_relaxed));
+  }
+  const int64_t rows = other.get_rows();
+  if (rows != 0) add_rows(rows);
+}
+
+uint64_t Rdb_index_sketch::get_distinct_keys(const uint key_part) const {
+  DBUG_ASSERT(key_part < m_key_parts);
+
+  double sum = 0;
+  uint zeros = 0;
+  for (uint i = 0; i < REGISTER_COUNT; i++) {
+    const uint8_t rank = m_registers[key_part * REGISTER_COUNT + i].load(
+        std::memory_order_relaxed);
+    sum += std::ldexp(1.0, -rank);
+    if (rank == 0) zeros++;
+  }
+
+  const double m = REGISTER_COUNT;
+  double estimate = 0.7213 / (1.0 + 1.079 / m) * m * m / sum;
+  if (estimate <= 2.5 * m && zeros > 0) {
+    // Linear counting is more accurate for small cardinalities
+    estimate = m * std::log(m / zeros);
+  }
+  return static_cast<uint64_t>(estimate + 0.5);
+}
+
+/*
+  Average number of rows per distinct key prefix, or 0 if the sketch has not
+  seen any rows
+*/
+uint64_t Rdb_index_sketch::get_rec_per_key(const uint key_part) const {
+  const int64_t rows = get_rows();
+  const uint64_t distinct_keys = get_distinct_keys(key_part);
+  if (rows <= 0 || distinct_keys == 0) return 0;
+  return std::max<uint64_t>(rows / distinct_keys, 1);
+}
+
+std::string Rdb_index_sketch::materialize() const {
+  String ret;
+  rdb_netstr_append_uint16(&ret, INDEX_SKETCH_VERSION_INITIAL);
+  rdb_netstr_append_uint64(&ret, get_rows());
+  rdb_netstr_append_uint32(&ret, m_key_parts);
+  for (uint i = 0; i < m_key_parts * REGISTER_COUNT; i++) {
+    const char rank =
+        static_cast<char>(m_registers[i].load(std::memory_order_relaxed));
+    ret.append(&rank, 1);
+  }
+  return std::string(ret.ptr(), ret.length());
+}
+
+/**
+  @brief
+  Merges a materialized sketch into this one.
+  @return HA_EXIT_FAILURE if the sketch is for a different number of key
+          parts or if it detects any inconsistency in the input
+  @return HA_EXIT_SUCCESS if completes successfully
+*/
+int Rdb_index_sketch::unmaterialize(const std::string &s) {
+  const uchar *p = rdb_std_str_to_uchar_ptr(s);
+  const uchar *const p2 = p + s.size();
+
+  if (p + sizeof(uint16) + sizeof(uint64) + sizeof(uint32) > p2 ||
+      rdb_netbuf_read_uint16(&p) != INDEX_SKETCH_VERSION_INITIAL) {
+    return HA_EXIT_FAILURE;
+  }
+
+  const int64_t rows = rdb_netbuf_read_uint64(&p);
+  if (rdb_netbuf_read_uint32(&p) != m_key_parts ||
+      p + m_key_parts * REGISTER_COUNT != p2) {
+    return HA_EXIT_FAILURE;
+  }
+
+  for (uint i = 0; i < m_key_parts * REGISTER_COUNT; i++) {
+    if (p[i] > m_registers[i].load(std::memory_order_relaxed)) {
+      m_registers[i].store(p[i], std::memory_order_relaxed);
+    }
+  }
+  m_rows.fetch_add(rows, std::memory_order_relaxed);
+  return HA_EXIT_SUCCESS;
+}
+
 Rdb_tbl_card_coll::Rdb_tbl_card_coll(const uint8_t table_stats_sampling_pct)
     : m_table_stats_sampling_pct(table_stats_sampling_pct),
       m_seed(time(nullptr)) {}
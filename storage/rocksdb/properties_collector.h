@@ -16,6 +16,7 @@
 #pragma once
 
 /* C++ system header files */
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
@@ -103,6 +104,57 @@ struct Rdb_table_stats {
   }
 };
 
+/*
+  HyperLogLog sketches of the number of distinct key prefixes of an index,
+  fed with the keys written through the handler. Unlike Rdb_index_stats,
+  which only covers the keys in SST files, they also cover the keys that are
+  still in the memtable. Writers update the sketches without locking.
+*/
+class Rdb_index_sketch {
+ public:
+  enum {
+    INDEX_SKETCH_VERSION_INITIAL = 1,
+  };
+
+  /* Each key prefix has 2^REGISTER_BITS one byte registers */
+  static const uint REGISTER_BITS = 8;
+  static const uint REGISTER_COUNT = 1 << REGISTER_BITS;
+
+  Rdb_index_sketch(const Rdb_index_sketch &) = delete;
+  Rdb_index_sketch &operator=(const Rdb_index_sketch &) = delete;
+
+  explicit Rdb_index_sketch(const uint key_parts);
+
+  /*
+    Running hash of the key parts of a key. add_prefix() takes the hash of
+    the first key_part + 1 key parts.
+  */
+  static uint64_t hash_bytes(uint64_t hash, const char *const data,
+                             const size_t len);
+  void add_prefix(const uint key_part, uint64_t hash);
+  void add_rows(const int64_t rows);
+  void merge(const Rdb_index_sketch &other);
+
+  uint get_key_parts() const { return m_key_parts; }
+  int64_t get_rows() const { return m_rows.load(std::memory_order_relaxed); }
+  uint64_t get_distinct_keys(const uint key_part) const;
+  uint64_t get_rec_per_key(const uint key_part) const;
+
+  /* Whether the sketch has changed since the last call */
+  bool test_and_clear_dirty() { return m_dirty.exchange(false); }
+
+  std::string materialize() const;
+  int unmaterialize(const std::string &s);
+
+ private:
+  void raise_register(const uint i, const uint8_t rank);
+
+  const uint m_key_parts;
+  std::unique_ptr<std::atomic<uint8_t>[]> m_registers;
+  std::atomic<int64_t> m_rows;
+  std::atomic<bool> m_dirty;
+};
+
 // The helper class to calculate index cardinality
 class Rdb_tbl_card_coll {
  public:
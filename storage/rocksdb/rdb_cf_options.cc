@@ -22,6 +22,8 @@
 #include "./rdb_cf_options.h"
 
 /* C++ system header files */
+#include <cstdlib>
+#include <limits>
 #include <string>
 
 /* MySQL header files */
@@ -301,6 +303,121 @@ bool Rdb_cf_options::parse_cf_options(const std::string &cf_options,
   return true;
 }
 
+// Parse a byte count with an optional K/M/G/T suffix.
+bool Rdb_cf_options::parse_size(const std::string &input,
+                                uint64_t *const size) {
+  DBUG_ASSERT(size != nullptr);
+
+  if (input.empty() || !isdigit(input[0])) return false;
+
+  char *end = nullptr;
+  uint64_t value = strtoull(input.c_str(), &end, 10);
+  int shift = 0;
+
+  if (*end != '\0') {
+    switch (toupper(*end)) {
+      case 'K':
+        shift = 10;
+        break;
+      case 'M':
+        shift = 20;
+        break;
+      case 'G':
+        shift = 30;
+        break;
+      case 'T':
+        shift = 40;
+        break;
+      default:
+        return false;
+    }
+
+    if (*(end + 1) != '\0') return false;
+  }
+
+  if (value > (std::numeric_limits<uint64_t>::max() >> shift)) return false;
+
+  *size = value << shift;
+  return true;
+}
+
+bool Rdb_cf_options::parse_tiered_cf_options(const std::string &tiered_config,
+                                             Name_to_tier_size_t *tier_map) {
+  std::string cf;
+  std::string opt_str;
+
+  DBUG_ASSERT(tier_map != nullptr);
+  DBUG_ASSERT(tier_map->empty());
+
+  size_t pos = 0;
+
+  while (pos < tiered_config.size()) {
+    // Same <cf>={<opt_str>} syntax as the override options.
+    if (!find_cf_options_pair(tiered_config, &pos, &cf, &opt_str)) {
+      return false;
+    }
+
+    if (tier_map->find(cf) != tier_map->end()) {
+      // NO_LINT_DEBUG
+      sql_print_warning(
+          "Duplicate entry for %s in tiered cf options (options: %s)",
+          cf.c_str(), tiered_config.c_str());
+      return false;
+    }
+
+    Name_to_config_t opt_map;
+    rocksdb::Status s = rocksdb::StringToMap(opt_str, &opt_map);
+    uint64_t hot_tier_size = 0;
+
+    if (!s.ok() || opt_map.size() != 1 ||
+        opt_map.find("hot_tier_size") == opt_map.end() ||
+        !parse_size(opt_map["hot_tier_size"], &hot_tier_size)) {
+      // NO_LINT_DEBUG
+      sql_print_warning(
+          "Invalid tiered cf config for %s, hot_tier_size=<bytes> expected "
+          "(options: %s)",
+          cf.c_str(), tiered_config.c_str());
+      return false;
+    }
+
+    (*tier_map)[cf] = hot_tier_size;
+  }
+
+  return true;
+}
+
+bool Rdb_cf_options::set_tiering(const std::string &hot_dir,
+                                 const std::string &cold_dir,
+                                 const std::string &tiered_config) {
+  Name_to_tier_size_t tier_map;
+
+  if (!parse_tiered_cf_options(tiered_config, &tier_map)) {
+    return false;
+  }
+
+  if (!tier_map.empty() && cold_dir.empty()) {
+    // NO_LINT_DEBUG
+    sql_print_warning(
+        "Tiered column families require a cold data directory "
+        "(options: %s)",
+        tiered_config.c_str());
+    return false;
+  }
+
+  if (!cold_dir.empty() && cold_dir == hot_dir) {
+    // NO_LINT_DEBUG
+    sql_print_warning("Cold data directory must differ from %s",
+                      hot_dir.c_str());
+    return false;
+  }
+
+  m_hot_tier_size_map = tier_map;
+  m_hot_data_dir = hot_dir;
+  m_cold_data_dir = cold_dir;
+
+  return true;
+}
+
 bool Rdb_cf_options::set_override(const std::string &override_config) {
   Name_to_config_t configs;
 
@@ -338,6 +455,15 @@ void Rdb_cf_options::get_cf_options(const std::string &cf_name,
   // Set the comparator according to 'rev:'
   opts->comparator = get_cf_comparator(cf_name);
   opts->merge_operator = get_cf_merge_operator(cf_name);
+
+  // RocksDB places each level on the first path whose target size can still
+  // hold it, so only the levels fitting in hot_tier_size stay on the hot path.
+  // Flushes always write to the first path.
+  const auto it = m_hot_tier_size_map.find(cf_name);
+  if (it != m_hot_tier_size_map.end()) {
+    opts->cf_paths = {{m_hot_data_dir, it->second},
+                      {m_cold_data_dir, std::numeric_limits<uint64_t>::max()}};
+  }
 }
 
 }  // namespace myrocks
@@ -19,6 +19,7 @@
 /* C++ system header files */
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 /* RocksDB header files */
 #include "rocksdb/table.h"
@@ -42,6 +43,7 @@ namespace myrocks {
 class Rdb_cf_options {
  public:
   using Name_to_config_t = std::unordered_map<std::string, std::string>;
+  using Name_to_tier_size_t = std::unordered_map<std::string, uint64_t>;
 
   Rdb_cf_options(const Rdb_cf_options &) = delete;
   Rdb_cf_options &operator=(const Rdb_cf_options &) = delete;
@@ -58,6 +60,15 @@ class Rdb_cf_options {
             const char *const default_cf_options,
             const char *const override_cf_options);
 
+  /*
+    Hot/cold tiering. Column families listed in tiered_config keep the upper
+    levels of their LSM tree (and so the most recently written data) under
+    hot_dir, up to the configured number of bytes; compactions into the lower
+    levels write their output to cold_dir.
+  */
+  bool set_tiering(const std::string &hot_dir, const std::string &cold_dir,
+                   const std::string &tiered_config);
+
   const rocksdb::ColumnFamilyOptions &get_defaults() const {
     return m_default_cf_opts;
   }
@@ -75,6 +86,9 @@ class Rdb_cf_options {
   static bool parse_cf_options(const std::string &cf_options,
                                Name_to_config_t *option_map);
 
+  static bool parse_tiered_cf_options(const std::string &tiered_config,
+                                      Name_to_tier_size_t *tier_map);
+
  private:
   bool set_default(const std::string &default_config);
   bool set_override(const std::string &overide_config);
@@ -88,6 +102,7 @@ class Rdb_cf_options {
   static bool find_cf_options_pair(const std::string &input, size_t *const pos,
                                    std::string *const cf,
                                    std::string *const opt_str);
+  static bool parse_size(const std::string &input, uint64_t *const size);
 
  private:
   static Rdb_pk_comparator s_pk_comparator;
@@ -100,6 +115,12 @@ class Rdb_cf_options {
   std::string m_default_config;
 
   rocksdb::ColumnFamilyOptions m_default_cf_opts;
+
+  /* CF name -> bytes kept on the hot path, for tiered column families */
+  Name_to_tier_size_t m_hot_tier_size_map;
+
+  std::string m_hot_data_dir;
+  std::string m_cold_data_dir;
 };
 
 }  // namespace myrocks
@@ -166,6 +166,36 @@ int Rdb_convert_to_record_value_decoder::decode_fixed_length_field(
   return HA_EXIT_SUCCESS;
 }
 
+/*
+  Convert a run of fixed-width NOT NULL fields from rocksdb storage format
+  into Mysql Record format
+  @param    buf         OUT          start memory to fill converted data
+  @param    field_iter  IN           first field of the run
+  @param    reader      IN           rocksdb value slice reader
+  @return
+    0      OK
+    other  HA_ERR error code (can be SE-specific)
+*/
+int Rdb_convert_to_record_value_decoder::decode_fixed_run(
+    uchar *const buf, std::vector<READ_FIELD>::const_iterator field_iter,
+    Rdb_string_reader *const reader) {
+  const char *data_bytes;
+  if ((data_bytes = reader->read(field_iter->m_fixed_run_bytes)) == nullptr) {
+    return HA_ERR_ROCKSDB_CORRUPT_DATA;
+  }
+
+  const auto run_end = field_iter + field_iter->m_fixed_run_fields;
+  for (; field_iter != run_end; field_iter++) {
+    const Rdb_field_encoder *const field_dec = field_iter->m_field_enc;
+    data_bytes += field_iter->m_skip;
+    memcpy(buf + field_dec->m_field_offset, data_bytes,
+           field_dec->m_field_pack_length);
+    data_bytes += field_dec->m_field_pack_length;
+  }
+
+  return HA_EXIT_SUCCESS;
+}
+
 /*
   Convert varchar field from rocksdb storage format into Mysql Record format
   @param    field       IN           current field
@@ -225,6 +255,8 @@ Rdb_value_field_iterator<value_field_decoder, dst_type>::
   m_field_iter = fields->begin();
   m_field_end = fields->end();
   m_null_bytes = rdb_converter->get_null_bytes();
+  m_value_offsets = rdb_converter->get_value_offsets();
+  m_value_data = rdb_converter->get_value_data();
 }
 
 // Iterate each requested field and decode one by one
@@ -232,6 +264,35 @@ template <typename value_field_decoder, typename dst_type>
 int Rdb_value_field_iterator<value_field_decoder, dst_type>::next() {
   int err = HA_EXIT_SUCCESS;
   while (m_field_iter != m_field_end) {
+    // Jump over the fields we don't need using the offset directory
+    const int seek_past = m_field_iter->m_seek_past;
+    if (seek_past >= 0) {
+      DBUG_ASSERT(m_value_offsets != nullptr);
+      const uint32 offset =
+          rdb_netbuf_to_uint32(reinterpret_cast<const uchar *>(
+              m_value_offsets + seek_past * RDB_VALUE_OFFSET_SIZE));
+      const char *const target = m_value_data + offset;
+      const char *const current = m_value_slice_reader->get_current_ptr();
+      if (target < current || !m_value_slice_reader->read(target - current)) {
+        return HA_ERR_ROCKSDB_CORRUPT_DATA;
+      }
+    }
+
+    const uint run_fields = m_field_iter->m_fixed_run_fields;
+    if (run_fields > 1) {
+      err = value_field_decoder::decode_fixed_run(m_buf, m_field_iter,
+                                                  m_value_slice_reader);
+      if (err != HA_EXIT_SUCCESS) {
+        return err;
+      }
+
+      m_field_iter += run_fields - 1;
+      m_field_dec = m_field_iter->m_field_enc;
+      m_is_null = false;
+      m_field_iter++;
+      break;
+    }
+
     m_field_dec = m_field_iter->m_field_enc;
     bool decode = m_field_iter->m_decode;
     bool maybe_null = m_field_dec->maybe_null();
@@ -305,6 +366,9 @@ Rdb_converter::Rdb_converter(const THD *thd, const Rdb_tbl_def *tbl_def,
   m_maybe_unpack_info = false;
   m_row_checksums_checked = 0;
   m_null_bytes = nullptr;
+  m_value_offsets_count = 0;
+  m_value_offsets = nullptr;
+  m_value_data = nullptr;
   setup_field_encoders();
   m_lookup_bitmap = {nullptr, 0, 0, nullptr, nullptr};
 }
@@ -359,6 +423,7 @@ void Rdb_converter::setup_field_decoders(const MY_BITMAP *field_map,
   bitmap_free(&m_lookup_bitmap);
   int last_useful = 0;
   int skip_size = 0;
+  int seek_past = -1;
 
   for (uint i = 0; i < m_table->s->fields; i++) {
     bool field_requested =
@@ -377,15 +442,27 @@ void Rdb_converter::setup_field_decoders(const MY_BITMAP *field_map,
 
     if (field_requested) {
       // We will need to decode this field
-      m_decoders_vect.push_back({&m_encoder_arr[i], true, skip_size});
+      m_decoders_vect.push_back(
+          {&m_encoder_arr[i], true, skip_size, seek_past, 0, 0});
       last_useful = m_decoders_vect.size();
       skip_size = 0;
+      seek_past = -1;
     } else {
-      if (m_encoder_arr[i].uses_variable_len_encoding() ||
-          m_encoder_arr[i].maybe_null()) {
+      if (m_value_offsets_count > 0 &&
+          m_encoder_arr[i].uses_variable_len_encoding()) {
+        // The offset directory tells where this field ends, so nothing
+        // since the last decoded field needs to be looked at.
+        m_decoders_vect.erase(m_decoders_vect.begin() + last_useful,
+                              m_decoders_vect.end());
+        seek_past = m_encoder_arr[i].m_value_offset_index;
+        skip_size = 0;
+      } else if (m_encoder_arr[i].uses_variable_len_encoding() ||
+                 m_encoder_arr[i].maybe_null()) {
         // For variable-length field, we need to read the data and skip it
-        m_decoders_vect.push_back({&m_encoder_arr[i], false, skip_size});
+        m_decoders_vect.push_back(
+            {&m_encoder_arr[i], false, skip_size, seek_past, 0, 0});
         skip_size = 0;
+        seek_past = -1;
       } else {
         // Fixed-width field can be skipped without looking at it.
         // Add appropriate skip_size to the next field.
@@ -399,15 +476,49 @@ void Rdb_converter::setup_field_decoders(const MY_BITMAP *field_map,
   m_decoders_vect.erase(m_decoders_vect.begin() + last_useful,
                         m_decoders_vect.end());
 
+  setup_fixed_runs();
+
   if (!keyread_only && active_index != m_table->s->primary_key) {
     m_tbl_def->m_key_descr_arr[active_index]->get_lookup_bitmap(
         m_table, &m_lookup_bitmap);
   }
 }
 
+/*
+  Find runs of decoded fixed-width NOT NULL fields in m_decoders_vect. Their
+  position relative to each other never changes from row to row, so each
+  run can be decoded with straight copies (typical for integer and temporal
+  columns of wide tables).
+*/
+void Rdb_converter::setup_fixed_runs() {
+  auto field_iter = m_decoders_vect.begin();
+  while (field_iter != m_decoders_vect.end()) {
+    auto run_end = field_iter;
+    uint run_bytes = 0;
+    while (run_end != m_decoders_vect.end() && run_end->m_decode &&
+           (run_end == field_iter || run_end->m_seek_past < 0) &&
+           !run_end->m_field_enc->uses_variable_len_encoding() &&
+           !run_end->m_field_enc->maybe_null()) {
+      run_bytes += run_end->m_skip + run_end->m_field_enc->m_field_pack_length;
+      run_end++;
+    }
+
+    if (run_end - field_iter > 1) {
+      field_iter->m_fixed_run_fields = run_end - field_iter;
+      field_iter->m_fixed_run_bytes = run_bytes;
+      field_iter = run_end;
+    } else {
+      field_iter++;
+    }
+  }
+}
+
 void Rdb_converter::setup_field_encoders() {
   uint null_bytes_length = 0;
   uchar cur_null_mask = 0x1;
+  const bool has_value_offsets =
+      m_tbl_def->m_key_descr_arr[ha_rocksdb::pk_index(m_table, m_tbl_def)]
+          ->has_value_offsets();
 
   m_encoder_arr = static_cast<Rdb_field_encoder *>(
       my_malloc(m_table->s->fields * sizeof(Rdb_field_encoder), MYF(0)));
@@ -454,6 +565,12 @@ void Rdb_converter::setup_field_encoders() {
 
     auto field_type = field->real_type();
     m_encoder_arr[i].m_field_type = field_type;
+    m_encoder_arr[i].m_value_offset_index = UINT_MAX;
+    if (has_value_offsets &&
+        m_encoder_arr[i].m_storage_type == Rdb_field_encoder::STORE_ALL &&
+        m_encoder_arr[i].uses_variable_len_encoding()) {
+      m_encoder_arr[i].m_value_offset_index = m_value_offsets_count++;
+    }
     m_encoder_arr[i].m_field_index = i;
     m_encoder_arr[i].m_field_pack_length = field->pack_length();
     m_encoder_arr[i].m_field_offset = field->ptr - m_table->record[0];
@@ -571,6 +688,15 @@ int Rdb_converter::decode_value_header_for_pk(
                  Rdb_key_def::get_unpack_header_size(unpack_info[0]));
   }
 
+  if (m_value_offsets_count > 0) {
+    DBUG_ASSERT(pk_def->has_value_offsets());
+    if (!(m_value_offsets =
+              reader->read(m_value_offsets_count * RDB_VALUE_OFFSET_SIZE))) {
+      return HA_ERR_ROCKSDB_CORRUPT_DATA;
+    }
+    m_value_data = reader->get_current_ptr();
+  }
+
   return HA_EXIT_SUCCESS;
 }
 
@@ -774,6 +900,17 @@ int Rdb_converter::encode_value_slice(
     m_storage_record.append(reinterpret_cast<char *>(pk_unpack_info->ptr()),
                             pk_unpack_info->get_current_pos());
   }
+
+  // Reserve the value offset directory, its entries are filled in as the
+  // variable length fields are written below
+  size_t offsets_pos = 0;
+  size_t data_pos = 0;
+  if (m_value_offsets_count > 0) {
+    DBUG_ASSERT(pk_def->has_value_offsets());
+    offsets_pos = m_storage_record.length();
+    data_pos = offsets_pos + m_value_offsets_count * RDB_VALUE_OFFSET_SIZE;
+    m_storage_record.fill(data_pos, 0);
+  }
   for (uint i = 0; i < m_table->s->fields; i++) {
     Rdb_field_encoder &encoder = m_encoder_arr[i];
     /* Don't pack decodable PK key parts */
@@ -792,6 +929,10 @@ int Rdb_converter::encode_value_slice(
       if (field->is_null()) {
         data[encoder.m_null_offset] |= encoder.m_null_mask;
         /* Don't write anything for NULL values */
+        if (m_value_offsets_count > 0 &&
+            encoder.uses_variable_len_encoding()) {
+          store_value_offset(encoder, offsets_pos, data_pos);
+        }
         continue;
       }
     }
@@ -810,6 +951,9 @@ int Rdb_converter::encode_value_slice(
       char *data_ptr;
       memcpy(&data_ptr, blob->ptr + length_bytes, sizeof(uchar **));
       m_storage_record.append(data_ptr, blob->get_length());
+      if (m_value_offsets_count > 0) {
+        store_value_offset(encoder, offsets_pos, data_pos);
+      }
     } else if (encoder.m_field_type == MYSQL_TYPE_VARCHAR) {
       Field_varstring *const field_var =
           reinterpret_cast<Field_varstring *>(field);
@@ -823,6 +967,9 @@ int Rdb_converter::encode_value_slice(
       }
       m_storage_record.append(reinterpret_cast<char *>(field_var->ptr),
                               field_var->length_bytes + data_len);
+      if (m_value_offsets_count > 0) {
+        store_value_offset(encoder, offsets_pos, data_pos);
+      }
     } else {
       /* Copy the field data */
       const uint len = field->pack_length();
@@ -851,6 +998,22 @@ int Rdb_converter::encode_value_slice(
   return HA_EXIT_SUCCESS;
 }
 
+/*
+  Record where the variable length field just written ends in the value
+  offset directory
+  @param    encoder       IN      the field just written
+  @param    offsets_pos   IN      position of the directory in the record
+  @param    data_pos      IN      position of the first field in the record
+*/
+void Rdb_converter::store_value_offset(const Rdb_field_encoder &encoder,
+                                       size_t offsets_pos, size_t data_pos) {
+  DBUG_ASSERT(encoder.m_value_offset_index < m_value_offsets_count);
+  uchar *const entry = reinterpret_cast<uchar *>(
+      const_cast<char *>(m_storage_record.ptr()) + offsets_pos +
+      encoder.m_value_offset_index * RDB_VALUE_OFFSET_SIZE);
+  rdb_netbuf_store_uint32(entry, m_storage_record.length() - data_pos);
+}
+
 template class Rdb_value_field_iterator<Rdb_convert_to_record_value_decoder,
                                         uchar *>;
 }  // namespace myrocks
@@ -45,6 +45,21 @@ struct READ_FIELD {
   bool m_decode;
   // Skip this many bytes before reading (or skipping) this field
   int m_skip;
+  /*
+    If not negative, first jump past the end of the variable length field
+    with this index in the value offset directory. The fields in between
+    are not looked at.
+  */
+  int m_seek_past;
+  /*
+    Set on the first field of a run of decoded, fixed-width NOT NULL fields.
+    Such fields are always stored back to back in the value, so the whole
+    run is read with a single bounds check and copied without looking at
+    the field types. Zero for fields that are not the head of a run.
+  */
+  uint m_fixed_run_fields;
+  // Number of value bytes covered by the run, including skipped bytes
+  uint m_fixed_run_bytes;
 };
 
 /**
@@ -63,6 +78,10 @@ class Rdb_convert_to_record_value_decoder {
                     Rdb_field_encoder *field_dec, Rdb_string_reader *reader,
                     bool decode, bool is_null);
 
+  static int decode_fixed_run(uchar *const buf,
+                              std::vector<READ_FIELD>::const_iterator field_iter,
+                              Rdb_string_reader *const reader);
+
  private:
   static int decode_blob(TABLE *table, uchar *const buf,
                          Rdb_field_encoder *field_dec,
@@ -91,6 +110,9 @@ class Rdb_value_field_iterator {
   Rdb_string_reader *m_value_slice_reader;
   // null value map
   const char *m_null_bytes;
+  // value offset directory and the start of the fields it is relative to
+  const char *m_value_offsets;
+  const char *m_value_data;
   // The current open table
   TABLE *m_table;
   // The current field
@@ -109,7 +131,8 @@ class Rdb_value_field_iterator {
 
   /*
     Move and decode next field
-    Run next() before accessing data
+    Run next() before accessing data. A run of fixed-width fields is decoded
+    in one step, in which case the last field of the run becomes current.
   */
   int next();
   // Whether current field is the end of fields
@@ -163,6 +186,8 @@ class Rdb_converter {
   const Rdb_field_encoder *get_encoder_arr() const { return m_encoder_arr; }
   int get_null_bytes_in_record() { return m_null_bytes_length_in_record; }
   const char *get_null_bytes() const { return m_null_bytes; }
+  const char *get_value_offsets() const { return m_value_offsets; }
+  const char *get_value_data() const { return m_value_data; }
   void set_is_key_requested(bool key_requested) {
     m_key_requested = key_requested;
   }
@@ -183,6 +208,11 @@ class Rdb_converter {
  private:
   void setup_field_encoders();
 
+  void setup_fixed_runs();
+
+  void store_value_offset(const Rdb_field_encoder &encoder,
+                          size_t offsets_pos, size_t data_pos);
+
   void get_storage_type(Rdb_field_encoder *const encoder, const uint kp);
 
   int convert_record_from_storage_format(
@@ -221,6 +251,17 @@ class Rdb_converter {
     Pointer to null bytes value
   */
   const char *m_null_bytes;
+  /*
+    Number of entries in the value offset directory, zero if the primary key
+    format has none or there are no variable length fields in the value.
+  */
+  uint m_value_offsets_count;
+  /*
+    Pointers to the value offset directory and to the first field following
+    it in the value being decoded
+  */
+  const char *m_value_offsets;
+  const char *m_value_data;
   /*
    TRUE <=> Some fields in the PK may require unpack_info.
   */
@@ -39,6 +39,9 @@
 #include "./my_bitmap.h"
 #include "./sql_table.h"
 
+/* RocksDB header files */
+#include "rocksdb/table.h"
+
 /* MyRocks header files */
 #include "./ha_rocksdb.h"
 #include "./ha_rocksdb_proto.h"
@@ -276,6 +279,7 @@ Rdb_key_def::Rdb_key_def(
       m_ttl_pk_key_part_offset(UINT_MAX),
       m_ttl_field_index(UINT_MAX),
       m_prefix_extractor(nullptr),
+      m_has_bloom_filter(false),
       m_maxlength(0)  // means 'not intialized'
 {
   mysql_mutex_init(0, &m_mutex, MY_MUTEX_INIT_FAST);
@@ -298,6 +302,7 @@ Rdb_key_def::Rdb_key_def(const Rdb_key_def &k)
       m_is_per_partition_cf(k.m_is_per_partition_cf),
       m_name(k.m_name),
       m_stats(k.m_stats),
+      m_sketch(k.m_sketch),
       m_index_flags_bitmap(k.m_index_flags_bitmap),
       m_ttl_rec_offset(k.m_ttl_rec_offset),
       m_ttl_duration(k.m_ttl_duration),
@@ -309,6 +314,7 @@ Rdb_key_def::Rdb_key_def(const Rdb_key_def &k)
       m_ttl_pk_key_part_offset(k.m_ttl_pk_key_part_offset),
       m_ttl_field_index(UINT_MAX),
       m_prefix_extractor(k.m_prefix_extractor),
+      m_has_bloom_filter(k.m_has_bloom_filter),
       m_maxlength(k.m_maxlength) {
   mysql_mutex_init(0, &m_mutex, MY_MUTEX_INIT_FAST);
   rdb_netbuf_store_index(m_index_number_storage_form, m_index_number);
@@ -528,10 +534,29 @@ void Rdb_key_def::setup(const TABLE *const tbl,
     /* Initialize the memory needed by the stats structure */
     m_stats.m_distinct_keys_per_prefix.resize(get_key_parts());
 
+    /*
+      Continue the cardinality sketch from where it was last persisted. A
+      sketch that can't be read is started over.
+    */
+    if (rocksdb_table_stats_use_sketches && !m_sketch) {
+      m_sketch = std::make_shared<Rdb_index_sketch>(get_key_parts());
+      std::string sketch;
+      if (rdb_get_dict_manager()->get_sketch(get_gl_index_id(), &sketch)) {
+        m_sketch->unmaterialize(sketch);
+      }
+    }
+
     /* Cache prefix extractor for bloom filter usage later */
     rocksdb::Options opt = rdb_get_rocksdb_db()->GetOptions(get_cf());
     m_prefix_extractor = opt.prefix_extractor;
 
+    /* Cache bloom filter presence for the optimizer's cost estimates */
+    const auto bbt_opt =
+        opt.table_factory
+            ? opt.table_factory->GetOptions<rocksdb::BlockBasedTableOptions>()
+            : nullptr;
+    m_has_bloom_filter = bbt_opt != nullptr && bbt_opt->filter_policy;
+
     /*
       This should be the last member variable set before releasing the mutex
       so that other threads can't see the object partially set up.
@@ -1517,6 +1542,46 @@ int Rdb_key_def::compare_keys(const rocksdb::Slice *key1,
   return HA_EXIT_SUCCESS;
 }
 
+/*
+  @brief
+    Add the prefixes of a key to a cardinality sketch of the index.
+
+  @detail
+    Each prefix is hashed in its mem-comparable form, so that keys which
+    compare equal are counted once.
+
+  @param key     The key, with the index number
+  @param sketch  m_sketch, or the changes a transaction made to it
+*/
+void Rdb_key_def::sketch_key(const rocksdb::Slice &key,
+                             Rdb_index_sketch *const sketch) const {
+  DBUG_ASSERT(sketch != nullptr);
+
+  Rdb_string_reader reader(&key);
+
+  // Skip the index number
+  if (!reader.read(INDEX_NUMBER_SIZE)) return;
+
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (uint i = 0; i < m_key_parts && i < sketch->get_key_parts(); i++) {
+    const Rdb_field_packing *const fpi = &m_pack_info[i];
+    const char *const before_skip = reader.get_current_ptr();
+    bool is_null = false;
+    if (fpi->m_field_maybe_null) {
+      const char *const nullp = reader.read(1);
+      if (nullp == nullptr) return;
+      is_null = (*nullp == 0);
+    }
+
+    DBUG_ASSERT(fpi->m_skip_func);
+    if (!is_null && (fpi->m_skip_func)(fpi, &reader)) return;
+
+    hash = Rdb_index_sketch::hash_bytes(
+        hash, before_skip, reader.get_current_ptr() - before_skip);
+    sketch->add_prefix(i, hash);
+  }
+}
+
 /*
   @brief
     Given a zero-padded key, determine its real key length
@@ -4374,6 +4439,36 @@ void Rdb_ddl_manager::persist_stats(const bool sync) {
   m_dict->commit(wb.get(), sync);
 }
 
+/*
+  Write the cardinality sketches that changed since they were last persisted
+  into the data dictionary.
+
+  The sketches are written under m_rwlock. An index that is dropped is
+  removed from m_ddl_map before its dictionary entries are deleted, so this
+  can't write the sketch of an index after they are gone.
+*/
+void Rdb_ddl_manager::persist_sketches() {
+  const std::unique_ptr<rocksdb::WriteBatch> wb = m_dict->begin();
+  bool changed = false;
+
+  mysql_rwlock_rdlock(&m_rwlock);
+  for (const auto &it : m_ddl_map) {
+    const Rdb_tbl_def *const tbl_def = it.second;
+    for (uint i = 0; i < tbl_def->m_key_count; i++) {
+      const auto &kd = tbl_def->m_key_descr_arr[i];
+      if (kd->m_sketch && kd->m_sketch->test_and_clear_dirty()) {
+        m_dict->add_sketch(wb.get(), kd->get_gl_index_id(),
+                           kd->m_sketch->materialize());
+        changed = true;
+      }
+    }
+  }
+  if (changed) {
+    m_dict->commit(wb.get(), false);
+  }
+  mysql_rwlock_unlock(&m_rwlock);
+}
+
 void Rdb_ddl_manager::set_table_stats(const std::string &tbl_name) {
   timespec ts;
   clock_gettime(CLOCK_REALTIME, &ts);
@@ -4916,6 +5011,8 @@ void Rdb_dict_manager::delete_index_info(rocksdb::WriteBatch *batch,
   delete_with_prefix(batch, Rdb_key_def::INDEX_INFO, gl_index_id);
   delete_with_prefix(batch, Rdb_key_def::INDEX_STATISTICS, gl_index_id);
   delete_with_prefix(batch, Rdb_key_def::AUTO_INC, gl_index_id);
+  delete_with_prefix(batch, Rdb_key_def::INDEX_CARDINALITY_SKETCH,
+                     gl_index_id);
 }
 
 bool Rdb_dict_manager::get_index_info(
@@ -4975,7 +5072,7 @@ bool Rdb_dict_manager::get_index_info(
         index_info->m_kv_version = rdb_netbuf_to_uint16(ptr);
         ptr += RDB_SIZEOF_KV_VERSION;
         index_info->m_ttl_duration = rdb_netbuf_to_uint64(ptr);
-        if ((index_info->m_kv_version ==
+        if ((index_info->m_kv_version >=
              Rdb_key_def::PRIMARY_FORMAT_VERSION_TTL) &&
             index_info->m_ttl_duration > 0) {
           index_info->m_index_flags = Rdb_key_def::TTL_FLAG;
@@ -5543,6 +5640,29 @@ Rdb_index_stats Rdb_dict_manager::get_stats(GL_INDEX_ID gl_index_id) const {
   return Rdb_index_stats();
 }
 
+void Rdb_dict_manager::add_sketch(rocksdb::WriteBatch *const batch,
+                                  const GL_INDEX_ID &gl_index_id,
+                                  const std::string &sketch) const {
+  DBUG_ASSERT(batch != nullptr);
+
+  Rdb_buf_writer<Rdb_key_def::INDEX_NUMBER_SIZE * 3> key_writer;
+  dump_index_id(&key_writer, Rdb_key_def::INDEX_CARDINALITY_SKETCH,
+                gl_index_id);
+
+  // Rdb_index_sketch::materialize stores the version
+  batch->Put(m_system_cfh, key_writer.to_slice(), sketch);
+}
+
+bool Rdb_dict_manager::get_sketch(const GL_INDEX_ID &gl_index_id,
+                                  std::string *const sketch) const {
+  Rdb_buf_writer<Rdb_key_def::INDEX_NUMBER_SIZE * 3> key_writer;
+  dump_index_id(&key_writer, Rdb_key_def::INDEX_CARDINALITY_SKETCH,
+                gl_index_id);
+
+  const rocksdb::Status status = get_value(key_writer.to_slice(), sketch);
+  return status.ok();
+}
+
 rocksdb::Status Rdb_dict_manager::put_auto_incr_val(
     rocksdb::WriteBatchBase *batch, const GL_INDEX_ID &gl_index_id,
     ulonglong val, bool overwrite) const {
@@ -151,6 +151,9 @@ const size_t RDB_CHECKSUM_SIZE = sizeof(uint32_t);
 */
 const size_t RDB_CHECKSUM_CHUNK_SIZE = 2 * RDB_CHECKSUM_SIZE + 1;
 
+/* How much one entry of the value offset directory occupies in the record */
+const size_t RDB_VALUE_OFFSET_SIZE = sizeof(uint32_t);
+
 /*
   Checksum data starts from CHECKSUM_DATA_TAG which is followed by two CRC32
   checksums.
@@ -266,6 +269,8 @@ class Rdb_key_def {
   static bool unpack_info_has_checksum(const rocksdb::Slice &unpack_info);
   int compare_keys(const rocksdb::Slice *key1, const rocksdb::Slice *key2,
                    std::size_t *const column_index) const;
+  void sketch_key(const rocksdb::Slice &key,
+                  Rdb_index_sketch *const sketch) const;
 
   size_t key_length(const TABLE *const table, const rocksdb::Slice &key) const;
 
@@ -383,6 +388,11 @@ class Rdb_key_def {
            m_index_type == INDEX_TYPE_HIDDEN_PRIMARY;
   }
 
+  inline bool has_value_offsets() const {
+    return is_primary_key() &&
+           m_kv_format_version >= PRIMARY_FORMAT_VERSION_VALUE_OFFSETS;
+  }
+
   /* Indicates that all key parts can be unpacked to cover a secondary lookup */
   bool can_cover_lookup() const;
 
@@ -443,6 +453,9 @@ class Rdb_key_def {
     return m_prefix_extractor.get();
   }
 
+  /* Whether the column family of the index has a bloom filter configured */
+  bool has_bloom_filter() const { return m_has_bloom_filter; }
+
   static size_t get_unpack_header_size(char tag);
 
   Rdb_key_def &operator=(const Rdb_key_def &) = delete;
@@ -497,6 +510,7 @@ class Rdb_key_def {
     DDL_CREATE_INDEX_ONGOING = 8,
     AUTO_INC = 9,
     DROPPED_CF = 10,
+    INDEX_CARDINALITY_SKETCH = 11,
     END_DICT_INDEX_ID = 255
   };
 
@@ -512,6 +526,7 @@ class Rdb_key_def {
     AUTO_INCREMENT_VERSION = 1,
     DROPPED_CF_VERSION = 1,
     // Version for index stats is stored in IndexStats struct
+    // Version for index sketches is stored in Rdb_index_sketch
   };
 
   // Index info version.  Introduce newer versions when changing the
@@ -562,7 +577,13 @@ class Rdb_key_def {
     //  - This means that when TTL is specified for the table an 8-byte TTL
     //    field is prepended in front of each value.
     PRIMARY_FORMAT_VERSION_TTL = 13,
-    PRIMARY_FORMAT_VERSION_LATEST = PRIMARY_FORMAT_VERSION_TTL,
+    // This change includes an offset directory in the value
+    //  - A 4-byte offset is stored after unpack_info for each variable length
+    //    column kept in the value, pointing past the end of that column, so
+    //    unread columns can be skipped without walking them.
+    //  - Only used for new tables when rocksdb_enable_pk_value_offsets is on.
+    PRIMARY_FORMAT_VERSION_VALUE_OFFSETS = 14,
+    PRIMARY_FORMAT_VERSION_LATEST = PRIMARY_FORMAT_VERSION_VALUE_OFFSETS,
 
     SECONDARY_FORMAT_VERSION_INITIAL = 10,
     // This change the SK format to include unpack_info.
@@ -791,6 +812,21 @@ class Rdb_key_def {
   std::string m_name;
   mutable Rdb_index_stats m_stats;
 
+  /*
+    Cardinality of the keys written since the index was opened, including
+    the ones still in the memtable. Only set with
+    rocksdb_table_stats_use_sketches.
+  */
+  std::shared_ptr<Rdb_index_sketch> m_sketch;
+
+  /*
+    Point lookups of the index that could use its bloom filter, and how many
+    of them found a key. The lookups that found nothing are the ones the
+    filter can rule out. In-memory only.
+  */
+  mutable std::atomic<uint64_t> m_bloom_lookups{0};
+  mutable std::atomic<uint64_t> m_bloom_lookups_found{0};
+
   /*
     Bitmap containing information about whether TTL or other special fields
     are enabled for the given index.
@@ -849,6 +885,9 @@ class Rdb_key_def {
   /* Prefix extractor for the column family of the key definiton */
   std::shared_ptr<const rocksdb::SliceTransform> m_prefix_extractor;
 
+  /* True if the column family of the key definition has a filter policy */
+  bool m_has_bloom_filter;
+
   /* Maximum length of the mem-comparable form. */
   uint m_maxlength;
 
@@ -1041,6 +1080,8 @@ class Rdb_field_encoder {
   uint m_field_length;
   my_ptrdiff_t m_field_null_offset;
   my_ptrdiff_t m_field_offset;
+  // Entry in the value offset directory, for variable length fields
+  uint m_value_offset_index;
 
   bool maybe_null() const { return m_null_mask != 0; }
 
@@ -1264,6 +1305,7 @@ class Rdb_ddl_manager {
                     const std::vector<Rdb_index_stats> &deleted_data =
                         std::vector<Rdb_index_stats>());
   void persist_stats(const bool sync = false);
+  void persist_sketches();
 
   void set_table_stats(const std::string &tbl_name);
 
@@ -1404,6 +1446,10 @@ class Rdb_binlog_manager {
   key: Rdb_key_def::DROPPED_CF(0xa) + cf_id
   value: version
 
+  11. index cardinality sketches
+  key: Rdb_key_def::INDEX_CARDINALITY_SKETCH(0xb) + cf_id + index_id
+  value: version, {materialized Rdb_index_sketch}
+
   Data dictionary operations are atomic inside RocksDB. For example,
   when creating a table with two indexes, it is necessary to call Put
   three times. They have to be atomic. Rdb_dict_manager has a wrapper function
@@ -1576,6 +1622,11 @@ class Rdb_dict_manager {
   void add_stats(rocksdb::WriteBatch *const batch,
                  const std::vector<Rdb_index_stats> &stats) const;
   Rdb_index_stats get_stats(GL_INDEX_ID gl_index_id) const;
+  void add_sketch(rocksdb::WriteBatch *const batch,
+                  const GL_INDEX_ID &gl_index_id,
+                  const std::string &sketch) const;
+  bool get_sketch(const GL_INDEX_ID &gl_index_id,
+                  std::string *const sketch) const;
 
   rocksdb::Status put_auto_incr_val(rocksdb::WriteBatchBase *batch,
                                     const GL_INDEX_ID &gl_index_id,
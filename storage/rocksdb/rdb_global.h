@@ -126,6 +126,11 @@ const char *const INDEX_STATS_THREAD_NAME = "myrocks-is";
 */
 const char *const MANUAL_COMPACTION_THREAD_NAME = "myrocks-mc";
 
+/*
+  Name for the bulk load SST writer threads.
+*/
+const char *const SST_WRITER_THREAD_NAME = "myrocks-sst";
+
 /*
   Separator between partition name and the qualifier. Sample usage:
 
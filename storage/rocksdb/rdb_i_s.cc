@@ -119,7 +119,11 @@ static int rdb_i_s_cfstats_fill_table(
     DBUG_RETURN(ret);
   }
 
-  const Rdb_cf_manager &cf_manager = rdb_get_cf_manager();
+  Rdb_cf_manager &cf_manager = rdb_get_cf_manager();
+
+  // Per-path SST bytes and sampled reads, for tiered column families.
+  std::vector<rocksdb::LiveFileMetaData> live_files;
+  rdb->GetLiveFilesMetaData(&live_files);
 
   for (const auto &cf_name : cf_manager.get_cf_names()) {
     DBUG_ASSERT(!cf_name.empty());
@@ -129,18 +133,43 @@ static int rdb_i_s_cfstats_fill_table(
       continue;
     }
 
+    std::vector<std::pair<std::string, uint64_t>> cf_stats;
+
     // It is safe if the CF is removed from cf_manager at
     // this point. The CF handle object is valid and sufficient here.
     for (const auto &property : cf_properties) {
-      if (!rdb->GetIntProperty(cfh.get(), property.first, &val)) {
-        continue;
+      if (rdb->GetIntProperty(cfh.get(), property.first, &val)) {
+        cf_stats.push_back({property.second, val});
       }
+    }
+
+    rocksdb::ColumnFamilyOptions opts;
+    cf_manager.get_cf_options(cf_name, &opts);
+
+    if (opts.cf_paths.size() == 2) {
+      uint64_t tier_bytes[2] = {0, 0};
+      uint64_t tier_reads[2] = {0, 0};
+
+      for (const auto &file : live_files) {
+        if (file.column_family_name != cf_name) continue;
+
+        const size_t tier = (file.db_path == opts.cf_paths[0].path) ? 0 : 1;
+        tier_bytes[tier] += file.size;
+        tier_reads[tier] += file.num_reads_sampled;
+      }
+
+      cf_stats.push_back({"HOT_TIER_BYTES", tier_bytes[0]});
+      cf_stats.push_back({"HOT_TIER_NUM_READS_SAMPLED", tier_reads[0]});
+      cf_stats.push_back({"COLD_TIER_BYTES", tier_bytes[1]});
+      cf_stats.push_back({"COLD_TIER_NUM_READS_SAMPLED", tier_reads[1]});
+    }
 
+    for (const auto &stat : cf_stats) {
       tables->table->field[RDB_CFSTATS_FIELD::CF_NAME]->store(
           cf_name.c_str(), cf_name.size(), system_charset_info);
       tables->table->field[RDB_CFSTATS_FIELD::STAT_TYPE]->store(
-          property.second.c_str(), property.second.size(), system_charset_info);
-      tables->table->field[RDB_CFSTATS_FIELD::VALUE]->store(val, true);
+          stat.first.c_str(), stat.first.size(), system_charset_info);
+      tables->table->field[RDB_CFSTATS_FIELD::VALUE]->store(stat.second, true);
 
       ret = static_cast<int>(
           my_core::schema_table_store_record(thd, tables->table));
@@ -36,6 +36,7 @@
 #include "./ha_rocksdb_proto.h"
 #include "./rdb_cf_options.h"
 #include "./rdb_psi.h"
+#include "./rdb_threads.h"
 
 namespace myrocks {
 
@@ -298,11 +299,31 @@ rocksdb::Status Rdb_sst_file_ordered::commit() {
   return m_file.commit();
 }
 
+rocksdb::Status Rdb_sst_batch::write_to(
+    Rdb_sst_file_ordered *const sst_file) const {
+  rocksdb::Status s;
+  size_t offset = 0;
+
+  for (const auto &entry : m_entries) {
+    const rocksdb::Slice key(m_data.data() + offset, entry.first);
+    offset += entry.first;
+    const rocksdb::Slice value(m_data.data() + offset, entry.second);
+    offset += entry.second;
+
+    s = sst_file->put(key, value);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  return s;
+}
+
 Rdb_sst_info::Rdb_sst_info(rocksdb::DB *const db, const std::string &tablename,
                            const std::string &indexname,
                            rocksdb::ColumnFamilyHandle *const cf,
                            const rocksdb::DBOptions &db_options,
-                           const bool tracing)
+                           const bool tracing, const uint num_writers)
     : m_db(db),
       m_cf(cf),
       m_db_options(db_options),
@@ -312,7 +333,10 @@ Rdb_sst_info::Rdb_sst_info(rocksdb::DB *const db, const std::string &tablename,
       m_done(false),
       m_sst_file(nullptr),
       m_tracing(tracing),
-      m_print_client_error(true) {
+      m_print_client_error(true),
+      m_num_writers(num_writers),
+      m_batches_in_flight(0),
+      m_stop_writers(false) {
   m_prefix = db->GetName() + "/";
 
   std::string normalized_table;
@@ -346,6 +370,9 @@ Rdb_sst_info::Rdb_sst_info(rocksdb::DB *const db, const std::string &tablename,
 Rdb_sst_info::~Rdb_sst_info() {
   DBUG_ASSERT(m_sst_file == nullptr);
 
+  // In case finish was never called
+  stop_writers();
+
   for (const auto &sst_file : m_committed_files) {
     // In case something went wrong attempt to delete the temporary file.
     // If everything went fine that file will have been renamed and this
@@ -388,11 +415,16 @@ void Rdb_sst_info::commit_sst_file(Rdb_sst_file_ordered *sst_file) {
     set_background_error(HA_ERR_ROCKSDB_BULK_LOAD);
   }
 
-  m_committed_files.push_back(sst_file->get_name());
+  add_committed_file(sst_file->get_name());
 
   delete sst_file;
 }
 
+void Rdb_sst_info::add_committed_file(const std::string &name) {
+  std::lock_guard<std::mutex> lock(m_committed_files_mutex);
+  m_committed_files.push_back(name);
+}
+
 void Rdb_sst_info::close_curr_sst_file() {
   DBUG_ASSERT(m_sst_file != nullptr);
   DBUG_ASSERT(m_curr_size > 0);
@@ -404,11 +436,200 @@ void Rdb_sst_info::close_curr_sst_file() {
   m_curr_size = 0;
 }
 
+/*
+  Background thread building the SST files of one Rdb_sst_info
+*/
+class Rdb_sst_writer_thread : public Rdb_thread {
+ private:
+  Rdb_sst_info *const m_sst_info;
+
+ public:
+  explicit Rdb_sst_writer_thread(Rdb_sst_info *const sst_info)
+      : m_sst_info(sst_info) {}
+
+  virtual void run() override { m_sst_info->run_writer(); }
+};
+
+rocksdb::Status Rdb_sst_info::write_batch(const Rdb_sst_batch &batch) {
+  Rdb_sst_file_ordered sst_file(m_db, m_cf, m_db_options, batch.get_name(),
+                                m_tracing, m_max_size);
+  rocksdb::Status s = sst_file.open();
+  if (s.ok()) {
+    s = batch.write_to(&sst_file);
+  }
+  if (s.ok()) {
+    s = sst_file.commit();
+  }
+  return s;
+}
+
+// This function is run by the background writer threads
+void Rdb_sst_info::run_writer() {
+  std::unique_lock<std::mutex> lock(m_batch_mutex);
+
+  while (true) {
+    m_batch_cond.wait(lock,
+                      [this] { return m_stop_writers || !m_batch_queue.empty(); });
+    if (m_batch_queue.empty()) {
+      // m_stop_writers is set and there is no more work
+      break;
+    }
+
+    std::unique_ptr<Rdb_sst_batch> batch = std::move(m_batch_queue.front());
+    m_batch_queue.pop();
+    // Keep the name of this batch's file for the error message, the batch
+    // is released before the error is recorded
+    const std::string name = batch->get_name();
+    const bool skip = have_background_error();
+    lock.unlock();
+
+    add_committed_file(name);
+
+    rocksdb::Status s;
+    if (!skip) {
+      s = write_batch(*batch);
+    }
+
+    // Release the memory before letting the session thread queue more
+    batch.reset();
+
+    lock.lock();
+    if (!s.ok() && m_writer_status.ok()) {
+      m_writer_status = s;
+      m_writer_status_file = name;
+      set_background_error(HA_ERR_ROCKSDB_BULK_LOAD);
+    }
+    m_batches_in_flight--;
+    m_batch_done_cond.notify_one();
+  }
+}
+
+void Rdb_sst_info::start_writers() {
+  for (uint i = 0; i < m_num_writers; i++) {
+    std::unique_ptr<Rdb_sst_writer_thread> thread(
+        new Rdb_sst_writer_thread(this));
+#ifdef HAVE_PSI_INTERFACE
+    thread->init(rdb_signal_sst_writer_psi_mutex_key,
+                 rdb_signal_sst_writer_psi_cond_key);
+    const int err = thread->create_thread(SST_WRITER_THREAD_NAME,
+                                          rdb_sst_writer_psi_thread_key);
+#else
+    thread->init();
+    const int err = thread->create_thread(SST_WRITER_THREAD_NAME);
+#endif
+    if (err != 0) {
+      // NO_LINT_DEBUG
+      sql_print_warning(
+          "RocksDB: Couldn't start a bulk load SST writer thread: "
+          "(errno=%d)",
+          err);
+      thread->uninit();
+      break;
+    }
+    m_writer_threads.push_back(std::move(thread));
+  }
+}
+
+/*
+  Hand the current batch over to the writer threads, waiting for one of them
+  to free up if too many batches are already in flight. If no writer thread
+  could be started, the batch is written by the session thread.
+ */
+int Rdb_sst_info::submit_batch() {
+  DBUG_ASSERT(m_batch != nullptr && !m_batch->empty());
+
+  {
+    std::unique_lock<std::mutex> lock(m_batch_mutex);
+    if (m_writer_threads.empty()) {
+      start_writers();
+    }
+
+    if (!m_writer_threads.empty()) {
+      m_batch_done_cond.wait(lock, [this] {
+        return m_batches_in_flight < m_writer_threads.size();
+      });
+      m_batches_in_flight++;
+      m_batch_queue.push(std::move(m_batch));
+      m_batch_cond.notify_one();
+      lock.unlock();
+      return get_writer_error();
+    }
+  }
+
+  add_committed_file(m_batch->get_name());
+  const rocksdb::Status s = write_batch(*m_batch);
+  if (!s.ok()) {
+    set_error_msg(m_batch->get_name(), s);
+    m_batch.reset();
+    return HA_ERR_ROCKSDB_BULK_LOAD;
+  }
+  m_batch.reset();
+
+  return get_writer_error();
+}
+
+void Rdb_sst_info::stop_writers() {
+  {
+    std::lock_guard<std::mutex> lock(m_batch_mutex);
+    m_stop_writers = true;
+    m_batch_cond.notify_all();
+  }
+
+  for (const auto &thread : m_writer_threads) {
+    thread->join();
+  }
+  m_writer_threads.clear();
+}
+
+/*
+  Report the first failure seen by the writer threads, if any, from the
+  session thread
+ */
+int Rdb_sst_info::get_writer_error() {
+  if (!have_background_error()) {
+    return HA_EXIT_SUCCESS;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_batch_mutex);
+    if (!m_writer_status.ok()) {
+      set_error_msg(m_writer_status_file, m_writer_status);
+      m_writer_status = rocksdb::Status::OK();
+    }
+  }
+
+  return get_and_reset_background_error();
+}
+
+int Rdb_sst_info::put_batched(const rocksdb::Slice &key,
+                              const rocksdb::Slice &value) {
+  if (m_batch != nullptr &&
+      m_batch->size() + key.size() + value.size() >= m_max_size) {
+    const int rc = submit_batch();
+    if (rc != HA_EXIT_SUCCESS) {
+      return rc;
+    }
+  }
+
+  if (m_batch == nullptr) {
+    m_batch.reset(
+        new Rdb_sst_batch(m_prefix + std::to_string(m_sst_count++) + m_suffix));
+  }
+
+  m_batch->add(key, value);
+
+  return HA_EXIT_SUCCESS;
+}
+
 int Rdb_sst_info::put(const rocksdb::Slice &key, const rocksdb::Slice &value) {
   int rc;
 
   DBUG_ASSERT(!m_done);
 
+  if (m_num_writers > 0) {
+    return put_batched(key, value);
+  }
+
   if (m_curr_size + key.size() + value.size() >= m_max_size) {
     // The current sst file has reached its maximum, close it out
     close_curr_sst_file();
@@ -469,17 +690,32 @@ int Rdb_sst_info::finish(Rdb_sst_commit_info *commit_info,
     close_curr_sst_file();
   }
 
+  if (m_num_writers > 0) {
+    // Write out the last batch and wait for all the writers to finish
+    if (m_batch != nullptr && !m_batch->empty()) {
+      ret = submit_batch();
+    }
+    m_batch.reset();
+    stop_writers();
+    if (ret == HA_EXIT_SUCCESS) {
+      ret = get_writer_error();
+    }
+  }
+
   // This checks out the list of files so that the caller can collect/group
   // them and ingest them all in one go, and any racing calls to commit
   // won't see them at all
-  commit_info->init(m_cf, std::move(m_committed_files));
-  DBUG_ASSERT(m_committed_files.size() == 0);
+  {
+    std::lock_guard<std::mutex> lock(m_committed_files_mutex);
+    commit_info->init(m_cf, std::move(m_committed_files));
+    DBUG_ASSERT(m_committed_files.size() == 0);
+  }
 
   m_done = true;
   RDB_MUTEX_UNLOCK_CHECK(m_commit_mutex);
 
   // Did we get any errors?
-  if (have_background_error()) {
+  if (ret == HA_EXIT_SUCCESS && have_background_error()) {
     ret = get_and_reset_background_error();
   }
 
@@ -19,6 +19,7 @@
 /* C++ standard header files */
 #include <atomic>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <stack>
@@ -111,6 +112,42 @@ class Rdb_sst_file_ordered {
   inline const std::string get_name() const { return m_file.get_name(); }
 };
 
+/*
+  Key/value pairs for one SST file, buffered in memory so that the file can
+  be built by a background writer thread. Input is sorted, so each batch
+  covers a key range disjoint from all the others
+*/
+class Rdb_sst_batch {
+ private:
+  Rdb_sst_batch(const Rdb_sst_batch &p) = delete;
+  Rdb_sst_batch &operator=(const Rdb_sst_batch &p) = delete;
+
+  const std::string m_name;
+
+  // Keys and values packed back to back
+  std::string m_data;
+
+  // (key length, value length) of each entry in m_data
+  std::vector<std::pair<size_t, size_t>> m_entries;
+
+ public:
+  explicit Rdb_sst_batch(const std::string &name) : m_name(name) {}
+
+  void add(const rocksdb::Slice &key, const rocksdb::Slice &value) {
+    m_data.append(key.data(), key.size());
+    m_data.append(value.data(), value.size());
+    m_entries.emplace_back(key.size(), value.size());
+  }
+
+  rocksdb::Status write_to(Rdb_sst_file_ordered *const sst_file) const;
+
+  size_t size() const { return m_data.size(); }
+  bool empty() const { return m_entries.empty(); }
+  const std::string &get_name() const { return m_name; }
+};
+
+class Rdb_sst_writer_thread;
+
 class Rdb_sst_info {
  private:
   Rdb_sst_info(const Rdb_sst_info &p) = delete;
@@ -130,15 +167,47 @@ class Rdb_sst_info {
   mysql_mutex_t m_commit_mutex;
   Rdb_sst_file_ordered *m_sst_file;
 
-  // List of committed SST files - we'll ingest them later in one single batch
+  // List of committed SST files - we'll ingest them later in one single batch.
+  // The writer threads add their files concurrently, so it is protected by
+  // m_committed_files_mutex
   std::vector<std::string> m_committed_files;
+  std::mutex m_committed_files_mutex;
 
   const bool m_tracing;
   bool m_print_client_error;
 
+  /*
+    With m_num_writers > 0, keys are buffered into m_batch instead of being
+    written by the session thread, and each full batch is turned into its
+    own SST file by one of the background writer threads. At most
+    m_num_writers batches are queued or being written at any time.
+  */
+  const uint m_num_writers;
+  std::unique_ptr<Rdb_sst_batch> m_batch;
+  std::vector<std::unique_ptr<Rdb_sst_writer_thread>> m_writer_threads;
+  std::queue<std::unique_ptr<Rdb_sst_batch>> m_batch_queue;
+  uint m_batches_in_flight;
+  bool m_stop_writers;
+  std::mutex m_batch_mutex;
+  std::condition_variable m_batch_cond;
+  std::condition_variable m_batch_done_cond;
+
+  // First failure in a writer thread. Writers have no THD, so the error is
+  // reported to the client from the session thread instead
+  rocksdb::Status m_writer_status;
+  std::string m_writer_status_file;
+
   int open_new_sst_file();
   void close_curr_sst_file();
   void commit_sst_file(Rdb_sst_file_ordered *sst_file);
+  void add_committed_file(const std::string &name);
+
+  int put_batched(const rocksdb::Slice &key, const rocksdb::Slice &value);
+  int submit_batch();
+  void start_writers();
+  void stop_writers();
+  rocksdb::Status write_batch(const Rdb_sst_batch &batch);
+  int get_writer_error();
 
   void set_error_msg(const std::string &sst_file_name,
                      const rocksdb::Status &s);
@@ -147,9 +216,13 @@ class Rdb_sst_info {
   Rdb_sst_info(rocksdb::DB *const db, const std::string &tablename,
                const std::string &indexname,
                rocksdb::ColumnFamilyHandle *const cf,
-               const rocksdb::DBOptions &db_options, const bool tracing);
+               const rocksdb::DBOptions &db_options, const bool tracing,
+               const uint num_writers = 0);
   ~Rdb_sst_info();
 
+  // Run by the background writer threads
+  void run_writer();
+
   /*
     This is the unit of work returned from Rdb_sst_info::finish and represents
     a group of SST to be ingested atomically with other Rdb_sst_commit_info.
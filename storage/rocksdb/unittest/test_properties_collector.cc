@@ -30,6 +30,37 @@ void putKeys(myrocks::Rdb_tbl_prop_coll *coll, int num, bool is_delete,
   DBUG_ASSERT(coll->GetMaxDeletedRows() == expected_deleted);
 }
 
+void checkSketch() {
+  myrocks::Rdb_index_sketch sketch(2);
+
+  for (int i = 0; i < 10000; i++) {
+    const std::string key = std::to_string(i);
+    const uint64_t hash = myrocks::Rdb_index_sketch::hash_bytes(
+        0, key.data(), key.size());
+    sketch.add_prefix(0, hash % 10);
+    sketch.add_prefix(1, hash);
+    sketch.add_rows(1);
+  }
+
+  // Estimates should be within a few standard errors (6.5%) of the truth
+  DBUG_ASSERT(sketch.get_distinct_keys(0) >= 9);
+  DBUG_ASSERT(sketch.get_distinct_keys(0) <= 11);
+  DBUG_ASSERT(sketch.get_distinct_keys(1) > 8000);
+  DBUG_ASSERT(sketch.get_distinct_keys(1) < 12000);
+  DBUG_ASSERT(sketch.get_rec_per_key(0) >= 900);
+  DBUG_ASSERT(sketch.get_rec_per_key(0) <= 1200);
+  DBUG_ASSERT(sketch.test_and_clear_dirty());
+  DBUG_ASSERT(!sketch.test_and_clear_dirty());
+
+  myrocks::Rdb_index_sketch copy(2);
+  DBUG_ASSERT(copy.unmaterialize(sketch.materialize()) == 0);
+  DBUG_ASSERT(copy.get_rows() == 10000);
+  DBUG_ASSERT(copy.get_distinct_keys(1) == sketch.get_distinct_keys(1));
+
+  myrocks::Rdb_index_sketch other_parts(3);
+  DBUG_ASSERT(other_parts.unmaterialize(sketch.materialize()) != 0);
+}
+
 int main(int argc, char **argv) {
   // test the circular buffer for delete flags
   myrocks::Rdb_compact_params params;
@@ -50,5 +81,7 @@ int main(int argc, char **argv) {
   putKeys(&coll, 100, true, 10); // ....[xxxxxxxxxx]
   putKeys(&coll, 100, true, 10); // ....[oooooooooo]
 
+  checkSketch();
+
   return 0;
 }